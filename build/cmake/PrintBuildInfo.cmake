@@ -19,6 +19,9 @@ endif()
 if(MCRL2_ENABLE_DEVELOPER)
   set(BUILD_TYPE "${BUILD_TYPE}, developer")
 endif()
+if(MCRL2_ENABLE_COMPACT_TRANSITIONS)
+  set(BUILD_TYPE "${BUILD_TYPE}, compact transitions")
+endif()
 message(STATUS "**")
 message(STATUS "** Building mCRL2 ${MCRL2_VERSION} ${BUILD_TYPE})")
 message(STATUS "** ")
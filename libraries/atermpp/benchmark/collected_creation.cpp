@@ -0,0 +1,45 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "benchmark_shared.h"
+
+using namespace atermpp;
+
+// Measures the term creation throughput when garbage collection is enabled, i.e., when every thread
+// must account for its created terms in the counters that determine when to collect garbage. The
+// benchmark is intended to be run with an increasing number of threads.
+int main(int argc, char* argv[])
+{
+  std::size_t number_of_threads = 1;
+
+  // Accept one argument for the number of threads.
+  if (argc > 1)
+  {
+    number_of_threads = static_cast<std::size_t>(std::stoi(argv[1]));
+  }
+
+  std::size_t size = 400000;
+  std::size_t iterations = 20;
+
+  // Define a function that repeatedly creates nested function applications that become garbage.
+  auto nested_function = [&](int id) -> void
+    {
+      aterm_appl f;
+      for (std::size_t i = 0; i < iterations / number_of_threads; ++i)
+      {
+        f = create_nested_function<2>("f", std::to_string(id) + "_" + std::to_string(i), size);
+      }
+    };
+
+  stopwatch timer;
+  benchmark_threads(number_of_threads, nested_function);
+  std::cerr << "terms per second: " << static_cast<double>((iterations / number_of_threads) * number_of_threads * size) / timer.seconds() << std::endl;
+
+  return 0;
+}
@@ -27,6 +27,10 @@ constexpr static bool GlobalThreadSafe = false;
 /// \brief Enable garbage collection.
 constexpr static bool EnableGarbageCollection = true;
 
+/// \brief The maximal number of terms a thread creates before it updates the global counters
+///        that determine when garbage collection and resizing take place.
+constexpr static long MaximumCreationBudget = 1024;
+
 /// \brief Enable the block allocator for terms.
 constexpr static bool EnableBlockAllocator = false;
 
@@ -49,7 +49,12 @@ public:
     // as otherwise an override would be called. 
   }
 
-  virtual inline std::size_t size() const = 0;
+  /// \brief The number of terms in the container. Just like mark, this can be called by garbage collection
+  ///        while the container is being constructed or destroyed, in which case the base version is called.
+  virtual inline std::size_t size() const
+  {
+    return 0;
+  }
 
   /// \brief Copy constructor
   inline _aterm_container(const _aterm_container& c);
@@ -388,23 +393,9 @@ public:
 
   void mark(std::stack<std::reference_wrapper<detail::_aterm>>& todo) const
   {
-    if constexpr (is_reference_aterm<typename T::first_type>::value)
-    {
-      super::first.mark(todo);
-    }
-    else 
-    {
-      reference_aterm<typename T::first_type>(super::first).mark(todo);
-    }
-
-    if constexpr (is_reference_aterm<typename T::second_type>::value)
-    {
-      super::second.mark(todo);
-    }
-    else 
-    {
-      reference_aterm<typename T::second_type>(super::second).mark(todo);
-    }
+    // Both elements are reference aterms, which are marked without making copies that would create terms.
+    super::first.mark(todo);
+    super::second.mark(todo);
   }
 }; 
 
@@ -10,6 +10,10 @@
 #ifndef ATERMPP_DETAIL_ATERM_POOL_H
 #define ATERMPP_DETAIL_ATERM_POOL_H
 
+#include <chrono>
+#include <functional>
+#include <stack>
+
 #include "mcrl2/atermpp/detail/aterm_pool_storage.h"
 #include "mcrl2/atermpp/detail/function_symbol_pool.h"
 
@@ -39,6 +43,12 @@ public:
   /// \brief Mark the terms created by this thread to prevent them being garbage collected.
   virtual void mark() = 0;
 
+  /// \brief Mark the terms in the given part of the root set of this thread, where the root set is
+  ///        divided into number_of_parts parts of roughly equal size.
+  /// \details Is called by several threads at the same time during garbage collection, which must use
+  ///          their own todo stack.
+  virtual void mark(std::size_t part, std::size_t number_of_parts, std::stack<std::reference_wrapper<_aterm>>& todo) = 0;
+
   /// \brief Print performance statistics for data stored for this thread.
   virtual void print_local_performance_statistics() const = 0;
 
@@ -121,21 +131,42 @@ public:
   /// \brief Enable garbage collection when passing true and disable otherwise.
   inline void enable_garbage_collection(bool enable) { m_enable_garbage_collection = enable; };
 
+  /// \brief Sets the number of threads that mark and sweep terms during garbage collection. With a
+  ///        single thread, which is the default, the thread that collects garbage does all the work.
+  /// \details Containers that are marked by additional threads must not create terms in their mark function.
+  ///          Storages with deletion hooks are always swept by the thread that collects garbage.
+  inline void set_garbage_collection_threads(std::size_t number_of_threads) { m_garbage_collection_threads = std::max<std::size_t>(1, number_of_threads); }
+
   inline function_symbol_pool& get_symbol_pool() { return m_function_symbol_pool; }
 
   // These functions of the aterm pool should be called through a thread_aterm_pool.
 private:
 
-  /// \brief Triggers garbage collection and resizing when conditions are met.
+  /// \brief Subtracts the terms created by a thread from the global counters, and triggers garbage
+  ///        collection and resizing when conditions are met.
   /// \param allow_collect Actually perform the garbage collection instead of only updating the counters.
   /// \param thread The pool that called this function.
+  /// \param number_of_created_terms The number of terms created by the thread since its previous call.
+  /// \returns The number of terms the thread can create before it must call this function again.
   /// \threadsafe
-  inline void created_term(bool allow_collect, thread_aterm_pool_interface* thread);
+  inline std::size_t created_terms(bool allow_collect, thread_aterm_pool_interface* thread, std::size_t number_of_created_terms);
 
   /// \brief Collect garbage on all storages.
   /// \threadsafe
   inline void collect_impl(thread_aterm_pool_interface* thread);
 
+  /// \brief Marks all terms that are reachable from the root sets, using the configured number of
+  ///        garbage collection threads.
+  inline void mark();
+
+  /// \brief Destroys all terms that are not marked, where storages are swept in parallel when
+  ///        multiple garbage collection threads are configured.
+  inline void sweep();
+
+  /// \brief Performs the given tasks, in the given order, using the configured number of garbage
+  ///        collection threads. The thread that collects garbage also performs tasks.
+  inline void run_tasks(const std::vector<std::function<void()>>& tasks);
+
   /// \brief Creates a integral term with the given value.
   inline bool create_int(aterm& term, std::size_t val);
 
@@ -208,12 +239,20 @@ private:
   /// Storage for term_appl with a dynamic number of arguments larger than 7.
   arbitrary_function_application_storage m_appl_dynamic_storage;
 
-  /// Track the number of terms destroyed and reduce the freelist.
+  /// Track the number of terms destroyed and reduce the freelist. Threads only update these counters
+  /// once per creation budget, see thread_aterm_pool::created_term.
   std::atomic<long> m_count_until_collection = 0;
   std::atomic<long> m_count_until_resize = 0;
 
   std::atomic<bool> m_enable_garbage_collection = EnableGarbageCollection; /// Garbage collection is enabled.
 
+  std::atomic<std::size_t> m_garbage_collection_threads = 1; /// The number of threads that mark and sweep terms.
+
+  /// The number of garbage collections, and the total and maximum time that other threads were halted by them.
+  std::size_t m_number_of_collections = 0;
+  std::chrono::milliseconds m_total_pause{0};
+  std::chrono::milliseconds m_maximum_pause{0};
+
   /// Represents an empty list.
   aterm m_empty_list;
 };
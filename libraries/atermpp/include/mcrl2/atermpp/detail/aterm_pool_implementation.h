@@ -12,6 +12,7 @@
 #pragma once
 
 #include <chrono>
+#include <thread>
 #include "aterm_pool.h"
 #include "aterm_pool_storage_implementation.h"   // For store_in_argument_array. 
 
@@ -141,6 +142,13 @@ void aterm_pool::print_performance_statistics() const
     mCRL2log(mcrl2::log::info, "Performance") << "aterm_pool: all reference counts changed " << _aterm::reference_count_changes() << " times.\n";
   }
 #endif
+  if (m_number_of_collections > 0)
+  {
+    mCRL2log(mcrl2::log::debug, "Performance") << "g_term_pool(): " << m_number_of_collections << " garbage collections halted all threads for "
+      << m_total_pause.count() << " ms in total and at most " << m_maximum_pause.count() << " ms at once (using "
+      << m_garbage_collection_threads << " garbage collection threads).\n";
+  }
+
   // Print information for the local aterm pools.
   for (const thread_aterm_pool_interface* local : m_thread_pools)
   {
@@ -180,38 +188,40 @@ std::size_t aterm_pool::size() const
 
 // private
 
-void aterm_pool::created_term(bool allow_collect, thread_aterm_pool_interface* thread)
+std::size_t aterm_pool::created_terms(bool allow_collect, thread_aterm_pool_interface* thread, std::size_t number_of_created_terms)
 {
+  const long created = static_cast<long>(number_of_created_terms);
+
   // Defer garbage collection when it happens too often.
-  if (m_count_until_collection.load(std::memory_order_relaxed) <= 0)
-  {
-    if (allow_collect)
-    {
-      collect_impl(thread);
-    }
-  }
-  else
+  long count_until_collection = m_count_until_collection.fetch_sub(created, std::memory_order_relaxed) - created;
+  if (count_until_collection <= 0 && allow_collect)
   {
-    m_count_until_collection.fetch_sub(1, std::memory_order_relaxed);
+    collect_impl(thread);
+    count_until_collection = m_count_until_collection.load(std::memory_order_relaxed);
   }
 
-  if (m_count_until_resize.load(std::memory_order_relaxed) <= 0)
+  long count_until_resize = m_count_until_resize.fetch_sub(created, std::memory_order_relaxed) - created;
+  if (count_until_resize <= 0 && allow_collect)
   {
-    if (allow_collect)
-    {
-      resize_if_needed(thread);
-    }
+    resize_if_needed(thread);
+    count_until_resize = m_count_until_resize.load(std::memory_order_relaxed);
   }
-  else
+
+  // The next budget is a fraction of the remaining count, such that the threads together
+  // do not overshoot the moment of collection or resizing by much.
+  const long remaining = std::min(count_until_collection, count_until_resize);
+  if (remaining <= 1)
   {
-    m_count_until_resize.fetch_sub(1, std::memory_order_relaxed);
+    return 1;
   }
+  return static_cast<std::size_t>(std::min(remaining / 2, MaximumCreationBudget));
 }
 
 void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
 {
   if (!m_enable_garbage_collection) { return; }
 
+  const auto pause_start = std::chrono::steady_clock::now();
   lock(thread);
   if (m_count_until_collection > 0)
   {
@@ -222,26 +232,8 @@ void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
   auto timestamp = std::chrono::system_clock::now();
   std::size_t old_size = size();
 
-#ifdef MCRL2_ATERMPP_REFERENCE_COUNTED
-  // Marks all terms that are reachable via any reachable term to
-  // not be garbage collected.
-  m_int_storage.mark();
-  std::get<0>(m_appl_storage).mark();
-  std::get<1>(m_appl_storage).mark();
-  std::get<2>(m_appl_storage).mark();
-  std::get<3>(m_appl_storage).mark();
-  std::get<4>(m_appl_storage).mark();
-  std::get<5>(m_appl_storage).mark();
-  std::get<6>(m_appl_storage).mark();
-  std::get<7>(m_appl_storage).mark();
-  m_appl_dynamic_storage.mark();
-#endif // MCRL2_ATERMPP_REFERENCE_COUNTED
-
-  // Mark the terms referenced by all thread pools.
-  for (const auto& pool : m_thread_pools)
-  {
-    pool->mark();
-  }
+  // Mark all terms that are reachable from the root sets.
+  mark();
 
   assert(std::get<0>(m_appl_storage).verify_mark());
   assert(std::get<1>(m_appl_storage).verify_mark());
@@ -257,16 +249,7 @@ void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
   auto mark_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
   timestamp = std::chrono::system_clock::now();
   // Collect all terms that are not marked.
-  m_appl_dynamic_storage.sweep();
-  std::get<7>(m_appl_storage).sweep();
-  std::get<6>(m_appl_storage).sweep();
-  std::get<5>(m_appl_storage).sweep();
-  std::get<4>(m_appl_storage).sweep();
-  std::get<3>(m_appl_storage).sweep();
-  std::get<2>(m_appl_storage).sweep();
-  std::get<1>(m_appl_storage).sweep();
-  std::get<0>(m_appl_storage).sweep();
-  m_int_storage.sweep();
+  sweep();
 
   // Check that after sweeping the terms are consistent.
   assert(m_int_storage.verify_sweep());
@@ -294,6 +277,12 @@ void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
   // Garbage collect function symbols.
   m_function_symbol_pool.sweep();
 
+  // Keep track of the time that the other threads were halted.
+  const auto pause = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - pause_start);
+  ++m_number_of_collections;
+  m_total_pause += pause;
+  m_maximum_pause = std::max(m_maximum_pause, pause);
+
   print_performance_statistics();
 
   // Use some heuristics to determine when the next collect should be called automatically.
@@ -302,6 +291,133 @@ void aterm_pool::collect_impl(thread_aterm_pool_interface* thread)
   unlock();
 }
 
+void aterm_pool::mark()
+{
+  std::vector<std::function<void()>> tasks;
+
+#ifdef MCRL2_ATERMPP_REFERENCE_COUNTED
+  // Marks all terms that are reachable via any reachable term to
+  // not be garbage collected.
+  tasks.emplace_back([this]() { m_int_storage.mark(); });
+  tasks.emplace_back([this]() { std::get<0>(m_appl_storage).mark(); });
+  tasks.emplace_back([this]() { std::get<1>(m_appl_storage).mark(); });
+  tasks.emplace_back([this]() { std::get<2>(m_appl_storage).mark(); });
+  tasks.emplace_back([this]() { std::get<3>(m_appl_storage).mark(); });
+  tasks.emplace_back([this]() { std::get<4>(m_appl_storage).mark(); });
+  tasks.emplace_back([this]() { std::get<5>(m_appl_storage).mark(); });
+  tasks.emplace_back([this]() { std::get<6>(m_appl_storage).mark(); });
+  tasks.emplace_back([this]() { std::get<7>(m_appl_storage).mark(); });
+  tasks.emplace_back([this]() { m_appl_dynamic_storage.mark(); });
+#endif // MCRL2_ATERMPP_REFERENCE_COUNTED
+
+  // Mark the terms referenced by all thread pools.
+  const std::size_t number_of_threads = m_garbage_collection_threads.load(std::memory_order_relaxed);
+  if (number_of_threads == 1)
+  {
+    tasks.emplace_back([this]()
+      {
+        for (const auto& pool : m_thread_pools)
+        {
+          pool->mark();
+        }
+      });
+  }
+  else
+  {
+    // Every thread marks its part of the root set of every thread pool. Terms that are reachable from
+    // several parts can be visited by multiple threads, which only set the same mark bit of the term.
+    for (std::size_t part = 0; part < number_of_threads; ++part)
+    {
+      tasks.emplace_back([this, part, number_of_threads]()
+        {
+          std::stack<std::reference_wrapper<_aterm>> todo;
+          for (const auto& pool : m_thread_pools)
+          {
+            pool->mark(part, number_of_threads, todo);
+          }
+        });
+    }
+  }
+
+  run_tasks(tasks);
+}
+
+void aterm_pool::sweep()
+{
+  // Deletion hooks can create terms and inspect the arguments of the destroyed term. Therefore, storages
+  // with deletion hooks are swept by this thread first, in the order in which terms with more arguments
+  // are destroyed first. The remaining storages are independent hash tables that are swept in parallel.
+  const bool parallel = GlobalThreadSafe && m_garbage_collection_threads.load(std::memory_order_relaxed) > 1;
+  std::vector<std::pair<std::size_t, std::function<void()>>> tasks;
+
+  auto sweep_storage = [&](auto& storage)
+    {
+      if (parallel && !storage.has_deletion_hooks())
+      {
+        tasks.emplace_back(storage.size(), [&storage]() { storage.sweep(); });
+      }
+      else
+      {
+        storage.sweep();
+      }
+    };
+
+  sweep_storage(m_appl_dynamic_storage);
+  sweep_storage(std::get<7>(m_appl_storage));
+  sweep_storage(std::get<6>(m_appl_storage));
+  sweep_storage(std::get<5>(m_appl_storage));
+  sweep_storage(std::get<4>(m_appl_storage));
+  sweep_storage(std::get<3>(m_appl_storage));
+  sweep_storage(std::get<2>(m_appl_storage));
+  sweep_storage(std::get<1>(m_appl_storage));
+  sweep_storage(std::get<0>(m_appl_storage));
+  sweep_storage(m_int_storage);
+
+  // Start with the largest storages to balance the work over the threads.
+  std::stable_sort(tasks.begin(), tasks.end(), [](const auto& left, const auto& right) { return left.first > right.first; });
+  std::vector<std::function<void()>> sweeps;
+  for (auto& [size, task] : tasks)
+  {
+    sweeps.emplace_back(std::move(task));
+  }
+  run_tasks(sweeps);
+}
+
+void aterm_pool::run_tasks(const std::vector<std::function<void()>>& tasks)
+{
+  const std::size_t number_of_threads = std::min(tasks.size(), m_garbage_collection_threads.load(std::memory_order_relaxed));
+  if (!GlobalThreadSafe || number_of_threads <= 1)
+  {
+    for (const auto& task : tasks)
+    {
+      task();
+    }
+    return;
+  }
+
+  // Every thread repeatedly takes the next task that has not been started yet.
+  std::atomic<std::size_t> next_task = 0;
+  auto perform_tasks = [&]()
+    {
+      for (std::size_t i = next_task++; i < tasks.size(); i = next_task++)
+      {
+        tasks[i]();
+      }
+    };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(perform_tasks);
+  }
+
+  perform_tasks();
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+}
+
 function_symbol aterm_pool::create_function_symbol(const std::string& name, const std::size_t arity, const bool check_for_registered_functions)
 {
   return m_function_symbol_pool.create(name, arity, check_for_registered_functions);
@@ -161,6 +161,9 @@ public:
   /// \returns The number of terms stored in this storage.
   std::size_t size() const { return m_term_set.size(); }
 
+  /// \returns True iff a deletion hook has been added to this storage.
+  bool has_deletion_hooks() const { return !m_deletion_hooks.empty(); }
+
   /// \brief A fake copy constructor to fix the issues with GCC 4 and 5.
   aterm_pool_storage(const aterm_pool_storage& other) :
     m_pool(other.m_pool),
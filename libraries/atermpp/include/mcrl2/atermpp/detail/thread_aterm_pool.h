@@ -105,6 +105,7 @@ public:
 
   // Implementation of thread_aterm_pool_interface
   inline void mark() override;
+  inline void mark(std::size_t part, std::size_t number_of_parts, std::stack<std::reference_wrapper<_aterm>>& todo) override;
   inline void print_local_performance_statistics() const override;
   inline bool is_busy() const override;
   inline void wait_for_busy() const override;
@@ -126,6 +127,10 @@ public:
   /// \brief Waits for the global term pool.
   inline void wait();
 
+  /// \brief Called after this thread has created a term. The global counters of the aterm pool are
+  ///        only updated when the creation budget of this thread has been used up.
+  inline void created_term();
+
   /// \brief Deliver the busy flag to rewriters for faster access.
   /// \details This is a performance optimisation to be deleted in due time. 
   inline std::atomic<bool>* get_busy_flag()
@@ -157,6 +162,11 @@ private:
   std::size_t m_variable_insertions = 0;
   std::size_t m_container_insertions = 0;
 
+  /// \brief The number of terms this thread can still create before updating the global counters,
+  ///        and the size of the budget that was obtained from the global pool.
+  std::size_t m_creation_budget = 1;
+  std::size_t m_reserved_creations = 1;
+
   /// \brief A boolean flag indicating whether this thread is working inside the global aterm pool.
   std::atomic<bool> m_busy_flag = false;
   std::atomic<bool> m_forbidden_flag = false;
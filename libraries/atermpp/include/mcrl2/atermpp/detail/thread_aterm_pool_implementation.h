@@ -43,7 +43,7 @@ void thread_aterm_pool::create_int(aterm& term, size_t val)
   lock_shared();
   bool added = m_pool.create_int(term, val);
   unlock_shared();
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 void thread_aterm_pool::create_term(aterm& term, const atermpp::function_symbol& sym)
@@ -51,7 +51,7 @@ void thread_aterm_pool::create_term(aterm& term, const atermpp::function_symbol&
   lock_shared();
   bool added = m_pool.create_term(term, sym);
   unlock_shared();
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 template<class ...Terms>
@@ -60,7 +60,7 @@ void thread_aterm_pool::create_appl(aterm& term, const function_symbol& sym, con
   lock_shared();
   bool added = m_pool.create_appl(term, sym, arguments...);
   unlock_shared();
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 template<class Term, class INDEX_TYPE, class ...Terms>
@@ -98,7 +98,7 @@ void thread_aterm_pool::create_appl_index(aterm& term, const function_symbol& sy
 
   unlock_shared();
 
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 template<typename InputIterator>
@@ -111,7 +111,7 @@ void thread_aterm_pool::create_appl_dynamic(aterm& term,
   bool added = m_pool.create_appl_dynamic(term, sym, begin, end);
   unlock_shared();
   
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 template<typename InputIterator, typename ATermConverter>
@@ -125,7 +125,7 @@ void thread_aterm_pool::create_appl_dynamic(aterm& term,
   bool added = m_pool.create_appl_dynamic(term, sym, convert_to_aterm, begin, end);
   unlock_shared();
 
-  if (added) { m_pool.created_term(m_lock_depth == 0, this); }
+  if (added) { created_term(); }
 }
 
 void thread_aterm_pool::register_variable(aterm* variable)
@@ -185,10 +185,26 @@ void thread_aterm_pool::deregister_container(_aterm_container* container)
 
 void thread_aterm_pool::mark()
 {
+  mark(0, 1, m_todo);
+}
+
+/// \brief Returns the range of positions in [begin, end) that forms the given part when it is divided into number_of_parts parts.
+template<typename Iterator>
+inline std::pair<Iterator, Iterator> part_of_range(Iterator begin, Iterator end, std::size_t part, std::size_t number_of_parts)
+{
+  const std::size_t size = static_cast<std::size_t>(std::distance(begin, end));
+  return std::make_pair(begin + (size * part) / number_of_parts, begin + (size * (part + 1)) / number_of_parts);
+}
+
+void thread_aterm_pool::mark(std::size_t part, std::size_t number_of_parts, std::stack<std::reference_wrapper<_aterm>>& todo)
+{
+  assert(part < number_of_parts);
 
 #ifndef MCRL2_ATERMPP_REFERENCE_COUNTED
-  for (const aterm* variable : *m_variables)
+  const auto variables = part_of_range(m_variables->begin(), m_variables->end(), part, number_of_parts);
+  for (auto it = variables.first; it != variables.second; ++it)
   {
+    const aterm* variable = *it;
     if (variable != nullptr)
     {
       // Mark all terms (and their subterms) that are reachable, i.e the root set.
@@ -196,18 +212,20 @@ void thread_aterm_pool::mark()
       if (term != nullptr && !term->is_marked())
       {
         // This variable is not a default term and that term has not been marked.
-        mark_term(*term, m_todo);
+        mark_term(*term, todo);
       }
     }
   }
 #endif // NOT MCRL2_ATERMPP_REFERENCE_COUNTED
 
-  for (const _aterm_container* container : *m_containers)
+  const auto containers = part_of_range(m_containers->begin(), m_containers->end(), part, number_of_parts);
+  for (auto it = containers.first; it != containers.second; ++it)
   {
+    const _aterm_container* container = *it;
     if (container != nullptr)
     {
       // The container marks the contained terms itself.
-      container->mark(m_todo);
+      container->mark(todo);
     }
   }
 }
@@ -319,6 +337,15 @@ void thread_aterm_pool::wait()
   m_pool.wait();
 }
 
+void thread_aterm_pool::created_term()
+{
+  if (--m_creation_budget == 0)
+  {
+    m_creation_budget = m_pool.created_terms(m_lock_depth == 0, this, m_reserved_creations);
+    m_reserved_creations = m_creation_budget;
+  }
+}
+
 void thread_aterm_pool::set_forbidden(bool value)
 {
   m_forbidden_flag.store(value);
@@ -371,8 +371,8 @@ class unordered_map : public mcrl2::utilities::unordered_map< detail::reference_
     {}
 
     /// \brief Constructor.
-    explicit unordered_map(size_type n, const allocator_type& alloc = allocator_type())
-      : super::unordered_map(n, alloc),
+    explicit unordered_map(size_type n, const allocator_type& /* alloc */ = allocator_type())
+      : super::unordered_map(n),
       container_wrapper(*this, true)
     {}
 
@@ -11,6 +11,7 @@
 #include <boost/test/included/unit_test.hpp>
 
 #include "mcrl2/utilities/configuration.h"
+#include "mcrl2/atermpp/aterm_appl.h"
 #include "mcrl2/atermpp/aterm_int.h"
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/atermpp/detail/global_aterm_pool.h"
@@ -56,3 +57,45 @@ BOOST_AUTO_TEST_CASE(parallel_vector)
 #endif
 }
 
+
+static std::size_t deleted_count = 0;
+
+static void on_delete_marked_term(const aterm&)
+{
+  ++deleted_count;
+}
+
+BOOST_AUTO_TEST_CASE(parallel_garbage_collection)
+{
+  function_symbol g("parallel_marking_g", 1);
+  add_deletion_hook(g, on_delete_marked_term);
+
+  // Use several threads to mark the terms that are referenced by containers and variables, and to sweep the storages.
+  atermpp::detail::g_term_pool().set_garbage_collection_threads(4);
+
+  atermpp::vector<aterm_appl> vector;
+  std::vector<aterm_appl> variables;
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    vector.push_back(aterm_appl(g, aterm_int(i)));
+    variables.emplace_back(g, aterm_int(i + 1000));
+
+    // These terms become garbage immediately, and are stored in storages with and without deletion hooks.
+    aterm_appl(g, aterm_int(i + 2000));
+    aterm_appl(function_symbol("parallel_marking_h", 2), aterm_int(i), aterm_int(i + 3000));
+  }
+
+  const std::size_t old_size = atermpp::detail::g_term_pool().size();
+  atermpp::detail::g_term_pool().collect();
+  BOOST_CHECK_EQUAL(deleted_count, 1000);
+  BOOST_CHECK(atermpp::detail::g_term_pool().size() < old_size);
+
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    const aterm_appl& element = vector[i];
+    BOOST_CHECK_EQUAL(down_cast<aterm_int>(element[0]).value(), i);
+    BOOST_CHECK_EQUAL(down_cast<aterm_int>(variables[i][0]).value(), i + 1000);
+  }
+
+  atermpp::detail::g_term_pool().set_garbage_collection_threads(1);
+}
@@ -42,7 +42,8 @@ typedef std::vector < sort_expression_list> sort_list_vector;
 class normal_form_cache
 {
   private:
-    std::set<data_expression> m_lookup;
+    std::map<data_expression, std::size_t> m_lookup;
+    std::vector<const data_expression*> m_terms;
   public:
     normal_form_cache()
     { 
@@ -65,11 +66,37 @@ class normal_form_cache
   std::string insert(const data_expression& t)
   {
     std::stringstream ss;
-    const data_expression* cached_term = &*(m_lookup.insert(t).first);
-    ss << "*reinterpret_cast<const data_expression*>(" << (void*)(cached_term) << ")";
+    ss << "*reinterpret_cast<const data_expression*>(" << (void*)(m_terms[position(t)]) << ")";
     return ss.str();
   }
 
+  /// \brief position stores the normal form of t in the cache, and returns its
+  ///        position in the cache. Unlike the address used by insert, the position
+  ///        does not depend on the addresses of terms in the current process.
+  /// \param t The term to normalize.
+  /// \return The position of t in the cache.
+  std::size_t position(const data_expression& t)
+  {
+    auto [i, inserted] = m_lookup.insert(std::make_pair(t, m_terms.size()));
+    if (inserted)
+    {
+      m_terms.push_back(&i->first);
+    }
+    return i->second;
+  }
+
+  /// \brief Returns the normal form at position i in the cache.
+  const data_expression& at(std::size_t i) const
+  {
+    return *m_terms[i];
+  }
+
+  /// \brief Returns the number of normal forms in the cache.
+  std::size_t size() const
+  {
+    return m_terms.size();
+  }
+
   /// \brief Checks whether the cache is empty.
   /// \return A boolean indicating whether the cache is empty. 
   bool empty() const
@@ -142,6 +169,17 @@ class RewriterCompilingJitty: public Rewriter
     // The following vector is to store normal forms of constants, indexed by the sequence number in a constant. 
     std::vector<data_expression> normal_forms_for_constants;
 
+    // If the compile cache is used, the generated code refers to function symbols and to cached normal
+    // forms by their position in the vector below and in m_nf_cache, instead of by their addresses.
+    // These are looked up when the compiled rewriter is loaded. As a result the generated code only
+    // depends on the data specification, which allows a compiled rewriter to be reused. Without the
+    // compile cache the addresses are put in the generated code, which avoids an indirection.
+    std::vector<function_symbol> function_symbols_in_generated_code;
+    const data_expression& normal_form_in_generated_code(std::size_t i) const
+    {
+      return m_nf_cache->at(i);
+    }
+
     // Standard assignment operator.
     RewriterCompilingJitty& operator=(const RewriterCompilingJitty& other)=delete;
 
@@ -163,6 +201,7 @@ class RewriterCompilingJitty: public Rewriter
 
     std::shared_ptr<uncompiled_library> rewriter_so;
     std::shared_ptr<normal_form_cache> m_nf_cache;
+    std::string m_compile_cache_directory; // The value of MCRL2_COMPILECACHE, or empty if the compile cache is not used.
 
     // The rewriter maintains a copy of busy and forbidden flag,
     // to allow for faster access to them. These flags are used extensively and
@@ -14,6 +14,7 @@
 #include "mcrl2/utilities/toolset_version_const.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
 #include "mcrl2/data/detail/rewrite/jittyc.h"
+#include "mcrl2/data/detail/rewrite/machine_numbers.h"
 
 using namespace mcrl2::data::detail;
 using namespace mcrl2::data;
@@ -0,0 +1,310 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/machine_numbers.h
+/// \brief Computations on constants of sort Pos, Nat and Int with machine words,
+///        which the rewriters try before they apply the rewrite rules of these sorts.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_MACHINE_NUMBERS_H
+#define MCRL2_DATA_DETAIL_REWRITE_MACHINE_NUMBERS_H
+
+#include <cstdint>
+#include <limits>
+#include "mcrl2/data/int.h"
+#include "mcrl2/data/standard.h"
+#include "mcrl2/data/standard_utility.h"
+
+namespace mcrl2
+{
+namespace data
+{
+namespace detail
+{
+
+/// \brief The operations on numbers that can be computed with machine words.
+enum class machine_number_operation
+{
+  none, plus, minus, times, div, mod, maximum, minimum, succ, pred, negate, abs,
+  less, less_equal, greater, greater_equal, equal_to, not_equal_to
+};
+
+/// \brief The sorts of the arguments and results of the operations on machine words.
+enum class machine_number_sort
+{
+  none, pos, nat, int_, bool_
+};
+
+inline machine_number_sort get_machine_number_sort(const sort_expression& s)
+{
+  if (s == sort_pos::pos())
+  {
+    return machine_number_sort::pos;
+  }
+  if (s == sort_nat::nat())
+  {
+    return machine_number_sort::nat;
+  }
+  if (s == sort_int::int_())
+  {
+    return machine_number_sort::int_;
+  }
+  if (s == sort_bool::bool_())
+  {
+    return machine_number_sort::bool_;
+  }
+  return machine_number_sort::none;
+}
+
+/// \brief Returns the operation that an application of f computes, or none if f is not an operation on numbers
+///        of sort Pos, Nat or Int that can be computed with machine words.
+inline machine_number_operation get_machine_number_operation(const function_symbol& f)
+{
+  if (!is_function_sort(f.sort()))
+  {
+    return machine_number_operation::none;
+  }
+  const function_sort& s = atermpp::down_cast<function_sort>(f.sort());
+  for (const sort_expression& argument_sort: s.domain())
+  {
+    const machine_number_sort argument = get_machine_number_sort(argument_sort);
+    if (argument == machine_number_sort::none || argument == machine_number_sort::bool_)
+    {
+      return machine_number_operation::none;
+    }
+  }
+
+  const machine_number_sort codomain = get_machine_number_sort(s.codomain());
+  if (codomain == machine_number_sort::none)
+  {
+    return machine_number_operation::none;
+  }
+
+  const core::identifier_string& name = f.name();
+  machine_number_operation result = machine_number_operation::none;
+  if (s.domain().size() == 1)
+  {
+    if (name == sort_pos::succ_name())                { result = machine_number_operation::succ; }
+    else if (name == sort_nat::pred_name())           { result = machine_number_operation::pred; }
+    else if (name == sort_int::negate_name())         { result = machine_number_operation::negate; }
+    else if (name == sort_int::abs_name())            { result = machine_number_operation::abs; }
+  }
+  else if (s.domain().size() == 2)
+  {
+    if (name == sort_pos::plus_name())                { result = machine_number_operation::plus; }
+    else if (name == sort_int::minus_name())          { result = machine_number_operation::minus; }
+    else if (name == sort_pos::times_name())          { result = machine_number_operation::times; }
+    else if (name == sort_nat::div_name())            { result = machine_number_operation::div; }
+    else if (name == sort_nat::mod_name())            { result = machine_number_operation::mod; }
+    else if (name == sort_pos::maximum_name())        { result = machine_number_operation::maximum; }
+    else if (name == sort_pos::minimum_name())        { result = machine_number_operation::minimum; }
+    else if (is_less_function_symbol(f))              { result = machine_number_operation::less; }
+    else if (is_less_equal_function_symbol(f))        { result = machine_number_operation::less_equal; }
+    else if (is_greater_function_symbol(f))           { result = machine_number_operation::greater; }
+    else if (is_greater_equal_function_symbol(f))     { result = machine_number_operation::greater_equal; }
+    else if (is_equal_to_function_symbol(f))          { result = machine_number_operation::equal_to; }
+    else if (is_not_equal_to_function_symbol(f))      { result = machine_number_operation::not_equal_to; }
+  }
+
+  // Comparisons yield a Bool, and the other operations a number.
+  const bool is_comparison = result >= machine_number_operation::less;
+  if (result != machine_number_operation::none && is_comparison != (codomain == machine_number_sort::bool_))
+  {
+    return machine_number_operation::none;
+  }
+  return result;
+}
+
+/// \brief Converts a constant of sort Pos to a machine word.
+/// \return False if e is not a constant in normal form, or if its value does not fit in 63 bits.
+inline bool pos_to_machine_word(const data_expression& e, std::int64_t& value)
+{
+  // A constant @cDub(b, p) has the value 2p+b, so the outermost bit is the least significant one.
+  std::int64_t result = 0;
+  std::size_t bit = 0;
+  const data_expression* p = &e;
+  for (; sort_pos::is_cdub_application(*p); ++bit)
+  {
+    if (bit == std::numeric_limits<std::int64_t>::digits - 1)
+    {
+      return false;
+    }
+    const application& a = atermpp::down_cast<application>(*p);
+    if (sort_bool::is_true_function_symbol(a[0]))
+    {
+      result |= std::int64_t(1) << bit;
+    }
+    else if (!sort_bool::is_false_function_symbol(a[0]))
+    {
+      return false;
+    }
+    p = &a[1];
+  }
+  if (!sort_pos::is_c1_function_symbol(*p))
+  {
+    return false;
+  }
+  value = result | (std::int64_t(1) << bit);
+  return true;
+}
+
+/// \brief Converts a constant of sort Pos, Nat or Int to a machine word.
+/// \return False if e is not a number constant in normal form, or if its value does not fit in 63 bits.
+inline bool number_to_machine_word(const data_expression& e, std::int64_t& value)
+{
+  if (sort_nat::is_c0_function_symbol(e))
+  {
+    value = 0;
+    return true;
+  }
+  if (sort_nat::is_cnat_application(e) || sort_int::is_cint_application(e))
+  {
+    return number_to_machine_word(atermpp::down_cast<application>(e)[0], value);
+  }
+  if (sort_int::is_cneg_application(e))
+  {
+    if (!pos_to_machine_word(atermpp::down_cast<application>(e)[0], value))
+    {
+      return false;
+    }
+    value = -value;
+    return true;
+  }
+  return pos_to_machine_word(e, value);
+}
+
+/// \brief Constructs the constant of sort Pos with the given value, which must be positive.
+inline data_expression machine_word_to_pos(const std::uint64_t value)
+{
+  assert(value > 0);
+  if (value == 1)
+  {
+    return sort_pos::c1();
+  }
+  return sort_pos::cdub(sort_bool::bool_((value & 1) != 0), machine_word_to_pos(value >> 1));
+}
+
+/// \brief Computes the value of op applied to x and y, where y is ignored for unary operations.
+/// \return False if the result does not fit in a machine word.
+inline bool compute_machine_number_operation(const machine_number_operation op, const std::int64_t x, const std::int64_t y, std::int64_t& result)
+{
+  // The values have at most 63 bits, so x, y, -x and -y are all representable.
+  constexpr std::int64_t max = std::numeric_limits<std::int64_t>::max();
+  switch (op)
+  {
+    case machine_number_operation::plus:
+      if ((y > 0 && x > max - y) || (y < 0 && x < -max - y))
+      {
+        return false;
+      }
+      result = x + y;
+      return true;
+    case machine_number_operation::minus:
+      return compute_machine_number_operation(machine_number_operation::plus, x, -y, result);
+    case machine_number_operation::times:
+      if (x != 0 && (x < 0 ? -x : x) > max / (y < 0 ? -y : (y == 0 ? 1 : y)))
+      {
+        return false;
+      }
+      result = x * y;
+      return true;
+    case machine_number_operation::div:
+      // The divisor must be positive, and the quotient is rounded downwards.
+      if (y <= 0)
+      {
+        return false;
+      }
+      result = x / y - (x % y < 0 ? 1 : 0);
+      return true;
+    case machine_number_operation::mod:
+      if (y <= 0)
+      {
+        return false;
+      }
+      result = x % y + (x % y < 0 ? y : 0);
+      return true;
+    case machine_number_operation::maximum:       result = x < y ? y : x; return true;
+    case machine_number_operation::minimum:       result = x < y ? x : y; return true;
+    case machine_number_operation::succ:          return compute_machine_number_operation(machine_number_operation::plus, x, 1, result);
+    case machine_number_operation::pred:          return compute_machine_number_operation(machine_number_operation::plus, x, -1, result);
+    case machine_number_operation::negate:        result = -x; return true;
+    case machine_number_operation::abs:           result = x < 0 ? -x : x; return true;
+    case machine_number_operation::less:          result = x < y; return true;
+    case machine_number_operation::less_equal:    result = x <= y; return true;
+    case machine_number_operation::greater:       result = x > y; return true;
+    case machine_number_operation::greater_equal: result = x >= y; return true;
+    case machine_number_operation::equal_to:      result = x == y; return true;
+    case machine_number_operation::not_equal_to:  result = x != y; return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Computes op applied to the normal forms x and y, where y is ignored for unary operations, if these are
+///        number constants and the result fits in a machine word.
+/// \return True if the normal form of the application has been put in result. Otherwise result is unchanged, and the
+///         application must be rewritten with the rewrite rules of the number sorts.
+inline bool apply_machine_number_operation(data_expression& result,
+                                           const machine_number_operation op,
+                                           const machine_number_sort result_sort,
+                                           const data_expression& x,
+                                           const data_expression& y)
+{
+  const bool unary = op == machine_number_operation::succ || op == machine_number_operation::pred ||
+                     op == machine_number_operation::negate || op == machine_number_operation::abs;
+  std::int64_t x_value;
+  std::int64_t y_value = 0;
+  std::int64_t value;
+  if (!number_to_machine_word(x, x_value) ||
+      (!unary && !number_to_machine_word(y, y_value)) ||
+      !compute_machine_number_operation(op, x_value, y_value, value))
+  {
+    return false;
+  }
+
+  switch (result_sort)
+  {
+    case machine_number_sort::bool_:
+      result = sort_bool::bool_(value != 0);
+      return true;
+    case machine_number_sort::pos:
+      assert(value > 0);
+      result = machine_word_to_pos(static_cast<std::uint64_t>(value));
+      return true;
+    case machine_number_sort::nat:
+      assert(value >= 0);
+      result = value == 0 ? data_expression(sort_nat::c0()) : data_expression(sort_nat::cnat(machine_word_to_pos(static_cast<std::uint64_t>(value))));
+      return true;
+    case machine_number_sort::int_:
+      if (value < 0)
+      {
+        result = sort_int::cneg(machine_word_to_pos(static_cast<std::uint64_t>(-value)));
+      }
+      else
+      {
+        result = sort_int::cint(value == 0 ? data_expression(sort_nat::c0()) : data_expression(sort_nat::cnat(machine_word_to_pos(static_cast<std::uint64_t>(value)))));
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Unary variant of apply_machine_number_operation.
+inline bool apply_machine_number_operation(data_expression& result,
+                                           const machine_number_operation op,
+                                           const machine_number_sort result_sort,
+                                           const data_expression& x)
+{
+  return apply_machine_number_operation(result, op, result_sort, x, x);
+}
+
+} // namespace detail
+} // namespace data
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_MACHINE_NUMBERS_H
@@ -12,6 +12,7 @@
 #define MCRL2_DATA_DETAIL_REWRITE_STRATEGY_RULE_H
 
 #include "mcrl2/data/data_equation.h"
+#include "mcrl2/data/detail/rewrite/machine_numbers.h"
 
 namespace mcrl2
 {
@@ -24,13 +25,15 @@ namespace detail
 class strategy_rule 
 {
   protected:
-    // Only one of the fields rewrite_rule, rewrite_index or cpp_function will be used
-    // at any given time. As this hardly requires a lot of memory, we do not optimise
+    // Only one of the fields rewrite_rule, rewrite_index, cpp_function or machine_number_operation
+    // will be used at any given time. As this hardly requires a lot of memory, we do not optimise
     // this using for instance a union type. 
-    enum { data_equation_type, rewrite_index_type, cpp_function_type } m_strategy_element_type;
+    enum { data_equation_type, rewrite_index_type, cpp_function_type, machine_number_type } m_strategy_element_type;
     data_equation m_rewrite_rule;
     size_t m_rewrite_index;
     std::function<data_expression(const data_expression&)> m_cpp_function;
+    machine_number_operation m_machine_number_operation;
+    machine_number_sort m_machine_number_sort;
 
   public:
     strategy_rule(const std::size_t n)
@@ -48,6 +51,13 @@ class strategy_rule
         m_rewrite_rule(eq)
     {}
 
+    /// \brief A rule that computes the operation op with machine words if all arguments are number constants.
+    strategy_rule(const machine_number_operation op, const machine_number_sort result_sort)
+      : m_strategy_element_type(machine_number_type),
+        m_machine_number_operation(op),
+        m_machine_number_sort(result_sort)
+    {}
+
     bool is_rewrite_index() const
     {
       return m_strategy_element_type==rewrite_index_type;
@@ -59,6 +69,11 @@ class strategy_rule
       return m_strategy_element_type==cpp_function_type;
     }
 
+    bool is_machine_number_operation() const
+    {
+      return m_strategy_element_type==machine_number_type;
+    }
+
     bool is_equation() const
     {
       return m_strategy_element_type==data_equation_type;
@@ -82,6 +97,18 @@ class strategy_rule
       assert(is_cpp_code());
       return m_cpp_function;
     }
+
+    machine_number_operation number_operation() const
+    {
+      assert(is_machine_number_operation());
+      return m_machine_number_operation;
+    }
+
+    machine_number_sort number_sort() const
+    {
+      assert(is_machine_number_operation());
+      return m_machine_number_sort;
+    }
 };
 
 /// A strategy is a list of rules and the number of variables that occur in it.
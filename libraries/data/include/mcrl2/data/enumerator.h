@@ -434,7 +434,7 @@ class enumerator_list_element_with_substitution: public enumerator_list_element<
     {
       mark_term(*atermpp::detail::address(m_variables), todo);
       mark_term(*atermpp::detail::address(m_expressions), todo);
-      static_cast<enumerator_list_element<Expression>>(*this).mark(todo);
+      enumerator_list_element<Expression>::mark(todo);
     }
     
     /// \brief Set the variable ands and the expression explicitly
@@ -609,6 +609,23 @@ void RewriterJitty::rewrite_aux_function_symbol(
           break;
         }
       }
+      else if (rule.is_machine_number_operation())
+      {
+        // The arguments are not rewritten for this rule. Only those arguments that are number constants,
+        // either in the term itself or after rewriting by a preceding rule, are computed with. 
+        if (term.head()==op)
+        {
+          data_expression& number = m_rewrite_stack.top();
+          const data_expression& first = rewritten_defined[0]?m_rewrite_stack.element(0,arity+1):term[0];
+          const data_expression& last = rewritten_defined[arity-1]?m_rewrite_stack.element(arity-1,arity+1):term[arity-1];
+          if (apply_machine_number_operation(number, rule.number_operation(), rule.number_sort(), first, last))
+          {
+            result=number;
+            m_rewrite_stack.decrease(arity+1);
+            return;
+          }
+        }
+      }
       else if (rule.is_cpp_code())
       {
         // Here it is assumed that precompiled code only works on the exact right number of arguments and
@@ -821,6 +838,11 @@ void RewriterJitty::rewrite_aux_const_function_symbol(
       // It is not needed to rewrite the arguments. 
       break;
     }
+    else if (rule.is_machine_number_operation())
+    {
+      // Operations on numbers are not constants. 
+      break;
+    }
     else if (rule.is_cpp_code())
     {
       result=rule.rewrite_cpp_code()(op);  /* TODO Optimize */
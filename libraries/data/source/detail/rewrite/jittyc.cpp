@@ -16,12 +16,14 @@
 
 #include <unistd.h>
 #include <sys/stat.h>
+#include <filesystem>
 #include "mcrl2/utilities/basename.h"
 #include "mcrl2/utilities/stopwatch.h"
 #include "mcrl2/atermpp/algorithm.h"
 #include "mcrl2/atermpp/detail/aterm_list_implementation.h"
 #include "mcrl2/data/detail/rewrite/jittyc.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
+#include "mcrl2/data/detail/rewrite/machine_numbers.h"
 #include "mcrl2/data/replace.h"
 
 #ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
@@ -1056,9 +1058,45 @@ class RewriterCompilingJitty::ImplementTree
   std::set<std::size_t>m_delayed_application_functions; // Recalls the arities of the required functions 'delayed_application';
   std::vector<bool> m_used;
   std::vector<int> m_stack;
+  std::map<function_symbol, std::size_t> m_function_symbol_positions; // Positions in function_symbols_in_generated_code.
   padding m_padding;
   // variable_or_number_list m_nnfvars;
 
+  ///
+  /// \brief function_symbol_address returns a C++ expression for the address of f in the generated code.
+  ///        If the compile cache is used, it refers to the position of f in the function symbols of the
+  ///        rewriter, to keep the generated code independent of the addresses of terms in the current process.
+  ///
+  std::string function_symbol_address(const function_symbol& f)
+  {
+    if (m_rewriter.m_compile_cache_directory.empty())
+    {
+      std::ostringstream result;
+      result << (void*)(atermpp::detail::address(f));
+      return result.str();
+    }
+    auto [i, inserted] = m_function_symbol_positions.insert(std::make_pair(f, m_rewriter.function_symbols_in_generated_code.size()));
+    if (inserted)
+    {
+      m_rewriter.function_symbols_in_generated_code.push_back(f);
+    }
+    return "function_symbol_addresses__[" + std::to_string(i->second) + "]";
+  }
+
+  ///
+  /// \brief cached_normal_form stores t in the normal form cache of the rewriter, and returns a C++ expression
+  ///        for it in the generated code. If the compile cache is used, it refers to the position of t in the
+  ///        normal form cache instead of to its address.
+  ///
+  std::string cached_normal_form(const data_expression& t)
+  {
+    if (m_rewriter.m_compile_cache_directory.empty())
+    {
+      return m_rewriter.m_nf_cache->insert(t);
+    }
+    return "(*cached_normal_forms__[" + std::to_string(m_rewriter.m_nf_cache->position(t)) + "])";
+  }
+
   ///
   /// \brief opid_is_nf establishes whether a function symbol is always in normal form.
   ///        this is the case when there are no rewrite rules for the symbol.
@@ -1634,14 +1672,14 @@ class RewriterCompilingJitty::ImplementTree
       if (target_for_output.empty())
       { 
         RewriterCompilingJitty::substitution_type sigma;
-        s << m_rewriter.m_nf_cache->insert(m_rewriter.jitty_rewriter(t,sigma));
+        s << cached_normal_form(m_rewriter.jitty_rewriter(t,sigma));
       }
       else
       {
         RewriterCompilingJitty::substitution_type sigma;
         s << m_padding << target_for_output 
           << ".unprotected_assign<false>("
-          << m_rewriter.m_nf_cache->insert(m_rewriter.jitty_rewriter(t,sigma)) 
+          << cached_normal_form(m_rewriter.jitty_rewriter(t,sigma)) 
           << ");\n";
       }
       result_type << "data_expression";
@@ -1918,7 +1956,7 @@ class RewriterCompilingJitty::ImplementTree
              std::map<variable,std::string>& type_of_code_variables)
   {
     bool reset_current_data_parameters=false;
-    const void* func = (void*)(atermpp::detail::address(tree.function()));
+    const std::string func = function_symbol_address(tree.function());
     m_stream << m_padding;
     brackets.bracket_nesting_level++;
     if (level == 0)
@@ -2314,6 +2352,35 @@ public:
     }
     bool added_new_parameters_in_brackets=false;
     m_used=nfs_array(arity); // This vector maintains which arguments are in normal form.
+
+    // Operations on numbers are computed with machine words if all arguments are number constants. Only
+    // arguments that are already in normal form are considered; they are not rewritten for this purpose. 
+    // Otherwise, the rewrite rules in the strategy below are applied. 
+    const machine_number_operation number_operation = get_machine_number_operation(opid);
+    if (number_operation != machine_number_operation::none && arity == get_direct_arity(opid))
+    {
+      const machine_number_sort result_sort = get_machine_number_sort(down_cast<function_sort>(opid.sort()).codomain());
+      m_stream << m_padding << "if constexpr (";
+      for (std::size_t arg = 0; arg < arity; ++arg)
+      {
+        m_stream << (arg == 0 ? "" : " && ") << "std::is_convertible<DATA_EXPR" << arg << ", const data_expression&>::value";
+      }
+      m_stream << ")\n"
+               << m_padding << "{\n"
+               << m_padding << "  if (mcrl2::data::detail::apply_machine_number_operation(result, "
+               << "static_cast<mcrl2::data::detail::machine_number_operation>(" << static_cast<int>(number_operation) << "), "
+               << "static_cast<mcrl2::data::detail::machine_number_sort>(" << static_cast<int>(result_sort) << ")";
+      for (std::size_t arg = 0; arg < arity; ++arg)
+      {
+        m_stream << ", arg_not_nf" << arg;
+      }
+      m_stream << "))\n"
+               << m_padding << "  {\n"
+               << m_padding << "    return;\n"
+               << m_padding << "  }\n"
+               << m_padding << "}\n";
+    }
+
     // m_nnfvars=variable_or_number_list();
     std::map<variable,std::string> type_of_code_variables;
     while (!strat.empty())
@@ -2540,7 +2607,7 @@ public:
     {
       m_stream << m_padding << "result.unprotected_assign<false>(";
       RewriterCompilingJitty::substitution_type sigma;
-      m_stream << m_rewriter.m_nf_cache->insert(m_rewriter.jitty_rewriter(opid,sigma)) << ");\n";
+      m_stream << cached_normal_form(m_rewriter.jitty_rewriter(opid,sigma)) << ");\n";
     }
     else
     {
@@ -2783,6 +2850,148 @@ static std::string generate_cpp_filename(std::size_t unique)
   return filename.str();
 }
 
+///
+/// \brief read_file returns the contents of a file, or an empty string if it cannot be read.
+///
+static std::string read_file(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+///
+/// \brief The compile cache stores compiled rewriters in the directory given by the environment
+///        variable MCRL2_COMPILECACHE, such that they can be reused when the same code is generated
+///        again, for instance by a later run of a tool on the same specification. As the generated
+///        code does not contain addresses of terms, it only depends on the data specification and
+///        the selected equations. An entry consists of a library and a key file. The key file
+///        contains the generated code, the toolset version and the compile script with its
+///        compiler flags, and is compared in full before the library is reused. When there are
+///        more than maximum_number_of_entries entries, the least recently used ones are removed.
+///
+class compile_cache
+{
+  public:
+    /// \brief The maximum number of compiled rewriters in the cache. Each takes several megabytes.
+    static constexpr std::size_t maximum_number_of_entries = 32;
+
+  protected:
+    std::string m_key;
+    std::filesystem::path m_entry;
+
+    static std::string hash(const std::string& s)
+    {
+      // FNV-1a, which is stable across platforms and runs, unlike std::hash.
+      std::uint64_t result = 14695981039346656037ULL;
+      for (char c: s)
+      {
+        result = (result ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+      }
+      std::ostringstream out;
+      out << std::hex << result;
+      return out.str();
+    }
+
+    // Writes a file by writing a temporary file first and renaming it, such that concurrent runs
+    // never read a partial file.
+    static void write_atomically(const std::filesystem::path& filename, const std::function<void(const std::filesystem::path&)>& write)
+    {
+      std::filesystem::path temporary = filename;
+      temporary += "." + std::to_string(getpid()) + ".tmp";
+      write(temporary);
+      std::filesystem::rename(temporary, filename);
+    }
+
+  public:
+    compile_cache(const std::string& directory, const std::string& compile_script, const std::string& cpp_file)
+    {
+      const char* compiler = std::getenv("CXX");
+      m_key = mcrl2::utilities::get_toolset_version() + "\n" +
+              compile_script + "\n" + read_file(compile_script) + "\n" +
+              (compiler == nullptr ? "" : compiler) + "\n" +
+              read_file(cpp_file);
+      m_entry = std::filesystem::path(directory) / ("jittyc_" + hash(m_key));
+    }
+
+    /// \brief Returns true if a compiled library for the generated code is in the cache.
+    bool contains() const
+    {
+      std::filesystem::path library = m_entry;
+      library += ".bin";
+      std::filesystem::path key = m_entry;
+      key += ".key";
+      return std::filesystem::exists(library) && read_file(key.string()) == m_key;
+    }
+
+    /// \brief Copies the compiled library from the cache to the given file.
+    /// \details Every rewriter loads its own copy, as loading the same file twice may yield the
+    ///          same library, whose tables are initialised for a single rewriter. The modification
+    ///          time of the entry is updated, such that the least recently used entries are evicted.
+    void retrieve(const std::string& library_filename) const
+    {
+      std::filesystem::path library = m_entry;
+      library += ".bin";
+      std::filesystem::copy_file(library, library_filename, std::filesystem::copy_options::overwrite_existing);
+      std::filesystem::last_write_time(library, std::filesystem::file_time_type::clock::now());
+    }
+
+    /// \brief Stores a copy of the compiled library in the cache.
+    void store(const std::string& library_filename) const
+    {
+      std::filesystem::create_directories(m_entry.parent_path());
+      std::filesystem::path key = m_entry;
+      key += ".key";
+      write_atomically(key, [&](const std::filesystem::path& filename)
+        {
+          std::ofstream(filename, std::ios::binary) << m_key;
+        });
+      std::filesystem::path library = m_entry;
+      library += ".bin";
+      write_atomically(library, [&](const std::filesystem::path& filename)
+        {
+          std::filesystem::copy_file(library_filename, filename, std::filesystem::copy_options::overwrite_existing);
+        });
+      evict();
+    }
+
+    /// \brief Removes the least recently used entries until at most maximum_number_of_entries are left.
+    /// \details Entries that are removed by another run at the same time are skipped.
+    void evict() const
+    {
+      std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+      for (const std::filesystem::directory_entry& file: std::filesystem::directory_iterator(m_entry.parent_path()))
+      {
+        const std::filesystem::path& filename = file.path();
+        std::error_code error;
+        const std::filesystem::file_time_type time = std::filesystem::last_write_time(filename, error);
+        if (!error && filename.extension() == ".bin" && filename.stem().string().rfind("jittyc_", 0) == 0)
+        {
+          entries.emplace_back(time, filename);
+        }
+      }
+      if (entries.size() <= maximum_number_of_entries)
+      {
+        return;
+      }
+
+      std::sort(entries.begin(), entries.end());
+      for (std::size_t i = 0; i < entries.size() - maximum_number_of_entries; ++i)
+      {
+        std::filesystem::path key = entries[i].second;
+        key.replace_extension(".key");
+        std::error_code error;
+        std::filesystem::remove(key, error);
+        std::filesystem::remove(entries[i].second, error);
+        mCRL2log(verbose) << "removed the compiled rewriter " << entries[i].second.string() << " from the compile cache." << std::endl;
+      }
+    }
+
+    std::string entry() const
+    {
+      return m_entry.string();
+    }
+};
+
 ///
 /// \brief filter_function_symbols selects the function symbols from source for which filter
 ///        returns true, and copies them to dest.
@@ -2805,7 +3014,9 @@ void filter_function_symbols(const function_symbol_vector& source, function_symb
 void RewriterCompilingJitty::generate_code(const std::string& filename)
 {
   std::ofstream cpp_file(filename);
+  std::stringstream code;
   std::stringstream rewr_code;
+  function_symbols_in_generated_code.clear();
   // arity_bound is one larger than the maximal arity. 
   arity_bound = 1+std::max(calc_max_arity(m_data_specification_for_enumeration.constructors()),
                            calc_max_arity(m_data_specification_for_enumeration.mappings()));
@@ -2831,7 +3042,7 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
               "#define ARITY_BOUND__ " << arity_bound << "// These values are not used anymore.\n";
   cpp_file << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
 
-  cpp_file << "namespace {\n"
+  code << "namespace {\n"
                "// Anonymous namespace so the compiler uses internal linkage for the generated\n"
                "// rewrite code.\n"
                "\n"
@@ -2872,14 +3083,37 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   rewr_code << "};\n"
                "} // namespace\n";
 
-  code_generator.generate_delayed_application_functions(cpp_file);
+  code_generator.generate_delayed_application_functions(code);
+  code << rewr_code.str();
 
-  cpp_file << rewr_code.str();
-
-  cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
-              "{\n";
-  cpp_file << "  assert(&this_rewriter->functions_when_arguments_are_not_in_normal_form == (void *)" << &functions_when_arguments_are_not_in_normal_form << ");  // Check that this table matches the one rewriter is actually using.\n";
-  cpp_file << "  assert(&this_rewriter->functions_when_arguments_are_in_normal_form == (void *)" << &functions_when_arguments_are_in_normal_form << ");  // Check that this table matches the one rewriter is actually using.\n";
+  if (m_compile_cache_directory.empty())
+  {
+    cpp_file << code.str();
+    cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
+                "{\n";
+    cpp_file << "  assert(&this_rewriter->functions_when_arguments_are_not_in_normal_form == (void *)" << &functions_when_arguments_are_not_in_normal_form << ");  // Check that this table matches the one rewriter is actually using.\n";
+    cpp_file << "  assert(&this_rewriter->functions_when_arguments_are_in_normal_form == (void *)" << &functions_when_arguments_are_in_normal_form << ");  // Check that this table matches the one rewriter is actually using.\n";
+  }
+  else
+  {
+    // The tables below are declared before the code that uses them, which determines their size.
+    cpp_file << "// The addresses of the function symbols and the normal forms that are used in the\n"
+                "// rewrite functions. These are set when the rewriter is loaded.\n"
+                "static uintptr_t function_symbol_addresses__[" << std::max<std::size_t>(1, function_symbols_in_generated_code.size()) << "];\n"
+                "static const data_expression* cached_normal_forms__[" << std::max<std::size_t>(1, m_nf_cache->size()) << "];\n"
+                "\n";
+    cpp_file << code.str();
+    cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
+                "{\n";
+    cpp_file << "  for (std::size_t i = 0; i < " << function_symbols_in_generated_code.size() << "; ++i)\n"
+             << "  {\n"
+             << "    function_symbol_addresses__[i] = uint_address(this_rewriter->function_symbols_in_generated_code[i]);\n"
+             << "  }\n";
+    cpp_file << "  for (std::size_t i = 0; i < " << m_nf_cache->size() << "; ++i)\n"
+             << "  {\n"
+             << "    cached_normal_forms__[i] = &this_rewriter->normal_form_in_generated_code(i);\n"
+             << "  }\n";
+  }
   cpp_file << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_not_in_normal_form)\n"
            << "  {\n"
            << "    f = nullptr;\n"
@@ -2963,23 +3197,65 @@ void RewriterCompilingJitty::BuildRewriteSystem()
     jittyc_eqns[down_cast<function_symbol>(get_nested_head(it->lhs()))].push_front(*it);
   }
 
+  const char* env_compile_cache = std::getenv("MCRL2_COMPILECACHE");
+  m_compile_cache_directory = env_compile_cache == nullptr ? "" : env_compile_cache;
+
   std::string cpp_file = generate_cpp_filename(reinterpret_cast<std::size_t>(this));
   generate_code(cpp_file);
 
-  mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
-  time.reset();
-
-  try
+  std::unique_ptr<compile_cache> cache;
+  if (!m_compile_cache_directory.empty())
   {
-    rewriter_so->compile(cpp_file);
+    cache.reset(new compile_cache(m_compile_cache_directory, compile_script, cpp_file));
   }
-  catch(std::runtime_error& e)
+
+  bool cached = false;
+  if (cache && cache->contains())
   {
-    rewriter_so->leave_files();
-    throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    try
+    {
+      const std::string library = cpp_file + ".bin";
+      cache->retrieve(library);
+      rewriter_so->use_compiled(cpp_file, library);
+      cached = true;
+      mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, using the compiled rewriter " << cache->entry() << " from the compile cache, loading rewriter..." << std::endl;
+    }
+    catch (std::filesystem::filesystem_error& e)
+    {
+      mCRL2log(warning) << "Could not use the compile cache: " << e.what() << std::endl;
+    }
   }
 
-  mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+  if (!cached)
+  {
+    mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
+    time.reset();
+
+    try
+    {
+      rewriter_so->compile(cpp_file);
+    }
+    catch(std::runtime_error& e)
+    {
+      rewriter_so->leave_files();
+      throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    }
+
+    mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+
+    if (cache)
+    {
+      try
+      {
+        cache->store(rewriter_so->library_filename());
+        mCRL2log(verbose) << "stored the compiled rewriter in the compile cache as " << cache->entry() << "." << std::endl;
+      }
+      catch (std::filesystem::filesystem_error& e)
+      {
+        mCRL2log(warning) << "Could not store the compiled rewriter in the compile cache: " << e.what() << std::endl;
+      }
+    }
+  }
 
   bool (*init)(rewriter_interface*, RewriterCompilingJitty* this_rewriter);
   rewriter_interface interface = { mcrl2::utilities::get_toolset_version(), "Unknown error when loading rewriter.", this, nullptr, nullptr };
@@ -237,12 +237,40 @@ strategy RewriterJitty::create_a_cpp_function_based_strategy(const function_symb
   return strategy(0,result);
 }
 
+// Create a strategy for an operation on numbers that can be computed with machine words. This is the
+// strategy based on the rewrite rules, in which the result is computed with machine words before the
+// rules are tried and after each argument has been rewritten, provided that all arguments are number
+// constants at that point. The arguments are not rewritten for this purpose, such that these operations
+// remain as lazy as their rewrite rules; for instance 0*e does not rewrite e. 
+strategy RewriterJitty::create_a_machine_number_based_strategy(const function_symbol& f, const data_equation_list& rules1)
+{
+  const function_sort& sort = atermpp::down_cast<function_sort>(f.sort());
+  const strategy_rule number_rule(get_machine_number_operation(f), get_machine_number_sort(sort.codomain()));
+  const strategy rewriting_based_strategy = create_a_rewriting_based_strategy(f, rules1);
+
+  std::vector<strategy_rule> result;
+  result.push_back(number_rule);
+  for (const strategy_rule& rule: rewriting_based_strategy.rules())
+  {
+    result.push_back(rule);
+    if (rule.is_rewrite_index() && rule.rewrite_index() < sort.domain().size())
+    {
+      result.push_back(number_rule);
+    }
+  }
+  return strategy(rewriting_based_strategy.number_of_variables(), result);
+}
+
 // Create a strategy to rewrite terms. This can either be a strategy that is based on rewrite
 // rules or it can be a strategy based on an explicitly given c++ function for this function symbol. 
 strategy RewriterJitty::create_strategy(const function_symbol& f, const data_equation_list& rules1, const data_specification& data_spec)
 {
   if (data_spec.cpp_implemented_functions().count(f)==0)    // There is no explicit implementation.
   {
+    if (get_machine_number_operation(f) != machine_number_operation::none)
+    {
+      return create_a_machine_number_based_strategy(f, rules1);
+    }
     return create_a_rewriting_based_strategy(f, rules1);
   } 
   else 
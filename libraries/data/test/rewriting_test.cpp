@@ -16,6 +16,11 @@
 #include "mcrl2/data/parse.h"
 #include "mcrl2/data/rewriter.h"
 
+#if defined(MCRL2_TEST_JITTYC) && defined(MCRL2_JITTYC_AVAILABLE)
+#include <filesystem>
+#include <unistd.h> // For getpid.
+#endif
+
 #include <boost/test/included/unit_test.hpp>
 
 using namespace mcrl2;
@@ -247,6 +252,79 @@ BOOST_AUTO_TEST_CASE(int_rewrite_test)
   }
 }
 
+// Operations on number constants are computed with machine words when the result fits in one,
+// and with the rewrite rules otherwise. Both must give the same normal forms. The expected values
+// are converted explicitly where the sort of the result differs from that of the literal.
+BOOST_AUTO_TEST_CASE(machine_number_rewrite_test)
+{
+  std::cerr << "machine_number_rewrite_test\n";
+
+  data_specification specification;
+  specification.add_context_sort(sort_int::int_());
+
+  const std::vector<std::pair<std::string, std::string> > tests = {
+    { "123456789 + 987654321", "1111111110" },
+    { "(123456789 + 987654321) * 1000", "1111111110000" },
+    { "4611686018427387904 * 2", "9223372036854775808" },
+    { "4611686018427387904 * 8", "36893488147419103232" },
+    { "9223372036854775807 + 1", "9223372036854775808" },
+    { "-9223372036854775807 - 2", "-9223372036854775809" },
+    { "36893488147419103232 div 8", "Pos2Nat(4611686018427387904)" },
+    { "36893488147419103232 mod 7", "Pos2Nat(4)" },
+    { "-7 div 2", "-4" },
+    { "-7 mod 2", "Pos2Nat(1)" },
+    { "7 div 2", "Pos2Nat(3)" },
+    { "7 mod 2", "Pos2Nat(1)" },
+    { "1000 - 1001", "-1" },
+    { "-(-42)", "Pos2Int(42)" },
+    { "abs(-42)", "Pos2Nat(42)" },
+    { "pred(1)", "0" },
+    { "succ(-1)", "Nat2Int(0)" },
+    { "max(-3, 2)", "2" },
+    { "min(-3, 2)", "-3" },
+    { "9223372036854775807 < 9223372036854775808", "true" },
+    { "-5 <= -5", "true" },
+    { "123 > 124", "false" },
+    { "123 >= 124", "false" },
+    { "1000000 == 1000000", "true" },
+    { "1000000 != 1000000", "false" }
+  };
+
+  rewrite_strategy_vector strategies(data::detail::get_test_rewrite_strategies(false));
+  for (rewrite_strategy_vector::const_iterator strat = strategies.begin(); strat != strategies.end(); ++strat)
+  {
+    std::cerr << "  Strategy: " << *strat << std::endl;
+    data::rewriter R(specification, *strat);
+
+    for (const std::pair<std::string, std::string>& test: tests)
+    {
+      data_rewrite_test(R, parse_data_expression(test.first, specification), R(parse_data_expression(test.second, specification)));
+    }
+  }
+}
+
+// Operations on numbers are only computed with machine words if their arguments are number constants
+// already. Otherwise they are as lazy as their rewrite rules, such that 0*f(1) rewrites to 0 even though
+// f(1) has no normal form.
+BOOST_AUTO_TEST_CASE(machine_number_laziness_test)
+{
+  std::cerr << "machine_number_laziness_test\n";
+
+  data_specification specification = parse_data_specification(
+    "map f: Nat -> Nat;\n"
+    "var n: Nat;\n"
+    "eqn f(n) = f(n + 1);\n");
+
+  rewrite_strategy_vector strategies(data::detail::get_test_rewrite_strategies(false));
+  for (rewrite_strategy_vector::const_iterator strat = strategies.begin(); strat != strategies.end(); ++strat)
+  {
+    std::cerr << "  Strategy: " << *strat << std::endl;
+    data::rewriter R(specification, *strat);
+
+    data_rewrite_test(R, parse_data_expression("0 * f(1)", specification), R(parse_data_expression("0", specification)));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(real_rewrite_test)
 {
   using namespace mcrl2::data::sort_real;
@@ -1522,3 +1600,52 @@ BOOST_AUTO_TEST_CASE(Problem_with_recursive_templates_in_jittyc)   // This rewri
     data_rewrite_test(R, e, f);
   }
 }
+
+#if defined(MCRL2_TEST_JITTYC) && defined(MCRL2_JITTYC_AVAILABLE)
+
+// A compiled rewriter that is loaded from the compile cache must rewrite in the same way as the
+// compiled rewriter from which the cache entry was made. The second rewriter generates the same
+// code as the first one, so it must reuse the entry instead of adding one.
+BOOST_AUTO_TEST_CASE(compile_cache_test)
+{
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / ("mcrl2_compile_cache_test_" + std::to_string(getpid()));
+  setenv("MCRL2_COMPILECACHE", directory.c_str(), 1);
+
+  std::string s(
+  "sort D = struct d1?is_d1 | d2(n: Nat);\n"
+  "map f: List(D) -> Nat;\n"
+  "var x: D; l: List(D);\n"
+  "eqn f([]) = 0;\n"
+  "    f(x |> l) = if(is_d1(x), 1, n(x)) + 2 * f(l);\n"
+  );
+  data_specification specification(parse_data_specification(s));
+  const std::vector<std::string> inputs = {
+    "f([d1, d2(3), d2(1000), d1])",
+    "f([d2(123456789), d2(987654321)]) mod 1000",
+    "d2(f([d1])) == d2(1)",
+    "[d2(f([d1, d1])), d1]"
+  };
+
+  data::rewriter R(specification, jitty_compiling);
+  data::rewriter R_cached(specification, jitty_compiling);
+
+  std::size_t number_of_entries = 0;
+  for (const std::filesystem::directory_entry& file: std::filesystem::directory_iterator(directory))
+  {
+    number_of_entries += file.path().extension() == ".bin" ? 1 : 0;
+  }
+  BOOST_CHECK_EQUAL(number_of_entries, 1u);
+
+  data::rewriter R_jitty(specification, jitty);
+  for (const std::string& input: inputs)
+  {
+    data_expression e = parse_data_expression(input, specification);
+    data_rewrite_test(R_cached, e, R(e));
+    data_rewrite_test(R_cached, e, R_jitty(e));
+  }
+
+  unsetenv("MCRL2_COMPILECACHE");
+  std::filesystem::remove_all(directory);
+}
+
+#endif // defined(MCRL2_TEST_JITTYC) && defined(MCRL2_JITTYC_AVAILABLE)
@@ -12,10 +12,13 @@
 #ifndef MCRL2_LPS_EXPLORER_H
 #define MCRL2_LPS_EXPLORER_H
 
+#include <atomic>
+#include <mutex>
 #include <random>
 #include <thread>
 #include <type_traits>
 #include "mcrl2/utilities/detail/io.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
 #include "mcrl2/utilities/skip.h"
 #include "mcrl2/atermpp/standard_containers/deque.h"
 #include "mcrl2/atermpp/standard_containers/vector.h"
@@ -27,6 +30,7 @@
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
 #include "mcrl2/lps/explorer_options.h"
 #include "mcrl2/lps/find_representative.h"
+#include "mcrl2/lps/indexed_state_set.h"
 #include "mcrl2/lps/one_point_rule_rewrite.h"
 #include "mcrl2/lps/order_summand_variables.h"
 #include "mcrl2/lps/replace_constants_by_variables.h"
@@ -205,6 +209,83 @@ class highway_todo_set : public todo_set
     }
 };
 
+/// \brief A todo set of a single thread from which other threads can steal states.
+/// \details Each thread owns one shared todo set, protected by its own mutex. A busy thread moves part of
+///          its private work to its shared todo set when other threads are idle, and idle threads steal
+///          from the shared todo sets of all threads. So, threads never contend on one global lock.
+///          The counter number_of_outstanding_tasks contains the number of states in all shared todo sets
+///          plus the number of busy threads. Exploration has finished when it becomes zero.
+class shared_todo_set
+{
+  protected:
+    std::unique_ptr<todo_set> m_todo;
+    std::atomic<std::size_t> m_size;
+    std::mutex m_mutex;
+
+  public:
+    explicit shared_todo_set(std::unique_ptr<todo_set> todo)
+      : m_todo(std::move(todo)),
+        m_size(m_todo->size())
+    {}
+
+    /// \brief The number of states in this set.
+    /// \details This number is only indicative when other threads access this set.
+    std::size_t size() const
+    {
+      return m_size.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const
+    {
+      return size() == 0;
+    }
+
+    /// \brief Moves n states of the private todo set of the owning thread to this set.
+    void move_from(todo_set& source, std::size_t n, std::atomic<std::size_t>& number_of_outstanding_tasks)
+    {
+      state s;
+      std::lock_guard<std::mutex> guard(m_mutex);
+      const std::size_t old_size = m_todo->size();
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        source.choose_element(s);
+        m_todo->insert(s);
+      }
+      // A highway todo set can drop states, so count the states that were actually added. This happens
+      // before the mutex is released, i.e., before other threads can steal them.
+      number_of_outstanding_tasks.fetch_add(m_todo->size() - old_size);
+      m_size = m_todo->size();
+    }
+
+    /// \brief Moves states from this set to the private todo set of an idle thread.
+    /// \details The stealing thread becomes busy, which is accounted for in number_of_outstanding_tasks.
+    /// \param take_all If true all states are moved, which is used by the owner of this set. Otherwise,
+    ///        half of the states, and at least one, are moved.
+    /// \return False if there were no states to steal.
+    bool steal(todo_set& target, std::atomic<std::size_t>& number_of_outstanding_tasks, bool take_all)
+    {
+      if (empty())
+      {
+        return false;
+      }
+      state s;
+      std::lock_guard<std::mutex> guard(m_mutex);
+      const std::size_t n = take_all ? m_todo->size() : (m_todo->size() + 1) / 2;
+      if (n == 0)
+      {
+        return false;
+      }
+      number_of_outstanding_tasks.fetch_sub(n - 1);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        m_todo->choose_element(s);
+        target.insert(s);
+      }
+      m_size = m_todo->size();
+      return true;
+    }
+};
+
 template <typename Summand>
 const stochastic_distribution& summand_distribution(const Summand& /* summand */)
 {
@@ -309,6 +390,129 @@ typedef atermpp::utilities::unordered_map<atermpp::term_appl<data::data_expressi
                                           true  // Thread_safe.
                                         > summand_cache_map;
 
+/// \brief A cache with the solutions of the condition of a summand, with an optional bound on the number of entries.
+/// \details If the maximum size is zero the cache is unbounded and lookups are lock free. Otherwise the
+///          entries are evicted in the order in which they were inserted once the cache is full, using a
+///          fifo_policy. The keys in its queue are not protected, but each of them is also a key of the map.
+class summand_cache: protected utilities::fixed_size_cache<utilities::fifo_policy<summand_cache_map>>
+{
+  public:
+    typedef atermpp::term_appl<data::data_expression> key_type;
+    typedef atermpp::term_list<data::data_expression_list> solutions_type;
+
+  protected:
+    typedef utilities::fixed_size_cache<utilities::fifo_policy<summand_cache_map>> super;
+
+    mutable std::mutex m_mutex;
+
+    // The statistics are only counted on request, to avoid contention on the counters.
+    bool m_count_statistics = false;
+    mutable std::atomic<std::size_t> m_hits{0};
+    mutable std::atomic<std::size_t> m_misses{0};
+    std::size_t m_evictions = 0;
+
+    bool is_bounded() const
+    {
+      return m_maximum_size != std::numeric_limits<std::size_t>::max();
+    }
+
+  public:
+    summand_cache()
+      : super(0)
+    {}
+
+    summand_cache(const summand_cache& other)
+      : super(0)
+    {
+      std::lock_guard<std::mutex> lock(other.m_mutex);
+      super::operator=(other);
+      m_count_statistics = other.m_count_statistics;
+      m_hits = other.m_hits.load();
+      m_misses = other.m_misses.load();
+      m_evictions = other.m_evictions;
+    }
+
+    summand_cache& operator=(const summand_cache&) = delete;
+
+    /// \brief Sets the maximum number of entries of the cache; zero means unbounded.
+    void set_maximum_size(std::size_t maximum_size)
+    {
+      m_maximum_size = maximum_size == 0 ? std::numeric_limits<std::size_t>::max() : maximum_size;
+    }
+
+    /// \brief Sets whether the numbers of hits, misses and evictions are counted.
+    void set_count_statistics(bool count_statistics)
+    {
+      m_count_statistics = count_statistics;
+    }
+
+    /// \brief Looks up the solutions stored for key. They are copied into solutions, as another thread
+    ///        may evict the entry once the lock has been released.
+    /// \returns True if the key was found.
+    template <typename Key>
+    bool find(const Key& key, solutions_type& solutions) const
+    {
+      std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+      if (is_bounded())
+      {
+        lock.lock();
+      }
+      auto i = m_map.find(key);
+      const bool found = i != m_map.end();
+      if (found)
+      {
+        solutions = i->second;
+      }
+      if (m_count_statistics)
+      {
+        (found ? m_hits : m_misses).fetch_add(1, std::memory_order_relaxed);
+      }
+      return found;
+    }
+
+    /// \brief Stores the solutions for key. If the cache is full the oldest entry is evicted first.
+    void insert(const key_type& key, const solutions_type& solutions)
+    {
+      if (!is_bounded())
+      {
+        m_map.insert({key, solutions});
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_map.insert({key, solutions}).second)
+      {
+        return; // Another thread inserted the same key in the meantime.
+      }
+      m_policy.inserted(key);
+      if (m_map.size() > m_maximum_size)
+      {
+        m_map.erase(m_policy.replacement_candidate(m_map));
+        ++m_evictions;
+      }
+    }
+
+    std::size_t size() const
+    {
+      return m_map.size();
+    }
+
+    std::size_t hits() const
+    {
+      return m_hits;
+    }
+
+    std::size_t misses() const
+    {
+      return m_misses;
+    }
+
+    std::size_t evictions() const
+    {
+      return m_evictions;
+    }
+};
+
 
 struct explorer_summand
 {
@@ -323,7 +527,7 @@ struct explorer_summand
   caching cache_strategy;
   std::vector<data::variable> gamma;
   atermpp::function_symbol f_gamma;
-  mutable summand_cache_map local_cache;
+  mutable summand_cache local_cache;
 
   template <typename ActionSummand>
   explorer_summand(const ActionSummand& summand, std::size_t summand_index, const data::variable_list& process_parameters, caching cache_strategy_)
@@ -417,7 +621,7 @@ class explorer: public abortable
     static constexpr bool is_stochastic = Stochastic;
     static constexpr bool is_timed = Timed;
 
-    typedef atermpp::indexed_set<state, atermpp::detail::GlobalThreadSafe> indexed_set_for_states_type;
+    typedef indexed_state_set indexed_set_for_states_type;
 
   protected:
     using enumerator_element = data::enumerator_list_element_with_substitution<>;
@@ -441,8 +645,6 @@ class explorer: public abortable
     data::enumerator_identifier_generator m_global_id_generator;
 
     Specification m_global_lpsspec;
-    // Mutexes
-    std::mutex m_exclusive_state_access;
 
     std::vector<data::variable> m_process_parameters;
     std::size_t m_n; // m_n = m_process_parameters.size()
@@ -455,7 +657,7 @@ class explorer: public abortable
     volatile bool m_must_abort = false;
 
     // N.B. The keys are stored in term_appl instead of data_expression_list for performance reasons.
-    summand_cache_map global_cache;
+    summand_cache global_cache;
 
     indexed_set_for_states_type m_discovered;
 
@@ -721,11 +923,21 @@ class explorer: public abortable
       else
       {
         auto& cache = summand.cache_strategy == caching::global ? global_cache : summand.local_cache;
-        summand_cache_map::iterator q = cache.find(detail::cheap_cache_key(sigma, summand.gamma));
-        if (q == cache.end())
+        summand_cache::solutions_type solutions;
+        bool found;
+        if (summand.cache_strategy == caching::global)
+        {
+          // The key of the global cache contains the condition, so it cannot be looked up cheaply.
+          summand.compute_key(key, sigma);
+          found = cache.find(key, solutions);
+        }
+        else
+        {
+          found = cache.find(detail::cheap_cache_key(sigma, summand.gamma), solutions);
+        }
+        if (!found)
         {
           rewr(condition, summand.condition, sigma);
-          atermpp::term_list<data::data_expression_list> solutions;
           if (!data::is_false(condition))
           {
             enumerator.enumerate<enumerator_element>(
@@ -740,10 +952,14 @@ class explorer: public abortable
                         data::is_false
                       );
           }
-          q = cache.insert({key, solutions}).first;
+          if (summand.cache_strategy != caching::global)
+          {
+            summand.compute_key(key, sigma);
+          }
+          cache.insert(key, solutions);
         }
 
-        for (const data::data_expression_list& e: static_cast<atermpp::term_list<data::data_expression_list>&>(q->second))
+        for (const data::data_expression_list& e: solutions)
         {
           data::add_assignments(sigma, summand.variables, e);
           variables_are_assigned_to_sigma=true;
@@ -946,7 +1162,7 @@ class explorer: public abortable
         m_global_rewr(construct_rewriter(lpsspec, m_options.remove_unused_rewrite_rules)),
         m_global_enumerator(m_global_rewr, lpsspec.data(), m_global_rewr, m_global_id_generator, false),
         m_global_lpsspec(preprocess(lpsspec)),
-        m_discovered(m_options.number_of_threads)
+        m_discovered(m_options.number_of_threads, m_options.compress_states)
     {
       const data::variable_list& params = m_global_lpsspec.process().process_parameters();
       m_process_parameters = std::vector<data::variable>(params.begin(), params.end());
@@ -970,10 +1186,48 @@ class explorer: public abortable
           m_regular_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy);
         }
       }
+
+      // The statistics of the caches are only reported in verbose mode.
+      const bool count_statistics = m_options.cached && mCRL2logEnabled(log::verbose);
+      global_cache.set_maximum_size(m_options.cache_size);
+      global_cache.set_count_statistics(count_statistics);
+      for (std::vector<explorer_summand>* summands: { &m_regular_summands, &m_confluent_summands })
+      {
+        for (explorer_summand& summand: *summands)
+        {
+          summand.local_cache.set_maximum_size(m_options.cache_size);
+          summand.local_cache.set_count_statistics(count_statistics);
+        }
+      }
     }
 
     ~explorer() = default;
 
+    /// \brief Prints the number of hits, misses and evictions of the summand caches at verbose level.
+    void print_cache_statistics() const
+    {
+      if (!m_options.cached)
+      {
+        return;
+      }
+      std::size_t size = global_cache.size();
+      std::size_t hits = global_cache.hits();
+      std::size_t misses = global_cache.misses();
+      std::size_t evictions = global_cache.evictions();
+      for (const std::vector<explorer_summand>* summands: { &m_regular_summands, &m_confluent_summands })
+      {
+        for (const explorer_summand& summand: *summands)
+        {
+          size += summand.local_cache.size();
+          hits += summand.local_cache.hits();
+          misses += summand.local_cache.misses();
+          evictions += summand.local_cache.evictions();
+        }
+      }
+      mCRL2log(log::verbose) << "Enumeration caches: " << size << " entries, " << hits << " hits, "
+                             << misses << " misses and " << evictions << " evictions." << std::endl;
+    }
+
     // Returns the concatenation of s and [t]
     void make_timed_state(state& result, const state& s, const data::data_expression& t) const
     {
@@ -1009,9 +1263,9 @@ class explorer: public abortable
       typename DiscoverInitialState = utilities::skip
     >
     void generate_state_space_thread(
-      std::unique_ptr<todo_set>& todo,
+      std::vector<std::unique_ptr<shared_todo_set>>& shared_todos,
       const std::size_t thread_index,
-      std::atomic<std::size_t>& number_of_active_processes,
+      std::atomic<std::size_t>& number_of_outstanding_tasks,
       std::atomic<std::size_t>& number_of_idle_processes,
       const SummandSequence& regular_summands,
       const SummandSequence& confluent_summands,
@@ -1035,17 +1289,26 @@ class explorer: public abortable
       std::vector<state> dummy;
       std::unique_ptr<todo_set> thread_todo=make_todo_set(dummy.begin(),dummy.end()); // The new states for each process are temporarily stored in this vector for each thread. 
       atermpp::term_appl<data::data_expression> key;  
-      if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.lock();
-      while (number_of_active_processes>0 || !todo->empty())
+
+      // Threads are numbered from 1 when there is more than one thread, and the single thread has number 0.
+      const std::size_t number_of_todo_sets = shared_todos.size();
+      const std::size_t own_todo_index = (thread_index == 0 ? 0 : thread_index - 1);
+      shared_todo_set& own_todo = *shared_todos[own_todo_index];
+
+      while (!m_must_abort)
       {
         assert(thread_todo->empty());
-          
-        if (!todo->empty())
+
+        // Take work from the own shared todo set first, and otherwise steal from those of other threads.
+        bool found_work = false;
+        for (std::size_t i = 0; i < number_of_todo_sets && !found_work; ++i)
         {
-          todo->choose_element(current_state);
-          thread_todo->insert(current_state);
-          if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.unlock();
+          found_work = shared_todos[(own_todo_index + i) % number_of_todo_sets]->steal(*thread_todo, number_of_outstanding_tasks, i == 0);
+        }
 
+        if (found_work)
+        {
+          number_of_idle_processes--;
           while (!thread_todo->empty() && !m_must_abort)
           { 
             thread_todo->choose_element(current_state);
@@ -1125,52 +1388,32 @@ class explorer: public abortable
                 }
               );
             }
-            if (number_of_idle_processes>0 && thread_todo->size()>1)
+
+            // Only the owner adds states to its shared todo set, so it is refilled when it has been emptied by other threads. 
+            if (number_of_idle_processes>0 && thread_todo->size()>1 && own_todo.empty())
             {
-              if (todo->size()<m_options.number_of_threads)  // Not thread_safe, but number is not so important.
-              // if (todo->size()<=number_of_idle_processes)  // Not thread_safe, but number is not so important.
-              {
-                if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.lock();
-                // move 25% of the states of this thread to the global todo buffer.
-                for(std::size_t i=0; i<std::min(thread_todo->size()-1,1+(thread_todo->size()/4)); ++i)  
-                {
-                  thread_todo->choose_element(current_state);
-                  todo->insert(current_state);
-                }
-                if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.unlock();
-              }
+              // move 25% of the states of this thread to its shared todo buffer.
+              own_todo.move_from(*thread_todo, std::min(thread_todo->size()-1,1+(thread_todo->size()/4)), number_of_outstanding_tasks);
             }
 
             finish_state(thread_index, m_options.number_of_threads, current_state, s_index, thread_todo->size());
             thread_todo->finish_state();
           }
+
+          // This thread has run out of work, and becomes idle. 
+          number_of_idle_processes++;
+          number_of_outstanding_tasks--;
         }
-        else
-        {
-          if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.unlock();
-        }
-        // Check whether all processes are ready. If so the number_of_active_processes becomes 0. 
-        // Otherwise, this thread becomes active again, and tries to see whether the todo buffer is
-        // not empty, to take up more work. 
-        number_of_active_processes--;
-        number_of_idle_processes++;
-        if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.lock();
-        assert(thread_todo->empty());
-        if (todo->empty())
+        else if (number_of_outstanding_tasks == 0)
         {
-          if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.unlock();
-          std::this_thread::sleep_for(std::chrono::milliseconds(100));
-          if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.lock();
+          break;
         }
-        if (number_of_active_processes>0 || !todo->empty())
+        else
         {
-          number_of_active_processes++;
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
-        number_of_idle_processes--;
       } 
       mCRL2log(log::debug) << "Stop thread " << thread_index << ".\n";
-      if (atermpp::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.unlock();
-
     }  // end generate_state_space_thread.
 
 
@@ -1234,8 +1477,18 @@ class explorer: public abortable
         discover_state(initialisation_thread_index, s0, s0_index);
       }
 
-      std::atomic<std::size_t> number_of_active_processes=number_of_threads;
-      std::atomic<std::size_t> number_of_idle_processes=0;
+      // Each thread has its own shared todo set. Initially, all states are in the first one, and all threads are idle.
+      std::vector<std::unique_ptr<shared_todo_set>> shared_todos;
+      shared_todos.reserve(number_of_threads);
+      shared_todos.push_back(std::make_unique<shared_todo_set>(std::move(todo)));
+      std::vector<state> dummy;
+      for(std::size_t i=1; i<number_of_threads; ++i)
+      {
+        shared_todos.push_back(std::make_unique<shared_todo_set>(make_todo_set(dummy.begin(), dummy.end())));
+      }
+
+      std::atomic<std::size_t> number_of_outstanding_tasks=shared_todos.front()->size();
+      std::atomic<std::size_t> number_of_idle_processes=number_of_threads;
 
       if (number_of_threads>1)
       {
@@ -1249,8 +1502,8 @@ class explorer: public abortable
                                                          DiscoverState, ExamineTransition,
                                                          StartState, FinishState,
                                                          DiscoverInitialState >
-                                       (todo, 
-                                        i, number_of_active_processes, number_of_idle_processes,
+                                       (shared_todos, 
+                                        i, number_of_outstanding_tasks, number_of_idle_processes,
                                         regular_summands,confluent_summands,discovered, discover_state,
                                         examine_transition, start_state, finish_state, 
                                         m_global_rewr.clone(), m_global_sigma); } );  // It is essential that the rewriter is cloned as
@@ -1272,7 +1525,7 @@ class explorer: public abortable
                                                 DiscoverState, ExamineTransition,
                                                 StartState, FinishState,
                                                 DiscoverInitialState >
-                                  (todo,single_thread_index,number_of_active_processes, number_of_idle_processes,
+                                  (shared_todos,single_thread_index,number_of_outstanding_tasks, number_of_idle_processes,
                                    regular_summands,confluent_summands,discovered, discover_state,
                                    examine_transition, start_state, finish_state, 
                                    m_global_rewr, m_global_sigma);  
@@ -1658,6 +1911,24 @@ class explorer: public abortable
       m_recursive = false;
     }
 
+    /// \brief Returns the initial state, computed with the global rewriter.
+    /// \details Does not support stochastic specifications, and can only be used in a single threaded setting.
+    state initial_state()
+    {
+      assert(m_options.number_of_threads==1);
+      state s0;
+      compute_state(s0, m_initial_state, m_global_sigma, m_global_rewr);
+      if (!m_confluent_summands.empty())
+      {
+        s0 = find_representative(s0, m_confluent_summands, m_global_sigma, m_global_rewr, m_global_enumerator, m_global_id_generator);
+      }
+      if constexpr (Timed)
+      {
+        make_timed_state(s0, s0, real_zero());
+      }
+      return s0;
+    }
+
     /// \brief Abort the state space generation
     void abort() override
     {
@@ -31,6 +31,10 @@ struct explorer_options
   bool remove_unused_rewrite_rules = false;
   bool cached = false;
   bool global_cache = false;
+  std::size_t cache_size = 0; // the maximum number of entries per enumeration cache, 0 means unbounded
+  bool compress_states = false;
+  std::string external_directory; // if not empty, the states are stored in files in this directory
+  std::size_t external_buffer_size = 1000000; // the number of successors that is sorted in memory before it is written to disk
   bool confluence = false;
   bool detect_deadlock = false;
   bool detect_nondeterminism = false;
@@ -64,6 +68,10 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "search-strategy = " << options.search_strategy << std::endl;
   out << "cached = " << std::boolalpha << options.cached << std::endl;
   out << "global-cache = " << std::boolalpha << options.global_cache << std::endl;
+  out << "cache-size = " << options.cache_size << std::endl;
+  out << "compress-states = " << std::boolalpha << options.compress_states << std::endl;
+  out << "external = " << options.external_directory << std::endl;
+  out << "external-buffer = " << options.external_buffer_size << std::endl;
   out << "confluence = " << std::boolalpha << options.confluence << std::endl;
   out << "confluence-action = " << options.confluence << std::endl;
   out << "one-point-rule-rewrite = " << std::boolalpha << options.one_point_rule_rewrite << std::endl;
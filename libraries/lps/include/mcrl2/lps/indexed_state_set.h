@@ -0,0 +1,297 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/indexed_state_set.h
+/// \brief An indexed set of states that can optionally be stored in compressed form.
+
+#ifndef MCRL2_LPS_INDEXED_STATE_SET_H
+#define MCRL2_LPS_INDEXED_STATE_SET_H
+
+#include <deque>
+#include "mcrl2/atermpp/standard_containers/indexed_set.h"
+#include "mcrl2/lps/state.h"
+#include "mcrl2/utilities/hash_utility.h"
+
+namespace mcrl2 {
+
+namespace lps {
+
+/// \brief A set of states of a fixed length, in which every state is stored as a binary tree of integers.
+/// \details The values of each position of a state are interned in a table per position, and the leaves
+///          of the tree are the indices in these tables. Every inner node of the tree is a pair of indices
+///          of its children, which is interned in a table per node. The index of a state is the index of
+///          its root in the root table, so indices are assigned consecutively, like in an indexed set.
+///          As states that share a subvector share the corresponding subtree, the memory per state is
+///          typically a few integers, instead of a term and all its arguments.
+///          The length of the states is determined by the first state that is inserted, which must be
+///          done by one thread.
+class state_tree_table
+{
+  public:
+    typedef std::size_t size_type;
+
+    static constexpr size_type npos = std::numeric_limits<std::size_t>::max();
+
+  protected:
+    typedef std::pair<std::size_t, std::size_t> node_type;
+    typedef utilities::indexed_set<node_type, atermpp::detail::GlobalThreadSafe> node_table;
+    typedef atermpp::indexed_set<data::data_expression, atermpp::detail::GlobalThreadSafe> value_table;
+
+    // The shape of an inner node, which covers the positions [first, last) of a state. Its left child
+    // covers [first, middle) and its right child [middle, last). A child that covers at least two
+    // positions is the inner node with the given index, a child covering one position is a leaf, and
+    // a child covering no positions is represented by the index 0.
+    struct tree_shape
+    {
+      std::size_t first;
+      std::size_t middle;
+      std::size_t last;
+      std::size_t left;
+      std::size_t right;
+    };
+
+    std::size_t m_number_of_threads;
+    std::size_t m_arity = npos;
+    std::vector<tree_shape> m_shape;
+    std::deque<node_table> m_nodes;
+    std::deque<value_table> m_values;
+
+    std::size_t make_shape(std::size_t first, std::size_t last)
+    {
+      std::size_t result = m_shape.size();
+      std::size_t middle = (first + last) / 2;
+      m_shape.push_back(tree_shape{first, middle, last, npos, npos});
+      if (middle - first >= 2)
+      {
+        std::size_t left = make_shape(first, middle);
+        m_shape[result].left = left;
+      }
+      if (last - middle >= 2)
+      {
+        std::size_t right = make_shape(middle, last);
+        m_shape[result].right = right;
+      }
+      return result;
+    }
+
+    void initialise(std::size_t arity)
+    {
+      m_arity = arity;
+      make_shape(0, arity);
+      for (std::size_t i = 0; i < m_shape.size(); i++)
+      {
+        m_nodes.emplace_back(m_number_of_threads);
+      }
+      for (std::size_t i = 0; i < arity; i++)
+      {
+        m_values.emplace_back(m_number_of_threads);
+      }
+    }
+
+    // Inserts the values of a child that covers [first, last). The iterator i points to the value at position first.
+    std::size_t insert_child(std::size_t node, std::size_t first, std::size_t last, state::iterator& i, std::size_t thread_index)
+    {
+      if (last - first == 0)
+      {
+        return 0;
+      }
+      if (last - first == 1)
+      {
+        return m_values[first].insert(*i++, thread_index).first;
+      }
+      return insert_node(node, i, thread_index).first;
+    }
+
+    std::pair<std::size_t, bool> insert_node(std::size_t node, state::iterator& i, std::size_t thread_index)
+    {
+      const tree_shape& shape = m_shape[node];
+      std::size_t left = insert_child(shape.left, shape.first, shape.middle, i, thread_index);
+      std::size_t right = insert_child(shape.right, shape.middle, shape.last, i, thread_index);
+      return m_nodes[node].insert(node_type(left, right), thread_index);
+    }
+
+    std::size_t find_child(std::size_t node, std::size_t first, std::size_t last, state::iterator& i, std::size_t thread_index) const
+    {
+      if (last - first == 0)
+      {
+        return 0;
+      }
+      if (last - first == 1)
+      {
+        return m_values[first].index(*i++, thread_index);
+      }
+      return find_node(node, i, thread_index);
+    }
+
+    std::size_t find_node(std::size_t node, state::iterator& i, std::size_t thread_index) const
+    {
+      const tree_shape& shape = m_shape[node];
+      std::size_t left = find_child(shape.left, shape.first, shape.middle, i, thread_index);
+      if (left == npos)
+      {
+        return npos;
+      }
+      std::size_t right = find_child(shape.right, shape.middle, shape.last, i, thread_index);
+      if (right == npos)
+      {
+        return npos;
+      }
+      return m_nodes[node].index(node_type(left, right), thread_index);
+    }
+
+    void get_child(std::size_t node, std::size_t first, std::size_t last, std::size_t index, std::vector<const data::data_expression*>& values) const
+    {
+      if (last - first == 1)
+      {
+        values[first] = &m_values[first].at(index);
+      }
+      else if (last - first >= 2)
+      {
+        get_node(node, index, values);
+      }
+    }
+
+    void get_node(std::size_t node, std::size_t index, std::vector<const data::data_expression*>& values) const
+    {
+      const tree_shape& shape = m_shape[node];
+      const node_type& children = m_nodes[node].at(index);
+      get_child(shape.left, shape.first, shape.middle, children.first, values);
+      get_child(shape.right, shape.middle, shape.last, children.second, values);
+    }
+
+  public:
+    explicit state_tree_table(std::size_t number_of_threads = 1)
+      : m_number_of_threads(number_of_threads)
+    {}
+
+    /// \brief Returns the index of the state s, or npos if it is not in the table.
+    std::size_t index(const state& s, std::size_t thread_index = 0) const
+    {
+      if (s.size() != m_arity)
+      {
+        return npos;
+      }
+      state::iterator i = s.begin();
+      return find_node(0, i, thread_index);
+    }
+
+    /// \brief Inserts the state s and returns its index, and whether it was inserted.
+    std::pair<std::size_t, bool> insert(const state& s, std::size_t thread_index = 0)
+    {
+      if (m_arity == npos)
+      {
+        initialise(s.size());
+      }
+      if (s.size() != m_arity)
+      {
+        throw mcrl2::runtime_error("Cannot store a state with " + std::to_string(s.size()) + " parameters in a compressed state set for states with " + std::to_string(m_arity) + " parameters.");
+      }
+      state::iterator i = s.begin();
+      return insert_node(0, i, thread_index);
+    }
+
+    /// \brief Returns the state with the given index.
+    state at(std::size_t index) const
+    {
+      std::vector<const data::data_expression*> values(m_arity);
+      get_node(0, index, values);
+      state result;
+      make_state(result, values.begin(), m_arity, [](data::data_expression& result, const data::data_expression* x) { result = *x; });
+      return result;
+    }
+
+    /// \brief Returns the number of states in the table.
+    std::size_t size(std::size_t thread_index = 0) const
+    {
+      return m_nodes.empty() ? 0 : m_nodes.front().size(thread_index);
+    }
+
+    /// \brief Removes all states. The length of the states is determined again by the next insertion.
+    void clear()
+    {
+      m_arity = npos;
+      m_shape.clear();
+      m_nodes.clear();
+      m_values.clear();
+    }
+};
+
+/// \brief An indexed set of states, that are stored either as terms, or compressed in a state tree table.
+class indexed_state_set
+{
+  public:
+    typedef std::size_t size_type;
+
+  protected:
+    atermpp::indexed_set<state, atermpp::detail::GlobalThreadSafe> m_states;
+    state_tree_table m_compressed_states;
+    bool m_compressed;
+
+  public:
+    indexed_state_set()
+      : m_compressed(false)
+    {}
+
+    explicit indexed_state_set(std::size_t number_of_threads, bool compressed = false)
+      : m_states(number_of_threads),
+        m_compressed_states(number_of_threads),
+        m_compressed(compressed)
+    {}
+
+    /// \brief Returns true if the states are stored in compressed form.
+    bool compressed() const
+    {
+      return m_compressed;
+    }
+
+    /// \brief Returns the index of the state s, or a value of at least size() if it is not in the set.
+    std::size_t index(const state& s, std::size_t thread_index = 0) const
+    {
+      return m_compressed ? m_compressed_states.index(s, thread_index) : m_states.index(s, thread_index);
+    }
+
+    /// \brief Inserts the state s and returns its index, and whether it was inserted.
+    std::pair<std::size_t, bool> insert(const state& s, std::size_t thread_index = 0)
+    {
+      return m_compressed ? m_compressed_states.insert(s, thread_index) : m_states.insert(s, thread_index);
+    }
+
+    /// \brief Returns the state with the given index.
+    state at(std::size_t index) const
+    {
+      return m_compressed ? m_compressed_states.at(index) : m_states.at(index);
+    }
+
+    state operator[](std::size_t index) const
+    {
+      return at(index);
+    }
+
+    std::size_t size(std::size_t thread_index = 0) const
+    {
+      return m_compressed ? m_compressed_states.size(thread_index) : m_states.size(thread_index);
+    }
+
+    void clear(std::size_t thread_index = 0)
+    {
+      if (m_compressed)
+      {
+        m_compressed_states.clear();
+      }
+      else
+      {
+        m_states.clear(thread_index);
+      }
+    }
+};
+
+} // namespace lps
+
+} // namespace mcrl2
+
+#endif // MCRL2_LPS_INDEXED_STATE_SET_H
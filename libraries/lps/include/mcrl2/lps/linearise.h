@@ -42,6 +42,7 @@ struct t_lin_options
   bool balance_summands;      // Used to balance long expressions of the shape p1 + p2 + ... + pn. By default the parser delivers
                               // such expressions in a skewed form, causing stack overflow. 
   mcrl2::data::rewriter::strategy rewrite_strategy;
+  std::size_t number_of_threads; // The number of threads used to combine summands in parallel and communication operators.
 
   t_lin_options()
     : lin_method(lmRegular),
@@ -58,7 +59,8 @@ struct t_lin_options
       do_not_apply_constelm(false),
       apply_alphabet_axioms(false),
       balance_summands(false),              
-      rewrite_strategy(mcrl2::data::jitty)
+      rewrite_strategy(mcrl2::data::jitty),
+      number_of_threads(1)
   {}
 };
 
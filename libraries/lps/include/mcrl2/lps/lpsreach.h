@@ -14,6 +14,7 @@
 
 #ifdef MCRL2_ENABLE_SYLVAN
 
+#include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/lps/specification.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
 #include "mcrl2/lps/io.h"
@@ -31,8 +32,11 @@
 
 #include <sylvan_ldd.hpp>
 
+#include <atomic>
 #include <chrono>
+#include <exception>
 #include <iomanip>
+#include <thread>
 #include <boost/dynamic_bitset.hpp>
 
 namespace mcrl2::lps {
@@ -55,6 +59,29 @@ class lpsreach_algorithm
     std::vector<boost::dynamic_bitset<>> m_group_patterns;
     std::vector<std::size_t> m_variable_order;
     symbolic_lts m_lts;
+
+    /// \brief The rewriter and enumerator of a thread that learns transitions in parallel.
+    struct learning_context
+    {
+      data::rewriter rewr;
+      data::mutable_indexed_substitution<> sigma;
+      data::enumerator_identifier_generator id_generator;
+      data::enumerator_algorithm<> enumerator;
+
+      learning_context(const data::rewriter& rewr_, const data::data_specification& dataspec)
+        : rewr(rewr_), enumerator(rewr, dataspec, rewr, id_generator, false)
+      {}
+    };
+    std::vector<std::unique_ptr<learning_context>> m_learning_contexts;
+
+    /// \brief The transitions learned by a thread, where the values of the write parameters and the
+    ///        action of every transition are stored in atermpp containers to protect them.
+    struct learned_transitions
+    {
+      std::vector<std::pair<std::size_t, std::size_t>> sources; // pairs (cube, summand) of every transition
+      atermpp::vector<data::data_expression> values;
+      atermpp::vector<lps::multi_action> actions;
+    };
     
     /// \brief Rewrites all arguments of the given action.
     template<typename Rewriter, typename Substitution>
@@ -83,10 +110,164 @@ class lpsreach_algorithm
       mCRL2log(log::debug1) << "learn successors of summand group " << i << " for X = " << print_states(m_lts.data_index, X, R.read) << std::endl;
 
       using namespace sylvan::ldds;
+      if (!m_learning_contexts.empty())
+      {
+        learn_successors_parallel({ std::make_pair(i, X) });
+        return;
+      }
       std::pair<lpsreach_algorithm&, symbolic::summand_group&> context{*this, R};
       sat_all_nopar(X, symbolic::learn_successors_callback<std::pair<lpsreach_algorithm&, lps_summand_group&>, true>, &context);
     }
 
+    /// \brief Learns the successors of the given pairs (i, X) of a summand group index and a set of states
+    ///        with the learning threads, where every thread repeatedly takes the next cube of any of the
+    ///        sets. The transitions are added to the relations afterwards by this thread, because the data
+    ///        and action indices and the Sylvan operations are not thread safe.
+    void learn_successors_parallel(const std::vector<std::pair<std::size_t, ldd>>& todo)
+    {
+      using namespace sylvan::ldds;
+      auto& R = m_lts.summand_groups;
+
+      stopwatch learn_start;
+      std::vector<std::pair<std::size_t, std::vector<std::uint32_t>>> cubes;
+      for (const auto& [i, X]: todo)
+      {
+        std::pair<std::vector<std::pair<std::size_t, std::vector<std::uint32_t>>>&, std::size_t> context{cubes, i};
+        sat_all_nopar(X, collect_cube_callback, &context);
+      }
+
+      std::vector<learned_transitions> results(m_learning_contexts.size());
+      std::atomic<std::size_t> next_cube = 0;
+
+      auto learn = [&](learning_context& context, learned_transitions& result)
+      {
+        context.rewr.thread_initialise();
+        auto& sigma = context.sigma;
+        for (std::size_t c = next_cube++; c < cubes.size(); c = next_cube++)
+        {
+          const lps_summand_group& group = R[cubes[c].first];
+          const std::vector<std::uint32_t>& x = cubes[c].second;
+          for (std::size_t j = 0; j < group.read.size(); j++)
+          {
+            sigma[group.read_parameters[j]] = m_lts.data_index[group.read[j]][x[j]];
+          }
+
+          for (std::size_t i = 0; i < group.summands.size(); i++)
+          {
+            const auto& smd = group.summands[i];
+            data::data_expression condition = context.rewr(smd.condition, sigma);
+            if (!data::is_false(condition))
+            {
+              context.enumerator.enumerate(enumerator_element(smd.variables, condition),
+                sigma,
+                [&](const enumerator_element& p) {
+                  symbolic::check_enumerator_solution(p, group);
+                  p.add_assignments(smd.variables, sigma, context.rewr);
+                  result.sources.emplace_back(c, i);
+                  for (const data::data_expression& next_state: smd.next_state)
+                  {
+                    result.values.push_back(context.rewr(next_state, sigma));
+                  }
+                  result.actions.push_back(rewrite_action(group.actions[i], context.rewr, sigma));
+                  return false;
+                },
+                data::is_false
+              );
+            }
+            data::remove_assignments(sigma, smd.variables);
+          }
+          data::remove_assignments(sigma, group.read_parameters);
+        }
+      };
+
+      // An exception of a thread, e.g. an enumerator_error, stops all threads and is rethrown after joining them.
+      std::vector<std::exception_ptr> errors(m_learning_contexts.size());
+      auto learn_or_catch = [&](std::size_t t)
+      {
+        try
+        {
+          learn(*m_learning_contexts[t], results[t]);
+        }
+        catch (...)
+        {
+          errors[t] = std::current_exception();
+          next_cube = cubes.size();
+        }
+      };
+
+      // The data indices are only read by the threads, as new values are inserted afterwards.
+      std::vector<std::thread> threads;
+      for (std::size_t t = 1; t < m_learning_contexts.size(); t++)
+      {
+        threads.emplace_back(learn_or_catch, t);
+      }
+      learn_or_catch(0);
+      for (std::thread& thread: threads)
+      {
+        thread.join();
+      }
+      for (const std::exception_ptr& error: errors)
+      {
+        if (error)
+        {
+          std::rethrow_exception(error);
+        }
+      }
+
+      std::vector<std::uint32_t> xy;
+      for (const learned_transitions& result: results)
+      {
+        std::size_t value_index = 0;
+        for (std::size_t k = 0; k < result.sources.size(); k++)
+        {
+          const auto& [c, i] = result.sources[k];
+          lps_summand_group& group = R[cubes[c].first];
+          const auto& smd = group.summands[i];
+          const std::size_t x_size = group.read.size();
+          const std::size_t y_size = group.write.size();
+          const std::size_t xy_size = x_size + y_size + 1; // One additional space for the action label.
+          xy.resize(xy_size);
+
+          for (std::size_t j = 0; j < x_size; j++)
+          {
+            xy[group.read_pos[j]] = cubes[c].second[j];
+          }
+          for (std::size_t j = 0; j < y_size; j++)
+          {
+            const data::data_expression& value = result.values[value_index++];
+            assert(value != data::undefined_data_expression());
+
+            // Determine whether this is a copy parameter, insert special value if that is the case.
+            xy[group.write_pos[j]] = smd.copy[group.write_pos[j]] ? symbolic::relprod_ignore : m_lts.data_index[group.write[j]].insert(value).first;
+          }
+
+          // Action is always located on the last index of the cube.
+          xy[xy_size - 1] = m_lts.action_index.insert(result.actions[k]).first;
+
+          mCRL2log(log::debug1) << "  " << print_transition(m_lts.data_index, xy.data(), group.read, group.write) << std::endl;
+          group.L = m_options.no_relprod ? union_cube(group.L, xy.data(), xy_size) : union_cube_copy(group.L, xy.data(), smd.copy.data(), xy_size);
+        }
+      }
+
+      // The learning time is divided over the summand groups according to their number of cubes.
+      const double learn_time = learn_start.seconds();
+      for (auto& [i, x]: cubes)
+      {
+        if (m_options.cached)
+        {
+          R[i].Ldomain = union_cube(R[i].Ldomain, x.data(), x.size());
+        }
+        R[i].learn_calls += 1;
+        R[i].learn_time += learn_time / cubes.size();
+      }
+    }
+
+    static void collect_cube_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t n, void* context)
+    {
+      auto p = reinterpret_cast<std::pair<std::vector<std::pair<std::size_t, std::vector<std::uint32_t>>>&, std::size_t>*>(context);
+      p->first.emplace_back(p->second, std::vector<std::uint32_t>(x, x + n));
+    }
+
     template <typename Specification>
     Specification preprocess(const Specification& lpsspec)
     {
@@ -163,6 +344,15 @@ class lpsreach_algorithm
       {
         mCRL2log(log::debug) << "=== summand group " << i << " ===\n" << m_lts.summand_groups[i] << std::endl;
       }
+
+      // Every learning thread rewrites with its own copy of the rewriter.
+      if (m_options.learning_threads > 1)
+      {
+        for (std::size_t t = 0; t < m_options.learning_threads; t++)
+        {
+          m_learning_contexts.push_back(std::make_unique<learning_context>(m_rewr.clone(), lpsspec.data()));
+        }
+      }
     }
 
     /// \brief Computes relprod(U, group).
@@ -197,6 +387,19 @@ class lpsreach_algorithm
         // regular and chaining.
         todo1 = m_options.chaining ? todo : empty_set();
 
+        // Without chaining the successors for all summand groups are learned at once by the learning threads.
+        if (learn_transitions && !m_options.chaining && !m_learning_contexts.empty())
+        {
+          std::vector<std::pair<std::size_t, ldd>> X;
+          for (std::size_t i = 0; i < R.size(); i++)
+          {
+            ldd proj = project(todo, R[i].Ip);
+            X.emplace_back(i, m_options.cached ? minus(proj, R[i].Ldomain) : proj);
+          }
+          learn_successors_parallel(X);
+          learn_transitions = false;
+        }
+
         for (std::size_t i = 0; i < R.size(); i++)
         {
           if (learn_transitions)
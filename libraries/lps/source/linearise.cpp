@@ -41,6 +41,11 @@
 #include "mcrl2/process/alphabet_reduce.h"
 #include "mcrl2/process/balance_nesting_depth.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 // For Aterm library extension functions
 using namespace atermpp;
@@ -150,6 +155,96 @@ class objectdatatype
 };
 
 
+/// \brief Threads that carry out jobs for the lineariser, and that are only stopped at the end of the program.
+/// \details A term is protected by the thread that constructed it. A static term in a function, such as the
+///          sort in sort_real::real_() or the action tau(), is constructed by the thread that calls the function
+///          first, and it is no longer protected once that thread terminates. As these threads are never stopped
+///          before the end of the program, it does not matter which thread constructs a static term.
+class persistent_threads
+{
+  protected:
+    std::vector<std::thread> m_threads;
+    std::mutex m_run_mutex;        // Only one job is carried out at the same time.
+    std::mutex m_mutex;            // Protects the fields below.
+    std::condition_variable m_start;
+    std::condition_variable m_finished;
+    std::function<void(std::size_t)> m_job;
+    std::size_t m_number_of_jobs=0;  // The threads with an index smaller than this number carry out the current job.
+    std::size_t m_busy=0;
+    std::size_t m_generation=0;
+    bool m_stop=false;
+
+    void work(const std::size_t t)
+    {
+      std::size_t generation=0;
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (true)
+      {
+        m_start.wait(lock, [&]() { return m_stop || m_generation!=generation; });
+        if (m_stop)
+        {
+          return;
+        }
+        generation=m_generation;
+        if (t<m_number_of_jobs)
+        {
+          lock.unlock();
+          m_job(t);
+          lock.lock();
+          if (--m_busy==0)
+          {
+            m_finished.notify_all();
+          }
+        }
+      }
+    }
+
+  public:
+    persistent_threads()=default;
+    persistent_threads(const persistent_threads&)=delete;
+    persistent_threads& operator=(const persistent_threads&)=delete;
+
+    ~persistent_threads()
+    {
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stop=true;
+      }
+      m_start.notify_all();
+      for (std::thread& t: m_threads)
+      {
+        t.join();
+      }
+    }
+
+    /// \brief Calls job(t) for t=0,...,number_of_threads-1, each in a separate thread, and waits until all
+    ///        of them have finished. The job must not throw an exception.
+    void run(const std::size_t number_of_threads, const std::function<void(std::size_t)>& job)
+    {
+      std::lock_guard<std::mutex> run_guard(m_run_mutex);
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (m_threads.size()<number_of_threads)
+      {
+        const std::size_t t=m_threads.size();
+        m_threads.emplace_back([this, t]() { work(t); });
+      }
+      m_job=job;
+      m_number_of_jobs=number_of_threads;
+      m_busy=number_of_threads;
+      ++m_generation;
+      m_start.notify_all();
+      m_finished.wait(lock, [&]() { return m_busy==0; });
+      m_job=nullptr;
+    }
+
+    /// \brief The threads of the lineariser.
+    static persistent_threads& instance()
+    {
+      static persistent_threads threads;
+      return threads;
+    }
+};
+
 class specification_basic_type
 {
   public:
@@ -554,18 +649,104 @@ class specification_basic_type
       return n;
     }
 
+    /// \brief Yields the rewriter, which is first renewed if equations have been added to the data specification.
+    rewriter& current_rewriter()
+    {
+      if (fresh_equation_added)
+      {
+        rewr=rewriter(data,options.rewrite_strategy);
+        fresh_equation_added=false;
+      }
+      return rewr;
+    }
+
     data_expression RewriteTerm(const data_expression& t)
     {
       if (!options.norewrite)
       {
-        if (fresh_equation_added)
+        return current_rewriter()(t);
+      }
+      return t;
+    }
+
+    /// \brief Rewrites t with the given rewriter, which is typically the rewriter of a single thread.
+    data_expression RewriteTerm(const data_expression& t, rewriter& thread_rewr)
+    {
+      if (!options.norewrite)
+      {
+        return thread_rewr(t);
+      }
+      return t;
+    }
+
+    /// \brief Applies f(i, r, result) to all indices i smaller than n, in increasing order.
+    /// \details If options.number_of_threads>1 and the toolset is built thread safe, the indices are
+    ///          distributed over the persistent_threads, each of which uses its own clone r of the rewriter.
+    ///          The results for the separate indices are appended to result in increasing order of i. So,
+    ///          result does not depend on the number of threads. The function f must not change this class,
+    ///          except via r.
+    template <class Result, class Function>
+    void apply_to_indices(const std::size_t n, Function f, std::vector<Result>& result)
+    {
+      rewriter& r=current_rewriter();
+      const std::size_t number_of_threads=atermpp::detail::GlobalThreadSafe ? std::min(options.number_of_threads, n) : 1;
+      if (number_of_threads<=1)
+      {
+        for (std::size_t i=0; i<n; ++i)
         {
-          rewr=rewriter(data,options.rewrite_strategy);
-          fresh_equation_added=false;
+          f(i, r, result);
+        }
+        return;
+      }
+
+      std::vector<std::vector<Result>> results(n);
+      std::vector<std::size_t> producer(n);  // producer[i] is the thread that calculated results[i].
+      std::vector<std::exception_ptr> exceptions(number_of_threads);
+      std::atomic<std::size_t> next_index(0);
+      persistent_threads& threads=persistent_threads::instance();
+      threads.run(number_of_threads, [&](const std::size_t t)
+          {
+            try
+            {
+              rewriter thread_rewr=r.clone();  // A rewriter cannot be used by multiple threads at the same time.
+              thread_rewr.thread_initialise();
+              for (std::size_t i=next_index++; i<n; i=next_index++)
+              {
+                producer[i]=t;
+                f(i, thread_rewr, results[i]);
+              }
+            }
+            catch (...)
+            {
+              exceptions[t]=std::current_exception();
+              next_index=n;
+            }
+          });
+
+      for (const std::vector<Result>& v: results)
+      {
+        result.insert(result.end(), v.begin(), v.end());
+      }
+
+      // The terms in results[i] are registered with the thread that constructed them, so that thread also destroys them.
+      threads.run(number_of_threads, [&](const std::size_t t)
+          {
+            for (std::size_t i=0; i<n; ++i)
+            {
+              if (producer[i]==t)
+              {
+                std::vector<Result>().swap(results[i]);
+              }
+            }
+          });
+
+      for (const std::exception_ptr& e: exceptions)
+      {
+        if (e)
+        {
+          std::rethrow_exception(e);
         }
-        return rewr(t);
       }
-      return t;
     }
 
     data_expression_list RewriteTermList(const data_expression_list& t)
@@ -7742,7 +7923,7 @@ class specification_basic_type
     }
 
     // Check that the sorts of both termlists match.
-    data_expression pairwiseMatch(const data_expression_list& l1, const data_expression_list& l2)
+    data_expression pairwiseMatch(const data_expression_list& l1, const data_expression_list& l2, rewriter& thread_rewr)
     {
       if (l1.size()!=l2.size())
       {
@@ -7756,7 +7937,7 @@ class specification_basic_type
         {
           return sort_bool::false_();
         }
-        result=lazy::and_(result,RewriteTerm(equal_to(t1,*i2)));
+        result=lazy::and_(result,RewriteTerm(equal_to(t1,*i2),thread_rewr));
         ++i2;
       }
       return result;
@@ -8011,7 +8192,8 @@ class specification_basic_type
                    const action_list& n,
                    const action_list& r,
                    const bool r_is_null,
-                   comm_entry& comm_table)
+                   comm_entry& comm_table,
+                   rewriter& thread_rewr)
     {
       /* phi is a function that yields a list of pairs
          indicating how the actions in m|w|n can communicate.
@@ -8033,7 +8215,7 @@ class specification_basic_type
                                                                   is possible */
         if (c!=action_label())
         {
-          const tuple_list T=makeMultiActionConditionList_aux(w,comm_table,r,r_is_null);
+          const tuple_list T=makeMultiActionConditionList_aux(w,comm_table,r,r_is_null,thread_rewr);
           return addActionCondition(
                    (c==action_label()?action():action(c,d)),  //Check. Nil kan niet geleverd worden.
                    sort_bool::true_(),
@@ -8046,25 +8228,25 @@ class specification_basic_type
       /* if n=[a(f)] \oplus o */
       const action& firstaction=n.front();
       const action_list& o=n.tail();
-      const data_expression condition=pairwiseMatch(d,firstaction.arguments());
+      const data_expression condition=pairwiseMatch(d,firstaction.arguments(),thread_rewr);
       if (condition==sort_bool::false_())
       {
         action_list tempw=w;
         tempw=push_back(tempw,firstaction);
-        return phi(m,d,tempw,o,r,r_is_null,comm_table);
+        return phi(m,d,tempw,o,r,r_is_null,comm_table,thread_rewr);
       }
       else
       {
         action_list tempm=m;
         tempm=push_back(tempm,firstaction);
-        const tuple_list T=phi(tempm,d,w,o,r,r_is_null,comm_table);
+        const tuple_list T=phi(tempm,d,w,o,r,r_is_null,comm_table,thread_rewr);
         action_list tempw=w;
         tempw=push_back(tempw,firstaction);
         return addActionCondition(
                  action(),
                  condition,
                  T,
-                 phi(m,d,tempw,o,r,r_is_null,comm_table));
+                 phi(m,d,tempw,o,r,r_is_null,comm_table,thread_rewr));
       }
     }
 
@@ -8096,7 +8278,7 @@ class specification_basic_type
       }
     }
 
-    data_expression psi(const action_list& alpha_in, comm_entry& comm_table)
+    data_expression psi(const action_list& alpha_in, comm_entry& comm_table, rewriter& thread_rewr)
     {
       action_list alpha=reverse(alpha_in);
       data_expression cond = sort_bool::false_();
@@ -8111,7 +8293,7 @@ class specification_basic_type
           if (might_communicate(actl,comm_table,beta.tail()) && xi(actl,beta.tail(),comm_table))
           {
             // sort and remove duplicates??
-            cond = lazy::or_(cond,pairwiseMatch(a.arguments(),beta.front().arguments()));
+            cond = lazy::or_(cond,pairwiseMatch(a.arguments(),beta.front().arguments(),thread_rewr));
           }
           beta.pop_front();
         }
@@ -8126,7 +8308,8 @@ class specification_basic_type
       const action_list& multiaction,
       comm_entry& comm_table,
       const action_list& r,
-      const bool r_is_null)
+      const bool r_is_null,
+      rewriter& thread_rewr)
     {
       /* This is the function gamma(m,C,r) provided
          by Muck van Weerdenburg in Calculation of
@@ -8134,7 +8317,7 @@ class specification_basic_type
       if (multiaction.empty())
       {
         tuple_list t;
-        t.conditions.push_back((r_is_null)?static_cast<const data_expression&>(sort_bool::true_()):psi(r,comm_table));
+        t.conditions.push_back((r_is_null)?static_cast<const data_expression&>(sort_bool::true_()):psi(r,comm_table,thread_rewr));
         t.actions.push_back(action_list());
         return t;
       }
@@ -8146,21 +8329,22 @@ class specification_basic_type
                              firstaction.arguments(),
                              action_list(),
                              remainingmultiaction,
-                             r,r_is_null,comm_table);
+                             r,r_is_null,comm_table,thread_rewr);
       action_list tempr=r;
       tempr.push_front(firstaction);
       const tuple_list T=makeMultiActionConditionList_aux(
                            remainingmultiaction,comm_table,
-                           (r_is_null) ? action_list({ firstaction }) : tempr, false);
+                           (r_is_null) ? action_list({ firstaction }) : tempr, false, thread_rewr);
       return addActionCondition(firstaction,sort_bool::true_(),T,S);
     }
 
     tuple_list makeMultiActionConditionList(
       const action_list& multiaction,
-      const communication_expression_list& communications)
+      const communication_expression_list& communications,
+      rewriter& thread_rewr)
     {
       comm_entry comm_table(communications);
-      return makeMultiActionConditionList_aux(multiaction,comm_table,action_list(),true);
+      return makeMultiActionConditionList_aux(multiaction,comm_table,action_list(),true,thread_rewr);
     }
 
     void communicationcomposition(
@@ -8205,15 +8389,9 @@ class specification_basic_type
       }
       action_name_multiset_list allowlist((is_allow)?sort_multi_action_labels(allowlist1):allowlist1);
 
-      for (const stochastic_action_summand& smmnd: action_summands)
+      if (!inline_allow)
       {
-        const variable_list& sumvars=smmnd.summation_variables();
-        const action_list multiaction=smmnd.multi_action().actions();
-        const data_expression& condition=smmnd.condition();
-        const assignment_list& nextstate=smmnd.assignments();
-        const stochastic_distribution& dist=smmnd.distribution();
-
-        if (!inline_allow)
+        for (const stochastic_action_summand& smmnd: action_summands)
         {
           /* Recall a delta summand for every non delta summand.
            * The reason for this is that with communication, the
@@ -8227,8 +8405,9 @@ class specification_basic_type
 
           /* But first remove free variables from sumvars */
 
+          const data_expression& condition=smmnd.condition();
           variable_vector newsumvars_;
-          for (const variable& sumvar: sumvars)
+          for (const variable& sumvar: smmnd.summation_variables())
           {
             if (occursinterm(sumvar,condition) ||
                 (smmnd.has_time() && occursinterm(sumvar,smmnd.multi_action().time())))
@@ -8242,6 +8421,19 @@ class specification_basic_type
                                                             condition,
                                                             smmnd.multi_action().has_time()?deadlock(smmnd.multi_action().time()):deadlock()));
         }
+      }
+
+      /* The communications of different summands are calculated independently,
+         possibly in parallel. */
+      apply_to_indices(action_summands.size(),
+                       [&](const std::size_t index, rewriter& thread_rewr, stochastic_action_summand_vector& result)
+      {
+        const stochastic_action_summand& smmnd=action_summands[index];
+        const variable_list& sumvars=smmnd.summation_variables();
+        const action_list multiaction=smmnd.multi_action().actions();
+        const data_expression& condition=smmnd.condition();
+        const assignment_list& nextstate=smmnd.assignments();
+        const stochastic_distribution& dist=smmnd.distribution();
 
         /* the multiactionconditionlist is a list containing
            tuples, with a multiaction and the condition,
@@ -8254,7 +8446,8 @@ class specification_basic_type
         const tuple_list multiactionconditionlist=
           makeMultiActionConditionList(
             multiaction,
-            communications1);
+            communications1,
+            thread_rewr);
 
         assert(multiactionconditionlist.actions.size()==
                multiactionconditionlist.conditions.size());
@@ -8272,10 +8465,10 @@ class specification_basic_type
           }
 
           const data_expression communicationcondition=
-            RewriteTerm(multiactionconditionlist.conditions[i]);
+            RewriteTerm(multiactionconditionlist.conditions[i],thread_rewr);
 
           const data_expression newcondition=RewriteTerm(
-                                               lazy::and_(condition,communicationcondition));
+                                               lazy::and_(condition,communicationcondition),thread_rewr);
           stochastic_action_summand new_summand(sumvars,
                                      newcondition,
                                      smmnd.multi_action().has_time()?multi_action(multiaction, smmnd.multi_action().time()):multi_action(multiaction),
@@ -8285,17 +8478,17 @@ class specification_basic_type
           {
             if (sumelm(new_summand))
             {
-              new_summand.condition() = RewriteTerm(new_summand.condition());
+              new_summand.condition() = RewriteTerm(new_summand.condition(),thread_rewr);
             }
           }
 
           if (new_summand.condition()!=sort_bool::false_())
           {
-            resultsumlist.push_back(new_summand);
+            result.push_back(new_summand);
           }
         }
-
-      }
+      },
+      resultsumlist);
 
       /* Now the resulting delta summands must be added again */
 
@@ -8849,9 +9042,12 @@ class specification_basic_type
           const bool is_block,
           stochastic_action_summand_vector& action_summands)
     {
-      // First combine the action summands.
-      for (const stochastic_action_summand& summand1: action_summands1)
+      // First combine the action summands. The summands combined with different summands
+      // of action_summands1 are calculated independently, possibly in parallel.
+      apply_to_indices(action_summands1.size(),
+                       [&](const std::size_t index, rewriter& thread_rewr, stochastic_action_summand_vector& result)
       {
+        const stochastic_action_summand& summand1=action_summands1[index];
         const variable_list& sumvars1=summand1.summation_variables();
         const action_list multiaction1=summand1.multi_action().actions();
         const data_expression actiontime1=summand1.multi_action().time();
@@ -8924,10 +9120,10 @@ class specification_basic_type
                                               distribution1.variables()+distribution2.variables(),
                                               real_times_optimized(distribution1.distribution(),distribution2.distribution()));
 
-            condition3=RewriteTerm(condition3);
+            condition3=RewriteTerm(condition3,thread_rewr);
             if (condition3!=sort_bool::false_())
             {
-              action_summands.push_back(stochastic_action_summand(
+              result.push_back(stochastic_action_summand(
                                            allsums,
                                            condition3,
                                            has_time3?multi_action(multiaction3,action_time3):multi_action(multiaction3),
@@ -8936,7 +9132,8 @@ class specification_basic_type
             }
           }
         }
-      }
+      },
+      action_summands);
     }
 
     void calculate_communication_merge_action_deadlock_summands(
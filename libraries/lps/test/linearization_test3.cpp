@@ -14,6 +14,7 @@
 
 #include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/lps/linearise.h"
+#include "mcrl2/utilities/text_utility.h"
 
 using namespace mcrl2;
 using namespace mcrl2::lps;
@@ -124,6 +125,59 @@ BOOST_AUTO_TEST_CASE(type_checking_a_finite_set_with_numbers_can_go_astray)
   run_linearisation_test_case(spec,true);
 }
 
+// Linearises spec with the given number of threads, and returns the summands as strings in which the
+// summation variables are sorted. The specification is destroyed before the next linearisation starts,
+// such that the terms of the two linearisations are constructed independently.
+static std::vector<std::string> linearised_summands(const std::string& spec, std::size_t number_of_threads)
+{
+  t_lin_options options;
+  options.number_of_threads=number_of_threads;
+  const lps::stochastic_specification s=linearise(spec, options);
+
+  std::vector<std::string> result;
+  auto summation_variables=[](const data::variable_list& variables)
+  {
+    std::set<std::string> names;
+    for (const data::variable& v: variables)
+    {
+      names.insert(data::pp(v) + ":" + data::pp(v.sort()));
+    }
+    return utilities::string_join(names, ",");
+  };
+  for (const lps::stochastic_action_summand& summand: s.process().action_summands())
+  {
+    result.push_back("sum " + summation_variables(summand.summation_variables()) + ". " + data::pp(summand.condition()) + " -> " +
+                     lps::pp(summand.multi_action()) + " . " + data::pp(summand.assignments()));
+  }
+  for (const lps::deadlock_summand& summand: s.process().deadlock_summands())
+  {
+    result.push_back("sum " + summation_variables(summand.summation_variables()) + ". " + data::pp(summand.condition()) + " -> delta");
+  }
+  return result;
+}
+
+// The parallel and communication operators are calculated with multiple threads, which should not
+// influence the resulting linear process.
+BOOST_AUTO_TEST_CASE(linearisation_with_multiple_threads_yields_the_same_result)
+{
+  const std::string spec =
+    "act\n"
+    "  c,r_dup, s_dup1, s_dup2, r_inc, s_inc, r_mul1, r_mul2, s_mul: Int;\n"
+    "proc\n"
+    "  Dup = sum x:Int. r_dup(x) | s_dup1(x) | s_dup2(x) . Dup;\n"
+    "  Inc = sum x:Int. r_inc(x) | s_inc(x+1) . Inc;\n"
+    "  Mul = sum x,y:Int. r_mul1(x) | r_mul2(y) | s_mul(x*y) . Mul;\n"
+    "init comm({s_dup1 | r_mul1 -> c , s_dup2 | r_inc -> c, s_inc | r_mul2 ->c},\n"
+    "       Dup || Inc || Mul || Inc\n"
+    "     );\n";
+
+  if (atermpp::detail::GlobalThreadSafe)
+  {
+    const std::vector<std::string> expected=linearised_summands(spec, 1);
+    BOOST_CHECK(linearised_summands(spec, 4) == expected);
+  }
+}
+
 #ifndef MCRL2_SKIP_LONG_TESTS 
 
 BOOST_AUTO_TEST_CASE(Type_checking_of_function_can_be_problematic)
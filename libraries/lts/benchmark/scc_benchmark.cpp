@@ -0,0 +1,91 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/**
+
+  @file scc_benchmark.cpp
+
+  Measures the time of the sequential and the parallel tau loop (SCC)
+  partitioner, on a given .aut file or on a generated lts.
+
+  Usage: benchmark_target_lts_scc [THREADS [FILE | STATES [TRANSITIONS]]]
+
+*/
+
+#include "mcrl2/lts/detail/liblts_scc.h"
+#include "mcrl2/lts/lts_aut.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <cctype>
+#include <iostream>
+#include <random>
+
+using namespace mcrl2::lts;
+
+/// \brief Generates an lts in which most transitions are tau transitions. The states are grouped
+///        in blocks, and the tau transitions within a block form loops. The transitions between
+///        blocks are visible, which keeps the recursion depth of the sequential partitioner small.
+static lts_aut_t generate_lts(std::size_t states, std::size_t transitions)
+{
+  const std::size_t block_size = 100;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<std::size_t> state(0, states - 1);
+  std::uniform_int_distribution<std::size_t> offset(0, block_size - 1);
+
+  lts_aut_t l;
+  l.add_action(action_label_string("a"));
+  l.set_num_states(states);
+  l.set_initial_state(0);
+  for (std::size_t i = 0; i < transitions; ++i)
+  {
+    const std::size_t from = state(generator);
+    if (i % 10 == 0)
+    {
+      // An occasional visible transition between arbitrary states.
+      l.add_transition(transition(from, 1, state(generator)));
+    }
+    else
+    {
+      l.add_transition(transition(from, 0, std::min(from - from % block_size + offset(generator), states - 1)));
+    }
+  }
+  return l;
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t number_of_threads = 1;
+  if (argc > 1)
+  {
+    number_of_threads = static_cast<std::size_t>(std::stoi(argv[1]));
+  }
+
+  lts_aut_t l;
+  if (argc > 2 && !std::isdigit(argv[2][0]))
+  {
+    l.load(argv[2]);
+  }
+  else
+  {
+    const std::size_t states = argc > 2 ? std::stoul(argv[2]) : 1000000;
+    const std::size_t transitions = argc > 3 ? std::stoul(argv[3]) : 5 * states;
+    l = generate_lts(states, transitions);
+  }
+  std::cerr << "lts with " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
+
+  stopwatch timer;
+  detail::scc_partitioner<lts_aut_t> sequential(l);
+  std::cerr << "sequential: " << sequential.num_eq_classes() << " components, time: " << timer.seconds() << std::endl;
+
+  timer.reset();
+  detail::scc_partitioner<lts_aut_t> parallel(l, number_of_threads);
+  std::cerr << number_of_threads << " threads: " << parallel.num_eq_classes() << " components, time: " << timer.seconds() << std::endl;
+
+  return sequential.num_eq_classes() == parallel.num_eq_classes() ? 0 : 1;
+}
@@ -0,0 +1,408 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lts/detail/external_breadth_first_search.h
+/// \brief Breadth first state space generation that keeps the visited states and the levels on disk.
+
+#ifndef MCRL2_LTS_DETAIL_EXTERNAL_BREADTH_FIRST_SEARCH_H
+#define MCRL2_LTS_DETAIL_EXTERNAL_BREADTH_FIRST_SEARCH_H
+
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <queue>
+#include "mcrl2/lts/lts_builder.h"
+
+namespace mcrl2 {
+
+namespace lts {
+
+namespace detail {
+
+/// \brief Writes records, that consist of a fixed number of integers, to a binary file.
+class record_writer
+{
+  protected:
+    std::string m_filename;
+    std::ofstream m_stream;
+    std::size_t m_record_size;
+    std::size_t m_count = 0;
+
+  public:
+    record_writer(const std::string& filename, std::size_t record_size)
+      : m_filename(filename),
+        m_stream(filename, std::ios::binary | std::ios::trunc),
+        m_record_size(record_size)
+    {
+      if (!m_stream)
+      {
+        throw mcrl2::runtime_error("Cannot create the file " + filename + ".");
+      }
+    }
+
+    void write(const std::size_t* record)
+    {
+      m_stream.write(reinterpret_cast<const char*>(record), m_record_size * sizeof(std::size_t));
+      m_count++;
+    }
+
+    /// \brief Returns the number of records that have been written.
+    std::size_t count() const
+    {
+      return m_count;
+    }
+
+    void close()
+    {
+      m_stream.close();
+      if (m_stream.fail())
+      {
+        throw mcrl2::runtime_error("Could not write to the file " + m_filename + ". Is the disk full?");
+      }
+    }
+};
+
+/// \brief Reads the records of a file written by a record_writer one by one.
+class record_reader
+{
+  protected:
+    std::ifstream m_stream;
+    std::vector<std::size_t> m_record;
+    bool m_valid = false;
+
+  public:
+    record_reader(const std::string& filename, std::size_t record_size)
+      : m_stream(filename, std::ios::binary),
+        m_record(record_size)
+    {
+      if (!m_stream)
+      {
+        throw mcrl2::runtime_error("Cannot open the file " + filename + ".");
+      }
+      next();
+    }
+
+    /// \brief Reads the next record.
+    /// \return False if the end of the file has been reached.
+    bool next()
+    {
+      m_valid = static_cast<bool>(m_stream.read(reinterpret_cast<char*>(m_record.data()), m_record.size() * sizeof(std::size_t)));
+      return m_valid;
+    }
+
+    /// \brief Returns true if record() contains a record.
+    bool valid() const
+    {
+      return m_valid;
+    }
+
+    const std::size_t* record() const
+    {
+      return m_record.data();
+    }
+};
+
+/// \brief Breadth first search in external memory, with delayed duplicate detection.
+/// \details The values of the state parameters are interned in memory, such that a state is a vector of
+///          integers. Every level is expanded into successor records (state, source, action), which are
+///          sorted in buffers of a bounded size and written to disk as runs. The runs are then merged
+///          with the sorted file of visited states. A successor that is not visited gets the next index,
+///          and is written to the file of the next level and to the new file of visited states. The
+///          transitions are reported to the builder during the merge. As indices are given in the
+///          order of the level files, the states are reported in the order of their indices at the end.
+template <typename Explorer>
+class external_breadth_first_search
+{
+  protected:
+    Explorer& m_explorer;
+    lts_builder& m_builder;
+    std::filesystem::path m_directory;
+    std::size_t m_buffer_size;
+
+    std::size_t m_arity = 0;
+    std::deque<atermpp::indexed_set<data::data_expression>> m_values;
+    std::unordered_map<lps::multi_action, std::size_t> m_action_indices;
+    std::vector<lps::multi_action> m_actions;
+
+    std::vector<std::string> m_level_files;
+    std::size_t m_number_of_states = 0;
+    std::size_t m_number_of_transitions = 0;
+    std::size_t m_number_of_files = 0;
+
+    std::string new_filename(const std::string& kind)
+    {
+      return (m_directory / (kind + "_" + std::to_string(m_number_of_files++))).string();
+    }
+
+    void encode(const lps::state& s, std::size_t* values)
+    {
+      std::size_t i = 0;
+      for (const data::data_expression& x: s)
+      {
+        values[i] = m_values[i].insert(x).first;
+        i++;
+      }
+    }
+
+    lps::state decode(const std::size_t* values) const
+    {
+      lps::state result;
+      std::size_t i = 0;
+      lps::make_state(result, values, m_arity, [&](data::data_expression& x, std::size_t value) { x = m_values[i++].at(value); });
+      return result;
+    }
+
+    std::size_t action_index(const lps::multi_action& a)
+    {
+      auto i = m_action_indices.find(a);
+      if (i == m_action_indices.end())
+      {
+        i = m_action_indices.emplace(a, m_actions.size()).first;
+        m_actions.push_back(a);
+      }
+      return i->second;
+    }
+
+    bool less_state(const std::size_t* x, const std::size_t* y) const
+    {
+      return std::lexicographical_compare(x, x + m_arity, y, y + m_arity);
+    }
+
+    bool equal_state(const std::size_t* x, const std::size_t* y) const
+    {
+      return std::equal(x, x + m_arity, y);
+    }
+
+    // Sorts the successor records in buffer, and writes them to a new run file.
+    std::string write_run(const std::vector<std::size_t>& buffer)
+    {
+      const std::size_t record_size = m_arity + 2;
+      std::vector<std::size_t> order(buffer.size() / record_size);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j)
+        {
+          const std::size_t* x = &buffer[i * record_size];
+          const std::size_t* y = &buffer[j * record_size];
+          return std::lexicographical_compare(x, x + record_size, y, y + record_size);
+        });
+
+      std::string filename = new_filename("run");
+      record_writer writer(filename, record_size);
+      for (std::size_t i: order)
+      {
+        writer.write(&buffer[i * record_size]);
+      }
+      writer.close();
+      return filename;
+    }
+
+    // Generates the successors of the states in level_file, and returns the sorted runs of successor records.
+    std::vector<std::string> expand(const std::string& level_file)
+    {
+      const std::size_t record_size = m_arity + 2;
+      std::vector<std::string> runs;
+      std::vector<std::size_t> buffer;
+      for (record_reader reader(level_file, m_arity + 1); reader.valid(); reader.next())
+      {
+        const std::size_t from = reader.record()[m_arity];
+        for (const auto& [a, s1]: m_explorer.generate_transitions(decode(reader.record())))
+        {
+          std::size_t offset = buffer.size();
+          buffer.resize(offset + record_size);
+          encode(s1, &buffer[offset]);
+          buffer[offset + m_arity] = from;
+          buffer[offset + m_arity + 1] = action_index(a);
+          if (buffer.size() >= m_buffer_size * record_size)
+          {
+            runs.push_back(write_run(buffer));
+            buffer.clear();
+          }
+        }
+      }
+      if (!buffer.empty())
+      {
+        runs.push_back(write_run(buffer));
+      }
+      return runs;
+    }
+
+    // Merges the runs with the visited states, which replaces visited_file and level_file by new files.
+    // Returns the number of states in the new level.
+    std::size_t merge(const std::vector<std::string>& runs, std::string& visited_file, std::string& level_file)
+    {
+      const std::size_t record_size = m_arity + 2;
+      std::vector<std::unique_ptr<record_reader>> readers;
+      for (const std::string& run: runs)
+      {
+        readers.push_back(std::make_unique<record_reader>(run, record_size));
+      }
+      auto greater = [&](std::size_t i, std::size_t j)
+        {
+          const std::size_t* x = readers[i]->record();
+          const std::size_t* y = readers[j]->record();
+          return std::lexicographical_compare(y, y + record_size, x, x + record_size);
+        };
+      std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(greater)> queue(greater);
+      for (std::size_t i = 0; i < readers.size(); i++)
+      {
+        if (readers[i]->valid())
+        {
+          queue.push(i);
+        }
+      }
+
+      record_reader visited(visited_file, m_arity + 1);
+      const std::string new_visited_file = new_filename("visited");
+      record_writer new_visited(new_visited_file, m_arity + 1);
+      level_file = new_filename("level");
+      record_writer new_level(level_file, m_arity + 1);
+
+      // The state of the last successor, followed by its index.
+      std::vector<std::size_t> current(m_arity + 1);
+      bool has_current = false;
+      while (!queue.empty())
+      {
+        const std::size_t i = queue.top();
+        queue.pop();
+        const std::size_t* successor = readers[i]->record();
+        if (!has_current || !equal_state(successor, current.data()))
+        {
+          std::copy(successor, successor + m_arity, current.begin());
+          has_current = true;
+          while (visited.valid() && less_state(visited.record(), successor))
+          {
+            new_visited.write(visited.record());
+            visited.next();
+          }
+          if (visited.valid() && equal_state(visited.record(), successor))
+          {
+            current[m_arity] = visited.record()[m_arity];
+          }
+          else
+          {
+            current[m_arity] = m_number_of_states++;
+            new_visited.write(current.data());
+            new_level.write(current.data());
+          }
+        }
+        m_builder.add_transition(successor[m_arity], m_actions[successor[m_arity + 1]], current[m_arity]);
+        m_number_of_transitions++;
+        if (readers[i]->next())
+        {
+          queue.push(i);
+        }
+      }
+      for (; visited.valid(); visited.next())
+      {
+        new_visited.write(visited.record());
+      }
+      new_visited.close();
+      new_level.close();
+
+      readers.clear();
+      for (const std::string& run: runs)
+      {
+        std::filesystem::remove(run);
+      }
+      std::filesystem::remove(visited_file);
+      visited_file = new_visited_file;
+      return new_level.count();
+    }
+
+  public:
+    /// \brief Constructor.
+    /// \param directory The directory in which a fresh subdirectory is created for the files.
+    /// \param buffer_size The number of successors that is kept in memory before they are written to disk.
+    external_breadth_first_search(Explorer& explorer, lts_builder& builder, const std::string& directory, std::size_t buffer_size)
+      : m_explorer(explorer),
+        m_builder(builder),
+        m_buffer_size(std::max(buffer_size, std::size_t(1)))
+    {
+      for (std::size_t i = 0; ; i++)
+      {
+        m_directory = std::filesystem::path(directory) / ("lps2lts_external_" + std::to_string(i));
+        if (std::filesystem::create_directories(m_directory))
+        {
+          break;
+        }
+      }
+    }
+
+    ~external_breadth_first_search()
+    {
+      std::error_code ec;
+      std::filesystem::remove_all(m_directory, ec);
+    }
+
+    /// \brief Generates the state space, and reports it to the builder, including the states.
+    void run()
+    {
+      const lps::state s0 = m_explorer.initial_state();
+      m_arity = s0.size();
+      for (std::size_t i = 0; i < m_arity; i++)
+      {
+        m_values.emplace_back();
+      }
+
+      std::vector<std::size_t> initial_record(m_arity + 1);
+      encode(s0, initial_record.data());
+      initial_record[m_arity] = m_number_of_states++;
+      std::string visited_file = new_filename("visited");
+      std::string level_file = new_filename("level");
+      for (const std::string& filename: { visited_file, level_file })
+      {
+        record_writer writer(filename, m_arity + 1);
+        writer.write(initial_record.data());
+        writer.close();
+      }
+      m_level_files.push_back(level_file);
+
+      std::size_t level = 1;
+      std::size_t level_size = 1;
+      while (level_size > 0)
+      {
+        std::vector<std::string> runs = expand(level_file);
+        level_size = merge(runs, visited_file, level_file);
+        m_level_files.push_back(level_file);
+        mCRL2log(log::verbose) << "Explored level " << level << " using " << runs.size() << " run" << (runs.size() == 1 ? "" : "s")
+                               << "; found " << level_size << " new state" << (level_size == 1 ? "" : "s") << "." << std::endl;
+        level++;
+      }
+      std::filesystem::remove(visited_file);
+
+      mCRL2log(log::verbose) << "Done with state space generation (" << level - 1 << " level" << ((level == 2) ? "" : "s") << ", "
+                             << m_number_of_states << " state" << ((m_number_of_states == 1) ? "" : "s")
+                             << " and " << m_number_of_transitions << " transition" << ((m_number_of_transitions == 1) ? "" : "s") << ")" << std::endl;
+
+      // The level files contain the states in the order of their indices.
+      std::size_t next_level = 0;
+      std::unique_ptr<record_reader> reader;
+      m_builder.finalize(m_number_of_states,
+        [&](std::size_t i)
+        {
+          while (!reader || !reader->valid())
+          {
+            reader = std::make_unique<record_reader>(m_level_files[next_level++], m_arity + 1);
+          }
+          assert(reader->record()[m_arity] == i);
+          mcrl2::utilities::mcrl2_unused(i);
+          lps::state s = decode(reader->record());
+          reader->next();
+          return s;
+        },
+        false);
+    }
+};
+
+} // namespace detail
+
+} // namespace lts
+
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_DETAIL_EXTERNAL_BREADTH_FIRST_SEARCH_H
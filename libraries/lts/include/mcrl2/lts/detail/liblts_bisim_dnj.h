@@ -5487,9 +5487,12 @@ class bisim_partitioner_dnj
 ///                                    actions on states must be preserved.  If
 ///                                    false these are removed.  If true these
 ///                                    are preserved.
+/// \param         number_of_threads   The number of threads that is used to
+///                                    find the tau-SCCs.
 template <class LTS_TYPE>
 void bisimulation_reduce_dnj(LTS_TYPE& l, bool const branching = false,
-                                        bool const preserve_divergence = false)
+                                        bool const preserve_divergence = false,
+                                        std::size_t const number_of_threads = 1)
 {
     if (1 >= l.num_states())
     {
@@ -5500,7 +5503,7 @@ void bisimulation_reduce_dnj(LTS_TYPE& l, bool const branching = false,
     // Line 2.1: Find tau-SCCs and contract each of them to a single state
     if (branching)
     {
-        scc_reduce(l, preserve_divergence);
+        scc_reduce(l, preserve_divergence, number_of_threads);
     }
 
     // Now apply the branching bisimulation reduction algorithm.  If there
@@ -10,6 +10,9 @@
 
 #ifndef _LIBLTS_SCC_H
 #define _LIBLTS_SCC_H
+#include <atomic>
+#include <exception>
+#include <thread>
 #include <unordered_set>
 #include "mcrl2/lts/lts.h"
 #include "mcrl2/utilities/logger.h"
@@ -121,6 +124,350 @@ namespace detail
       }
   };
 
+  /// \brief The number of states that a thread of the parallel scc algorithm claims at once.
+  constexpr std::size_t scc_chunk_size = 1024;
+
+  /// \brief Calls f(first, last) for consecutive chunks [first, last) of [0, n), which are handed out
+  ///        dynamically to number_of_threads threads. An exception of f in any thread, such as
+  ///        std::bad_alloc, stops the distribution of chunks and is rethrown after all threads are joined.
+  template <typename Function>
+  void scc_parallel_for(const std::size_t n, const std::size_t number_of_threads, Function f)
+  {
+    std::atomic<std::size_t> next_chunk(0);
+    std::vector<std::exception_ptr> errors(number_of_threads);
+    auto work = [&](std::size_t thread_index)
+    {
+      try
+      {
+        for (std::size_t first = next_chunk.fetch_add(scc_chunk_size); first < n; first = next_chunk.fetch_add(scc_chunk_size))
+        {
+          f(first, std::min(first + scc_chunk_size, n));
+        }
+      }
+      catch (...)
+      {
+        errors[thread_index] = std::current_exception();
+        next_chunk = n;
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(number_of_threads - 1);
+    for (std::size_t i = 1; i < number_of_threads; ++i)
+    {
+      threads.emplace_back(work, i);
+    }
+    work(0);
+    for (std::thread& t: threads)
+    {
+      t.join();
+    }
+    for (const std::exception_ptr& error: errors)
+    {
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+
+  /// \brief Computes the strongly connected components of the tau transitions of aut with multiple threads.
+  /// \details First all states that do not lie on a tau loop are removed, by repeatedly removing the states
+  ///          without incoming or outgoing tau transitions. Then the components of the remaining states
+  ///          are computed by the colouring algorithm of S. Orzan, On distributed verification and verified
+  ///          distribution, PhD thesis, 2004. Every state gets the highest state number that can reach it. A
+  ///          state that has its own number as colour, together with the states of its colour that can reach 
+  ///          it, forms a component. These components are removed, after which the states without incoming
+  ///          or outgoing tau transitions are removed again, and this is repeated until no state remains,
+  ///          or until an iteration removes less than one percent of the remaining states. In the latter
+  ///          case the remaining components are computed by a non recursive version of Tarjan's algorithm.
+  ///          All other steps are divided over the threads. The components are numbered in the order of the
+  ///          smallest state they contain, such that the result does not depend on the number of threads.
+  /// \param[out] block_index_of_a_state The component of each state.
+  /// \return The number of components.
+  template <class LTS_TYPE>
+  std::size_t parallel_tau_scc(const LTS_TYPE& aut, const std::size_t number_of_threads, std::vector<std::size_t>& block_index_of_a_state)
+  {
+    typedef std::size_t state_type;
+    const state_type npos = std::numeric_limits<state_type>::max();
+    const std::size_t n = aut.num_states();
+
+    const indexed_sorted_vector_for_tau_transitions<LTS_TYPE> src_tgt(aut, true);
+    const indexed_sorted_vector_for_tau_transitions<LTS_TYPE> tgt_src(aut, false);
+
+    // For each state, the number of tau transitions from or to other states that have no component yet. 
+    // Tau loops on a single state are irrelevant for the components and are not counted.
+    std::vector<std::atomic<std::size_t>> incoming(n);
+    std::vector<std::atomic<std::size_t>> outgoing(n);
+    // The representative of the component of each state, or npos if it has no component yet.
+    std::vector<std::atomic<state_type>> component(n);
+    std::vector<std::atomic<state_type>> colour(n);
+
+    scc_parallel_for(n, number_of_threads, [&](std::size_t first, std::size_t last)
+      {
+        for (state_type s = first; s < last; ++s)
+        {
+          std::size_t count = 0;
+          for (std::size_t i = src_tgt.lowerbound(s); i < src_tgt.upperbound(s); ++i)
+          {
+            count += (src_tgt.get_transitions()[i] != s ? 1 : 0);
+          }
+          outgoing[s].store(count, std::memory_order_relaxed);
+
+          count = 0;
+          for (std::size_t i = tgt_src.lowerbound(s); i < tgt_src.upperbound(s); ++i)
+          {
+            count += (tgt_src.get_transitions()[i] != s ? 1 : 0);
+          }
+          incoming[s].store(count, std::memory_order_relaxed);
+          component[s].store(npos, std::memory_order_relaxed);
+        }
+      });
+
+    // Removes the tau transitions of a state s that got a component. States that consequently have no 
+    // incoming or outgoing tau transitions anymore are pushed on the stack.
+    auto detach = [&](const state_type s, std::vector<state_type>& stack)
+    {
+      for (std::size_t i = src_tgt.lowerbound(s); i < src_tgt.upperbound(s); ++i)
+      {
+        const state_type t = src_tgt.get_transitions()[i];
+        if (t != s && incoming[t].fetch_sub(1) == 1)
+        {
+          stack.push_back(t);
+        }
+      }
+      for (std::size_t i = tgt_src.lowerbound(s); i < tgt_src.upperbound(s); ++i)
+      {
+        const state_type t = tgt_src.get_transitions()[i];
+        if (t != s && outgoing[t].fetch_sub(1) == 1)
+        {
+          stack.push_back(t);
+        }
+      }
+    };
+
+    // Puts the states on the stack in a component of their own. A state without incoming or outgoing tau
+    // transitions cannot lie on a tau loop. The compare and swap ensures that each state is removed once.
+    auto remove_trivial_components = [&](std::vector<state_type>& stack)
+    {
+      while (!stack.empty())
+      {
+        const state_type s = stack.back();
+        stack.pop_back();
+        state_type expected = npos;
+        if (component[s].compare_exchange_strong(expected, s))
+        {
+          detach(s, stack);
+        }
+      }
+    };
+
+    scc_parallel_for(n, number_of_threads, [&](std::size_t first, std::size_t last)
+      {
+        std::vector<state_type> stack;
+        for (state_type s = first; s < last; ++s)
+        {
+          if (incoming[s].load() == 0 || outgoing[s].load() == 0)
+          {
+            stack.push_back(s);
+            remove_trivial_components(stack);
+          }
+        }
+      });
+
+    // Computes the components of the given states with an iterative version of Tarjan's algorithm, 
+    // ignoring the states that already have a component.
+    auto sequential_components = [&](const std::vector<state_type>& states)
+    {
+      std::vector<std::size_t> index(n, npos);
+      std::vector<std::size_t> lowlink(n);
+      std::vector<state_type> tarjan_stack;
+      std::vector<std::pair<state_type, std::size_t>> call_stack; // A state and its next outgoing transition.
+      std::size_t counter = 0;
+
+      auto visit = [&](const state_type s)
+      {
+        index[s] = counter;
+        lowlink[s] = counter;
+        ++counter;
+        tarjan_stack.push_back(s);
+        call_stack.emplace_back(s, src_tgt.lowerbound(s));
+      };
+
+      for (const state_type root: states)
+      {
+        if (index[root] != npos)
+        {
+          continue;
+        }
+        visit(root);
+        while (!call_stack.empty())
+        {
+          const state_type s = call_stack.back().first;
+          const std::size_t i = call_stack.back().second++;
+          if (i < src_tgt.upperbound(s))
+          {
+            const state_type t = src_tgt.get_transitions()[i];
+            if (component[t].load(std::memory_order_relaxed) == npos)
+            {
+              if (index[t] == npos)
+              {
+                visit(t);
+              }
+              else
+              {
+                lowlink[s] = std::min(lowlink[s], index[t]);
+              }
+            }
+          }
+          else
+          {
+            if (lowlink[s] == index[s])
+            {
+              state_type t;
+              do
+              {
+                t = tarjan_stack.back();
+                tarjan_stack.pop_back();
+                component[t].store(s, std::memory_order_relaxed);
+              }
+              while (t != s);
+            }
+            call_stack.pop_back();
+            if (!call_stack.empty())
+            {
+              const state_type parent = call_stack.back().first;
+              lowlink[parent] = std::min(lowlink[parent], lowlink[s]);
+            }
+          }
+        }
+      }
+    };
+
+    std::vector<state_type> remaining;
+    std::size_t previously_remaining = 0;
+    for (std::size_t iteration = 1; ; ++iteration)
+    {
+      remaining.clear();
+      for (state_type s = 0; s < n; ++s)
+      {
+        if (component[s].load(std::memory_order_relaxed) == npos)
+        {
+          remaining.push_back(s);
+        }
+      }
+      mCRL2log(log::debug) << "Tau loop (SCC) partitioner iteration " << iteration << " with " << remaining.size() << " remaining states." << std::endl;
+      if (remaining.empty())
+      {
+        break;
+      }
+
+      // Every iteration removes at least one component. When an iteration removes only a few states, 
+      // for instance when the components form a long chain, the remaining states are done sequentially.
+      if (remaining.size() <= scc_chunk_size || (iteration > 1 && 100 * (previously_remaining - remaining.size()) < previously_remaining))
+      {
+        sequential_components(remaining);
+        break;
+      }
+      previously_remaining = remaining.size();
+
+      scc_parallel_for(remaining.size(), number_of_threads, [&](std::size_t first, std::size_t last)
+        {
+          for (std::size_t i = first; i < last; ++i)
+          {
+            colour[remaining[i]].store(remaining[i], std::memory_order_relaxed);
+          }
+        });
+
+      // Propagate the colours forward until every state has the highest colour of the states that reach it. 
+      // The states are handled from high to low, such that high colours are propagated first.
+      scc_parallel_for(remaining.size(), number_of_threads, [&](std::size_t first, std::size_t last)
+        {
+          std::vector<state_type> stack;
+          for (std::size_t i = first; i < last; ++i)
+          {
+            stack.push_back(remaining[remaining.size() - 1 - i]);
+            while (!stack.empty())
+            {
+              const state_type s = stack.back();
+              stack.pop_back();
+              const state_type c = colour[s].load();
+              for (std::size_t j = src_tgt.lowerbound(s); j < src_tgt.upperbound(s); ++j)
+              {
+                const state_type t = src_tgt.get_transitions()[j];
+                if (component[t].load(std::memory_order_relaxed) == npos)
+                {
+                  state_type current = colour[t].load();
+                  while (current < c)
+                  {
+                    if (colour[t].compare_exchange_weak(current, c))
+                    {
+                      stack.push_back(t);
+                      break;
+                    }
+                  }
+                }
+              }
+            }
+          }
+        });
+
+      // A state that kept its own colour reaches all states of this colour, and it is in the same 
+      // component as the states with this colour that can reach it. The states of different colours
+      // are disjoint, so every component is collected by a single thread.
+      scc_parallel_for(remaining.size(), number_of_threads, [&](std::size_t first, std::size_t last)
+        {
+          std::vector<state_type> members;
+          std::vector<state_type> stack;
+          for (std::size_t i = first; i < last; ++i)
+          {
+            const state_type root = remaining[i];
+            state_type expected = npos;
+            if (colour[root].load() != root || !component[root].compare_exchange_strong(expected, root))
+            {
+              continue;
+            }
+
+            members.clear();
+            members.push_back(root);
+            for (std::size_t k = 0; k < members.size(); ++k)
+            {
+              const state_type s = members[k];
+              for (std::size_t j = tgt_src.lowerbound(s); j < tgt_src.upperbound(s); ++j)
+              {
+                const state_type t = tgt_src.get_transitions()[j];
+                if (colour[t].load(std::memory_order_relaxed) == root && component[t].load() == npos)
+                {
+                  component[t].store(root);
+                  members.push_back(t);
+                }
+              }
+            }
+
+            for (const state_type s: members)
+            {
+              detach(s, stack);
+            }
+            remove_trivial_components(stack);
+          }
+        });
+    }
+
+    // Number the components in the order of their smallest state.
+    std::vector<state_type> number(n, npos);
+    std::size_t number_of_components = 0;
+    for (state_type s = 0; s < n; ++s)
+    {
+      state_type& c = number[component[s].load(std::memory_order_relaxed)];
+      if (c == npos)
+      {
+        c = number_of_components++;
+      }
+      block_index_of_a_state[s] = c;
+    }
+    return number_of_components;
+  }
+
 /// \brief This class contains an scc partitioner removing inert tau loops.
 
 template < class LTS_TYPE>
@@ -140,8 +487,11 @@ class scc_partitioner
      *  When applying the function \ref replace_transition_system the
      *  automaton l is replaced by (aka shrinked to) the automaton modulo the
      *  calculated partition.
-     *  \param[in] l reference to an LTS. */
-    scc_partitioner(LTS_TYPE& l);
+     *  With more than one thread, the partition is calculated by the
+     *  algorithm in \ref parallel_tau_scc.
+     *  \param[in] l reference to an LTS.
+     *  \param[in] number_of_threads The number of threads that are used. */
+    scc_partitioner(LTS_TYPE& l, std::size_t number_of_threads = 1);
 
     /** \brief Destroys this partitioner. */
     ~scc_partitioner()=default;
@@ -207,7 +557,7 @@ class scc_partitioner
 
 
 template < class LTS_TYPE>
-scc_partitioner<LTS_TYPE>::scc_partitioner(LTS_TYPE& l)
+scc_partitioner<LTS_TYPE>::scc_partitioner(LTS_TYPE& l, std::size_t number_of_threads)
   :aut(l),
     block_index_of_a_state(aut.num_states(),0),
     equivalence_class_index(0)
@@ -215,6 +565,13 @@ scc_partitioner<LTS_TYPE>::scc_partitioner(LTS_TYPE& l)
   mCRL2log(log::debug) << "Tau loop (SCC) partitioner created for " << l.num_states() << " states and " <<
               l.num_transitions() << " transitions" << std::endl;
 
+  if (number_of_threads > 1)
+  {
+    equivalence_class_index = parallel_tau_scc(aut, number_of_threads, block_index_of_a_state);
+    mCRL2log(log::debug) << "Tau loop (SCC) partitioner reduces lts to " << equivalence_class_index << " states." << std::endl;
+    return;
+  }
+
   dfsn2state.reserve(aut.num_states());
 
   // Initialise the data structures used in the recursive DFS procedure.
@@ -238,6 +595,19 @@ scc_partitioner<LTS_TYPE>::scc_partitioner(LTS_TYPE& l)
       equivalence_class_index++;
     }
   }
+
+  // Number the components in the order of the smallest state they contain, as parallel_tau_scc does, such
+  // that the result does not depend on the number of threads.
+  std::vector<state_type> component_number(equivalence_class_index, aut.num_states());
+  state_type next_component_number = 0;
+  for (state_type& b: block_index_of_a_state)
+  {
+    if (component_number[b] == aut.num_states())
+    {
+      component_number[b] = next_component_number++;
+    }
+    b = component_number[b];
+  }
   mCRL2log(log::debug) << "Tau loop (SCC) partitioner reduces lts to " << equivalence_class_index << " states." << std::endl;
 
   dfsn2state.clear();
@@ -359,9 +729,9 @@ void scc_partitioner<LTS_TYPE>::dfs_numbering(
 } // namespace detail
 
 template < class LTS_TYPE>
-void scc_reduce(LTS_TYPE& l,const bool preserve_divergence_loops = false)
+void scc_reduce(LTS_TYPE& l,const bool preserve_divergence_loops = false, const std::size_t number_of_threads = 1)
 {
-  detail::scc_partitioner<LTS_TYPE> scc_part(l);
+  detail::scc_partitioner<LTS_TYPE> scc_part(l, number_of_threads);
   scc_part.replace_transition_system(preserve_divergence_loops);
 }
 
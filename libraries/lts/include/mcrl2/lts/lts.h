@@ -28,6 +28,7 @@
 #include <map>
 #include "mcrl2/lts/transition.h"
 #include "mcrl2/lts/lts_type.h"
+#include "mcrl2/utilities/exception.h"
 
 
 namespace mcrl2
@@ -99,6 +100,16 @@ class lts: public LTS_BASE
     // feedback, for instance using counter examples, using the original action name. 
     std::set<labels_size_type> m_hidden_label_set; 
 
+    // Auxiliary function. Checks whether the indices of n states or action labels fit in a transition.
+    static void check_size(const std::size_t n, const std::string& kind)
+    {
+      if (n > transition::max_size)
+      {
+        throw mcrl2::runtime_error("An LTS with " + std::to_string(n) + " " + kind + " cannot be stored, as at most " +
+                                   std::to_string(transition::max_size) + " " + kind + " fit in the compact transitions of this toolset.");
+      }
+    }
+
     // Auxiliary function. Rename the labels according to the action_rename_map;
     void rename_labels(const std::map<labels_size_type, labels_size_type>& action_rename_map)
     {
@@ -255,6 +266,7 @@ class lts: public LTS_BASE
      */
     void set_num_states(const states_size_type n, const bool has_state_labels = true)
     {
+      check_size(n, "states");
       m_nstates = n;
       if (has_state_labels)
       {
@@ -285,6 +297,7 @@ class lts: public LTS_BASE
      *          these are set to the default action label. */
     void set_num_action_labels(const labels_size_type n)
     {
+      check_size(n, "action labels");
       m_action_labels.resize(n);
       assert(m_action_labels.size()>0 && m_action_labels[const_tau_label_index]==ACTION_LABEL_T::tau_action());
     } 
@@ -322,6 +335,7 @@ class lts: public LTS_BASE
      * \return The number of the added state label. */
     states_size_type add_state(const STATE_LABEL_T& label=STATE_LABEL_T())
     {
+      check_size(m_nstates + 1, "states");
       if (label!=STATE_LABEL_T())
       {
         m_state_labels.resize(m_nstates);
@@ -341,6 +355,7 @@ class lts: public LTS_BASE
         return const_tau_label_index;
       }
       assert(std::find(m_action_labels.begin(),m_action_labels.end(),label)==m_action_labels.end()); // Action labels must be unique. 
+      check_size(m_action_labels.size() + 1, "action labels");
       const labels_size_type label_index=m_action_labels.size();
       m_action_labels.push_back(label);
       return label_index;
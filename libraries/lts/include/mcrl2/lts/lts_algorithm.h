@@ -40,9 +40,16 @@ namespace lts
  * \param[in] l A labelled transition system that must be reduced.
  * \param[in] eq The equivalence with respect to which the LTS will be
  *            reduced.
+ * \param[in] number_of_threads The number of threads that is used by the
+ *            reductions that can run in parallel, which are the signature
+ *            based reductions, such as bisim-sig and branching-bisim-sig,
+ *            and the removal of tau loops that precedes the branching
+ *            bisimulation and tau-star reductions. The default (branching)
+ *            bisimulation reductions split one block at a time, so for
+ *            these only the removal of tau loops uses multiple threads.
  **/
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l, lts_equivalence eq);
+void reduce(LTS_TYPE& l, lts_equivalence eq, std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is equivalent to another LTS.
  * \param[in] l1 The first LTS that will be compared.
@@ -572,7 +579,7 @@ void merge(LTS_TYPE& l1, const LTS_TYPE& l2)
 
 
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l,lts_equivalence eq)
+void reduce(LTS_TYPE& l, lts_equivalence eq, std::size_t number_of_threads)
 {
 
   switch (eq)
@@ -596,18 +603,18 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_bisim<LTS_TYPE> > s(l);
+      sigref<LTS_TYPE, signature_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
     case lts_eq_branching_bisim:
     {
-      detail::bisimulation_reduce_dnj(l,true,false);
+      detail::bisimulation_reduce_dnj(l,true,false,number_of_threads);
       return;
     }
     case lts_eq_branching_bisim_gv:
     {
-      detail::bisimulation_reduce(l,true,false);
+      detail::bisimulation_reduce(l,true,false,number_of_threads);
       return;
     }
     case lts_eq_branching_bisim_gjkw:
@@ -617,18 +624,20 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_branching_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_branching_bisim<LTS_TYPE> > s(l);
+      // Contracting the tau cycles first allows the inert signatures to be computed level by level in parallel.
+      scc_reduce(l, false, number_of_threads);
+      sigref<LTS_TYPE, signature_branching_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
     case lts_eq_divergence_preserving_branching_bisim:
     {
-      detail::bisimulation_reduce_dnj(l,true,true);
+      detail::bisimulation_reduce_dnj(l,true,true,number_of_threads);
       return;
     }
     case lts_eq_divergence_preserving_branching_bisim_gv:
     {
-      detail::bisimulation_reduce(l,true,true);
+      detail::bisimulation_reduce(l,true,true,number_of_threads);
       return;
     }
     case lts_eq_divergence_preserving_branching_bisim_gjkw:
@@ -638,7 +647,9 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_divergence_preserving_branching_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_divergence_preserving_branching_bisim<LTS_TYPE> > s(l);
+      // Contracting the tau cycles first allows the inert signatures to be computed level by level in parallel.
+      scc_reduce(l, true, number_of_threads);
+      sigref<LTS_TYPE, signature_divergence_preserving_branching_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
@@ -747,7 +758,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
       return;
     case lts_eq_weak_trace:
     {
-      detail::bisimulation_reduce(l,true,false);
+      detail::bisimulation_reduce(l,true,false,number_of_threads);
       detail::tau_star_reduce(l);
       detail::bisimulation_reduce(l,false);
       determinise(l);
@@ -756,7 +767,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_red_tau_star:
     {
-      detail::bisimulation_reduce(l,true,false);
+      detail::bisimulation_reduce(l,true,false,number_of_threads);
       detail::tau_star_reduce(l);
       detail::bisimulation_reduce(l,false);
       return;
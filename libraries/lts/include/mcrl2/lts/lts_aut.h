@@ -72,16 +72,20 @@ class lts_aut_t : public lts< state_label_empty, action_label_string, detail::lt
 
     /** \brief Load the labelled transition system from a file.
      *  \details If the filename is empty, the result is read from stdin.
-                 The input file must be in .aut format.
+                 The input file must be in .aut format. The input is read into memory
+                 at once, and large inputs are split in parts that are parsed in parallel.
      *  \param[in] filename Name of the file from which this lts is read.
+     *  \param[in] number_of_threads The number of threads used to parse the transitions.
      */
-    void load(const std::string& filename);
+    void load(const std::string& filename, std::size_t number_of_threads = 1);
 
     /** \brief Load the labelled transition system from an input stream.
-     *  \details The input stream must be in .aut format.
+     *  \details The input stream must be in .aut format. It is read up to its end, or up
+                 to and including an EOT character that separates two .aut files.
      *  \param[in] is The input stream.
+     *  \param[in] number_of_threads The number of threads used to parse the transitions.
      */
-    void load(std::istream& is);
+    void load(std::istream& is, std::size_t number_of_threads = 1);
 
     /** \brief Save the labelled transition system to file.
      *  \details If the filename is empty, the result is written to stdout.
@@ -105,16 +109,20 @@ class probabilistic_lts_aut_t :
 
     /** \brief Load the labelled transition system from a file.
      *  \details If the filename is empty, the result is read from stdin.
-                 The input file must be in .aut format.
+                 The input file must be in .aut format. The input is read into memory
+                 at once, and large inputs are split in parts that are parsed in parallel.
      *  \param[in] filename Name of the file from which this lts is read.
+     *  \param[in] number_of_threads The number of threads used to parse the transitions.
      */
-    void load(const std::string& filename);
+    void load(const std::string& filename, std::size_t number_of_threads = 1);
 
     /** \brief Load the labelled transition system from an input stream.
-     *  \details The input stream must be in .aut format.
+     *  \details The input stream must be in .aut format. It is read up to its end, or up
+                 to and including an EOT character that separates two .aut files.
      *  \param[in] is The input stream.
+     *  \param[in] number_of_threads The number of threads used to parse the transitions.
      */
-    void load(std::istream& is);
+    void load(std::istream& is, std::size_t number_of_threads = 1);
 
     /** \brief Save the labelled transition system to file.
      *  \details If the filename is empty, the result is written to stdout.
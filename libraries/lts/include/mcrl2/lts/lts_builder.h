@@ -12,6 +12,8 @@
 #ifndef MCRL2_LTS_BUILDER_H
 #define MCRL2_LTS_BUILDER_H
 
+#include "mcrl2/atermpp/standard_containers/unordered_map.h"
+#include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/lps/explorer.h"
 #include "mcrl2/lts/detail/lts_convert.h"
 #include "mcrl2/lts/lts_io.h"
@@ -27,14 +29,32 @@ lps::state remove_time_stamp(const lps::state& s)
   return lps::state(s.begin(), s.size() - 1);
 }
 
+/// \brief Data that is only accessed by the exploration thread with the same index. It is aligned
+///        to avoid false sharing between the threads.
+template <typename T>
+struct alignas(64) thread_local_data
+{
+  T data;
+};
+
+/// \brief The number of transitions that a thread collects before it writes them to disk.
+constexpr std::size_t transition_batch_size = 1024;
+
 struct lts_builder
 {
-  typedef atermpp::indexed_set<lps::state, atermpp::detail::GlobalThreadSafe> indexed_set_for_states_type;
+  typedef lps::indexed_state_set indexed_set_for_states_type;
   // All LTS classes use integers to represent actions in transitions. A mapping from actions to integers
   // is needed to avoid duplicates.
   utilities::unordered_map_large<lps::multi_action, std::size_t> m_actions;
 
-  lts_builder()
+  // For every thread a cache of the actions it has seen, such that m_actions is only locked for new actions.
+  // Threads are numbered from 1 to n, and 0 is used when there is a single thread. The caches are created by
+  // the main thread, such that the actions in them remain protected when the exploration threads have stopped.
+  std::vector<thread_local_data<atermpp::unordered_map<lps::multi_action, std::size_t>>> m_thread_actions;
+  std::mutex m_exclusive_action_access;
+
+  explicit lts_builder(std::size_t number_of_threads = 1)
+    : m_thread_actions(number_of_threads + 1)
   {
     lps::multi_action tau(process::action_list(), data::undefined_real());
     m_actions.emplace(std::make_pair(tau, m_actions.size()));
@@ -51,11 +71,35 @@ struct lts_builder
     return i->second;
   }
 
-  // Add a transition to the LTS
-  virtual void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads = 0) = 0;
+  /// \brief Returns the label of the action, where the given thread only locks the shared mapping
+  ///        of actions for actions that it has not seen before.
+  std::size_t add_action(const lps::multi_action& a, const std::size_t number_of_threads, const std::size_t thread_index)
+  {
+    assert(thread_index < m_thread_actions.size());
+    auto& cache = m_thread_actions[thread_index].data;
+    auto i = cache.find(a);
+    if (i == cache.end())
+    {
+      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1) m_exclusive_action_access.lock();
+      std::size_t label = add_action(a);
+      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1) m_exclusive_action_access.unlock();
+      i = cache.emplace(a, label).first;
+    }
+    return i->second;
+  }
+
+  // Add a transition to the LTS. The thread index is only relevant when number_of_threads is larger than one.
+  virtual void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads = 0, const std::size_t thread_index = 0) = 0;
 
   // Add actions and states to the LTS
-  virtual void finalize(const indexed_set_for_states_type& state_map, bool timed) = 0;
+  void finalize(const indexed_set_for_states_type& state_map, bool timed)
+  {
+    finalize(state_map.size(), [&](std::size_t i) { return state_map[i]; }, timed);
+  }
+
+  // Add actions and states to the LTS, where state(i) returns the state with index i. The function state
+  // is called for increasing values of i, such that the states can also be read from disk.
+  virtual void finalize(std::size_t number_of_states, const std::function<lps::state(std::size_t)>& state, bool timed) = 0;
 
   // Save the LTS to a file
   virtual void save(const std::string& filename) = 0;
@@ -63,13 +107,27 @@ struct lts_builder
   virtual ~lts_builder() = default;
 };
 
+/// \brief Adds the transitions collected by the threads to the LTS, and releases their memory.
+template <typename LTS>
+void add_thread_transitions(LTS& lts, std::vector<thread_local_data<std::vector<transition>>>& thread_transitions)
+{
+  for (auto& transitions: thread_transitions)
+  {
+    for (const transition& t: transitions.data)
+    {
+      lts.add_transition(t);
+    }
+    std::vector<transition>().swap(transitions.data);
+  }
+}
+
 class lts_none_builder: public lts_builder
 {
   public:
-    void add_transition(std::size_t /* from */, const lps::multi_action& /* a */, std::size_t /* to */, const std::size_t /* number_of_threads */) override
+    void add_transition(std::size_t /* from */, const lps::multi_action& /* a */, std::size_t /* to */, const std::size_t /* number_of_threads */, const std::size_t /* thread_index */) override
     {}
 
-    void finalize(const indexed_set_for_states_type& /* state_map */, bool /* timed */) override
+    void finalize(std::size_t /* number_of_states */, const std::function<lps::state(std::size_t)>& /* state */, bool /* timed */) override
     {}
 
     void save(const std::string& /* filename */) override
@@ -80,22 +138,34 @@ class lts_aut_builder: public lts_builder
 {
   protected:
     lts_aut_t m_lts;
-    std::mutex m_exclusive_transition_access;
+
+    // With multiple threads every thread collects its transitions, which are added to the LTS in finalize.
+    std::vector<thread_local_data<std::vector<transition>>> m_thread_transitions;
 
   public:
-    lts_aut_builder() = default;
+    explicit lts_aut_builder(std::size_t number_of_threads = 1)
+      : lts_builder(number_of_threads),
+        m_thread_transitions(number_of_threads + 1)
+    {}
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads, const std::size_t thread_index) override
     {
-      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1) m_exclusive_transition_access.lock();
-      std::size_t label = add_action(a);
-      m_lts.add_transition(transition(from, label, to));
-      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1) m_exclusive_transition_access.unlock();
+      std::size_t label = add_action(a, number_of_threads, thread_index);
+      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1)
+      {
+        m_thread_transitions[thread_index].data.emplace_back(from, label, to);
+      }
+      else
+      {
+        m_lts.add_transition(transition(from, label, to));
+      }
     }
 
     // Add actions and states to the LTS
-    void finalize(const indexed_set_for_states_type& state_map, bool /* timed */) override
+    void finalize(std::size_t number_of_states, const std::function<lps::state(std::size_t)>& /* state */, bool /* timed */) override
     {
+      add_thread_transitions(m_lts, m_thread_transitions);
+
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
       for (const auto& p: m_actions)
@@ -103,7 +173,9 @@ class lts_aut_builder: public lts_builder
         m_lts.set_action_label(p.second, action_label_string(lps::pp(p.first)));
       }
 
-      m_lts.set_num_states(state_map.size());
+      m_lts.set_num_states(number_of_states);
+      // The default constructor of an lts leaves the initial state undefined.
+      m_lts.set_initial_state(0);
     }
 
     void save(const std::string& filename) override
@@ -120,8 +192,26 @@ class lts_aut_disk_builder: public lts_builder
     std::size_t m_transition_count = 0;
     std::mutex m_exclusive_transition_access;
 
+    // With multiple threads every thread formats its transitions in a buffer, which is written in batches.
+    struct transition_buffer
+    {
+      std::string text;
+      std::size_t size = 0;
+    };
+    std::vector<thread_local_data<transition_buffer>> m_thread_transitions;
+
+    void write(transition_buffer& buffer)
+    {
+      m_transition_count += buffer.size;
+      out << buffer.text;
+      buffer.text.clear();
+      buffer.size = 0;
+    }
+
   public:
-    explicit lts_aut_disk_builder(const std::string& filename)
+    explicit lts_aut_disk_builder(const std::string& filename, std::size_t number_of_threads = 1)
+      : lts_builder(number_of_threads),
+        m_thread_transitions(number_of_threads + 1)
     {
       mCRL2log(log::verbose) << "writing state space in AUT format to '" << filename << "'." << std::endl;
       out.open(filename.c_str());
@@ -133,20 +223,35 @@ class lts_aut_disk_builder: public lts_builder
       out << "des                                                \n"; // write a dummy header that will be overwritten
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads, const std::size_t thread_index) override
     {
-      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1) m_exclusive_transition_access.lock();
-      m_transition_count++;
-      out << "(" << from << ",\"" << lps::pp(a) << "\"," << to << ")\n";
-      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1) m_exclusive_transition_access.unlock();
+      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1)
+      {
+        transition_buffer& buffer = m_thread_transitions[thread_index].data;
+        buffer.text += "(" + std::to_string(from) + ",\"" + lps::pp(a) + "\"," + std::to_string(to) + ")\n";
+        if (++buffer.size == transition_batch_size)
+        {
+          std::lock_guard<std::mutex> guard(m_exclusive_transition_access);
+          write(buffer);
+        }
+      }
+      else
+      {
+        m_transition_count++;
+        out << "(" << from << ",\"" << lps::pp(a) << "\"," << to << ")\n";
+      }
     }
 
     // Add actions and states to the LTS
-    void finalize(const indexed_set_for_states_type& state_map, bool /* timed */) override
+    void finalize(std::size_t number_of_states, const std::function<lps::state(std::size_t)>& /* state */, bool /* timed */) override
     {
+      for (auto& buffer: m_thread_transitions)
+      {
+        write(buffer.data);
+      }
       out.flush();
       out.seekp(0);
-      out << "des (0," << m_transition_count << "," << state_map.size() << ")";
+      out << "des (0," << m_transition_count << "," << number_of_states << ")";
       out.close();
     }
 
@@ -159,33 +264,45 @@ class lts_lts_builder: public lts_builder
   protected:
     lts_lts_t m_lts;
     bool m_discard_state_labels = false;
-    std::mutex m_exclusive_transition_access;
+
+    // With multiple threads every thread collects its transitions, which are added to the LTS in finalize.
+    std::vector<thread_local_data<std::vector<transition>>> m_thread_transitions;
 
   public:
     lts_lts_builder(
       const data::data_specification& dataspec,
       const process::action_label_list& action_labels,
       const data::variable_list& process_parameters,
-      bool discard_state_labels = false
+      bool discard_state_labels = false,
+      std::size_t number_of_threads = 1
     )
-     : m_discard_state_labels(discard_state_labels)
+     : lts_builder(number_of_threads),
+       m_discard_state_labels(discard_state_labels),
+       m_thread_transitions(number_of_threads + 1)
     {
       m_lts.set_data(dataspec);
       m_lts.set_process_parameters(process_parameters);
       m_lts.set_action_label_declarations(action_labels);
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads, const std::size_t thread_index) override
     {
-      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1) m_exclusive_transition_access.lock();
-      std::size_t label = add_action(a);
-      m_lts.add_transition(transition(from, label, to));
-      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1) m_exclusive_transition_access.unlock();
+      std::size_t label = add_action(a, number_of_threads, thread_index);
+      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1)
+      {
+        m_thread_transitions[thread_index].data.emplace_back(from, label, to);
+      }
+      else
+      {
+        m_lts.add_transition(transition(from, label, to));
+      }
     }
 
     // Add actions and states to the LTS
-    void finalize(const indexed_set_for_states_type& state_map, bool timed) override
+    void finalize(std::size_t number_of_states, const std::function<lps::state(std::size_t)>& state, bool timed) override
     {
+      add_thread_transitions(m_lts, m_thread_transitions);
+
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
       for (const auto& p: m_actions)
@@ -196,23 +313,22 @@ class lts_lts_builder: public lts_builder
       // add state labels
       if (!m_discard_state_labels)
       {
-        std::size_t n = state_map.size();
-        std::vector<state_label_lts> state_labels(n);
-        for (std::size_t i = 0; i < n; i++)
+        std::vector<state_label_lts> state_labels(number_of_states);
+        for (std::size_t i = 0; i < number_of_states; i++)
         {
           if (timed)
           {
-            state_labels[i] = state_label_lts(remove_time_stamp(state_map[i]));
+            state_labels[i] = state_label_lts(remove_time_stamp(state(i)));
           }
           else
           {
-            state_labels[i] = state_label_lts(state_map[i]);
+            state_labels[i] = state_label_lts(state(i));
           }
         }
         m_lts.state_labels() = std::move(state_labels);
       }
 
-      m_lts.set_num_states(state_map.size(), true);
+      m_lts.set_num_states(number_of_states, true);
       m_lts.set_initial_state(0);
     }
 
@@ -230,15 +346,37 @@ class lts_lts_disk_builder: public lts_builder
     bool m_discard_state_labels = false;
     std::mutex m_exclusive_transition_access;
 
+    // With multiple threads every thread collects its transitions, which are written in batches. The actions
+    // are kept in an atermpp container, which protects them after the exploration threads have stopped.
+    struct transition_buffer
+    {
+      std::vector<std::pair<std::size_t, std::size_t>> states;
+      atermpp::vector<lps::multi_action> actions;
+    };
+    std::vector<thread_local_data<transition_buffer>> m_thread_transitions;
+
+    void write(transition_buffer& buffer)
+    {
+      for (std::size_t i = 0; i < buffer.states.size(); ++i)
+      {
+        write_transition(*stream, buffer.states[i].first, buffer.actions[i], buffer.states[i].second);
+      }
+      buffer.states.clear();
+      buffer.actions.clear();
+    }
+
   public:
     lts_lts_disk_builder(
       const std::string& filename,
       const data::data_specification& dataspec,
       const process::action_label_list& action_labels,
       const data::variable_list& process_parameters,
-      bool discard_state_labels = false
+      bool discard_state_labels = false,
+      std::size_t number_of_threads = 1
     )
-     : m_discard_state_labels(discard_state_labels)
+     : lts_builder(number_of_threads),
+       m_discard_state_labels(discard_state_labels),
+       m_thread_transitions(number_of_threads + 1)
     {
       fstream.open(filename, std::ofstream::out | std::ofstream::binary);
       if (fstream.fail())
@@ -252,30 +390,48 @@ class lts_lts_disk_builder: public lts_builder
       mcrl2::lts::write_lts_header(*stream, dataspec, process_parameters, action_labels);
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads, const std::size_t thread_index) override
     {
-      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1) m_exclusive_transition_access.lock();
-      write_transition(*stream, from, a, to);
-      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1) m_exclusive_transition_access.unlock();
+      if (atermpp::detail::GlobalThreadSafe && number_of_threads>1)
+      {
+        transition_buffer& buffer = m_thread_transitions[thread_index].data;
+        buffer.states.emplace_back(from, to);
+        buffer.actions.push_back(a);
+        if (buffer.states.size() == transition_batch_size)
+        {
+          std::lock_guard<std::mutex> guard(m_exclusive_transition_access);
+          write(buffer);
+        }
+      }
+      else
+      {
+        write_transition(*stream, from, a, to);
+      }
     }
 
     // Add actions and states to the LTS
-    void finalize(const indexed_set_for_states_type& state_map, bool timed) override
+    void finalize(std::size_t number_of_states, const std::function<lps::state(std::size_t)>& state, bool timed) override
     {
+      for (auto& buffer: m_thread_transitions)
+      {
+        write(buffer.data);
+      }
+
       if (!m_discard_state_labels)
       {
         // Write the state labels in the order of their indices.
-        for (std::size_t i = 0; i < state_map.size(); i++)
+        for (std::size_t i = 0; i < number_of_states; i++)
         {
-          if (is_aterm_balanced_tree(state_map[i]))  // in a parallel context not all positions may be filled.
+          const lps::state s = state(i);
+          if (is_aterm_balanced_tree(s))  // in a parallel context not all positions may be filled.
           {
             if (timed)
             {
-              write_state_label(*stream, state_label_lts(remove_time_stamp(state_map[i])));
+              write_state_label(*stream, state_label_lts(remove_time_stamp(s)));
             }
             else
             {
-              write_state_label(*stream, state_label_lts(state_map[i]));
+              write_state_label(*stream, state_label_lts(s));
             }
           }
         }
@@ -292,8 +448,8 @@ class lts_dot_builder: public lts_lts_builder
 {
   public:
     typedef lts_lts_builder super;
-    lts_dot_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters)
-      : super(dataspec, action_labels, process_parameters)
+    lts_dot_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters, std::size_t number_of_threads = 1)
+      : super(dataspec, action_labels, process_parameters, false, number_of_threads)
     { }
 
     void save(const std::string& filename) override
@@ -308,8 +464,8 @@ class lts_fsm_builder: public lts_lts_builder
 {
   public:
     typedef lts_lts_builder super;
-    lts_fsm_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters)
-      : super(dataspec, action_labels, process_parameters)
+    lts_fsm_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters, std::size_t number_of_threads = 1)
+      : super(dataspec, action_labels, process_parameters, false, number_of_threads)
     { }
 
     void save(const std::string& filename) override
@@ -329,24 +485,24 @@ std::unique_ptr<lts_builder> create_lts_builder(const lps::specification& lpsspe
     {
       if (options.save_at_end)
       {
-        return std::make_unique<lts_aut_builder>();
+        return std::make_unique<lts_aut_builder>(options.number_of_threads);
       }
       else
       {
-        return std::make_unique<lts_aut_disk_builder>(output_filename);
+        return std::make_unique<lts_aut_disk_builder>(output_filename, options.number_of_threads);
       }
     }
-    case lts_dot: return std::make_unique<lts_dot_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
-    case lts_fsm: return std::make_unique<lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
+    case lts_dot: return std::make_unique<lts_dot_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.number_of_threads);
+    case lts_fsm: return std::make_unique<lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.number_of_threads);
     case lts_lts:
     {
       if (options.save_at_end)
       {
-        return std::make_unique<lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
+        return std::make_unique<lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels, options.number_of_threads);
       }
       else
       {
-        return std::make_unique<lts_lts_disk_builder>(output_filename, lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
+        return std::make_unique<lts_lts_disk_builder>(output_filename, lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels, options.number_of_threads);
       }
     }
     default: return std::make_unique<lts_none_builder>();
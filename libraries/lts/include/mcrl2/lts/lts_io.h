@@ -23,6 +23,7 @@
 #include "mcrl2/lts/detail/lts_convert.h"
 
 #include "mcrl2/atermpp/aterm_io.h"
+#include "mcrl2/utilities/indexed_set.h"
 
 namespace mcrl2::lts
 {
@@ -320,6 +321,115 @@ void write_state_label(atermpp::aterm_ostream& stream, const state_label_lts& la
 /// \brief Write the initial state to the LTS stream.
 void write_initial_state(atermpp::aterm_ostream& stream, std::size_t index);
 
+// Reading an LTS from disk in a single pass:
+//  read_lts_stream(stream, handler)
+//
+// The handler is called for the header first, and then for the transitions, state labels and the initial state
+// in the order in which they occur in the stream. Nothing is stored, so this can be used by tools that only
+// need a single pass over an LTS that does not fit in memory.
+
+/// \brief The callbacks that are used by read_lts_stream to report the contents of an LTS stream.
+class lts_stream_handler
+{
+  public:
+    typedef probabilistic_lts_lts_t::probabilistic_state_t probabilistic_state_t;
+
+    virtual ~lts_stream_handler() = default;
+
+    /// \brief Called for the header, which precedes all other elements of the stream.
+    virtual void header(const data::data_specification& /* data */,
+                        const data::variable_list& /* parameters */,
+                        const process::action_label_list& /* action_labels */)
+    {}
+
+    /// \brief Called for a transition with a single target state.
+    virtual void transition(std::size_t /* from */, const action_label_lts& /* label */, std::size_t /* to */)
+    {}
+
+    /// \brief Called for a transition to a probabilistic state with more than one element.
+    virtual void probabilistic_transition(std::size_t /* from */, const action_label_lts& /* label */, const probabilistic_state_t& /* to */)
+    {}
+
+    /// \brief Called for the state labels, where the i-th call provides the label of the state with index i.
+    virtual void state_label(const state_label_lts& /* label */)
+    {}
+
+    /// \brief Called for the initial state.
+    virtual void initial_state(const probabilistic_state_t& /* state */)
+    {}
+};
+
+/// \brief Reads an LTS from the given stream and reports its contents to the handler, without storing it.
+void read_lts_stream(atermpp::aterm_istream& stream, lts_stream_handler& handler);
+
+/// \brief Reads an LTS from the given file, or from standard input if the filename is empty, and reports
+///        its contents to the handler, without storing it.
+void read_lts_stream(const std::string& filename, lts_stream_handler& handler);
+
+/// \brief Counts the elements of an LTS stream without storing them. The number of states is one more
+///        than the largest state index that occurs in a transition or in the initial state.
+class lts_stream_counter: public lts_stream_handler
+{
+  protected:
+    void add_state(std::size_t index)
+    {
+      number_of_states = std::max(number_of_states, index + 1);
+    }
+
+    void add_state(const probabilistic_state_t& state)
+    {
+      if (state.size() == 0)
+      {
+        add_state(state.get());
+      }
+      for (const auto& p: state)
+      {
+        add_state(p.state());
+      }
+    }
+
+  public:
+    std::size_t number_of_states = 1;
+    std::size_t number_of_transitions = 0;
+    std::size_t number_of_probabilistic_transitions = 0;
+    std::size_t number_of_state_labels = 0;
+    utilities::indexed_set<action_label_lts> action_labels;
+    probabilistic_state_t initial_probabilistic_state;
+
+    lts_stream_counter()
+    {
+      action_labels.insert(action_label_lts::tau_action());
+    }
+
+    void transition(std::size_t from, const action_label_lts& label, std::size_t to) override
+    {
+      ++number_of_transitions;
+      action_labels.insert(label);
+      add_state(from);
+      add_state(to);
+    }
+
+    void probabilistic_transition(std::size_t from, const action_label_lts& label, const probabilistic_state_t& to) override
+    {
+      ++number_of_transitions;
+      ++number_of_probabilistic_transitions;
+      action_labels.insert(label);
+      add_state(from);
+      add_state(to);
+    }
+
+    void state_label(const state_label_lts&) override
+    {
+      ++number_of_state_labels;
+    }
+
+    void initial_state(const probabilistic_state_t& state) override
+    {
+      initial_probabilistic_state = state;
+      add_state(state);
+    }
+};
+
 } // namespace mcrl2::lts
 
 #endif // MCRL2_LTS_LTS_IO_H
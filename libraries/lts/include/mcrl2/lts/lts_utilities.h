@@ -168,7 +168,8 @@ class indexed_sorted_vector_for_transitions
 
 //
 /// \brief Type for exploring transitions per state.
-typedef std::pair<transition::size_type, transition::size_type> outgoing_pair_t;
+/// \details The label and target state are stored like the elements of a transition.
+typedef std::pair<transition::storage_type, transition::storage_type> outgoing_pair_t;
 
 typedef detail::indexed_sorted_vector_for_transitions < outgoing_pair_t > outgoing_transitions_per_state_t;
 
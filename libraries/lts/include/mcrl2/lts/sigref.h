@@ -14,15 +14,73 @@
 #ifndef MCRL2_LTS_SIGREF_H
 #define MCRL2_LTS_SIGREF_H
 
+#include <thread>
+
 #include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/utilities/hash_utility.h"
+#include "mcrl2/utilities/indexed_set.h"
 
 namespace mcrl2
 {
 namespace lts
 {
 
-/** \brief A signature is a pair of an action label and a block */
-typedef std::set<std::pair<std::size_t, std::size_t> > signature_t;
+/** \brief A signature is a sorted vector of pairs of an action label and a block, without duplicates */
+typedef std::vector<std::pair<std::size_t, std::size_t> > signature_t;
+
+namespace detail
+{
+
+/** \brief Hash function for signatures */
+struct signature_hash
+{
+  std::size_t operator()(const signature_t& sig) const
+  {
+    std::size_t hash = sig.size();
+    for (const std::pair<std::size_t, std::size_t>& p: sig)
+    {
+      hash = utilities::detail::hash_combine(hash, utilities::detail::hash_combine(p.first, p.second));
+    }
+    return hash;
+  }
+};
+
+/** \brief Sorts the signature and removes duplicate pairs */
+inline void normalise_signature(signature_t& sig)
+{
+  std::sort(sig.begin(), sig.end());
+  sig.erase(std::unique(sig.begin(), sig.end()), sig.end());
+}
+
+/** \brief Calls f(thread_index, first, last) for number_of_threads consecutive parts [first, last) of [0, n).
+  * \details As for indexed_set, the threads are numbered from 1 upwards, or the single thread gets number 0.
+  */
+template <typename Function>
+void sigref_parallel_for(std::size_t n, std::size_t number_of_threads, Function f)
+{
+  if (number_of_threads <= 1)
+  {
+    f(0, 0, n);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads);
+  for (std::size_t i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back([&f, i, n, number_of_threads]() { f(i + 1, (n * i) / number_of_threads, (n * (i + 1)) / number_of_threads); });
+  }
+  for (std::thread& t: threads)
+  {
+    t.join();
+  }
+}
+
+/** \brief Levels with fewer states than this are handled by the calling thread, as starting threads costs more
+  *        than it gains for them. */
+constexpr std::size_t sigref_minimal_parallel_level_size = 1024;
+
+} // namespace detail
 
 /** \brief Base class for signature computation */
 template < class LTS_T >
@@ -35,11 +93,48 @@ protected:
   /** \brief Signature stored per state */
   std::vector<signature_t> m_sig;
 
+  /** \brief The outgoing transitions per state */
+  outgoing_transitions_per_state_t m_next_transitions;
+
+  /** \brief The number of threads that is used to compute the signatures */
+  std::size_t m_number_of_threads;
+
+  /** \brief Compute, for each state s, the signature that consists of the pairs (a, partition[t]) for the
+    *        transitions s -a-> t for which include(s, a, t) holds, where a is the label after hiding.
+    * \details The states are divided over the threads, and every thread only writes the signatures of its own states.
+    */
+  template <typename Include>
+  void compute_direct_signatures(const std::vector<std::size_t>& partition, Include include)
+  {
+    m_sig.resize(m_lts.num_states());
+    detail::sigref_parallel_for(m_lts.num_states(), m_number_of_threads, [&](std::size_t, std::size_t first, std::size_t last)
+      {
+        for (std::size_t s = first; s < last; ++s)
+        {
+          signature_t& sig = m_sig[s];
+          sig.clear();
+          for (std::size_t i = m_next_transitions.lowerbound(s); i < m_next_transitions.upperbound(s); ++i)
+          {
+            const outgoing_pair_t& p = m_next_transitions.get_transitions()[i];
+            const std::size_t a = m_lts.apply_hidden_label_map(label(p));
+            if (include(s, a, to(p)))
+            {
+              sig.emplace_back(a, partition[to(p)]);
+            }
+          }
+          detail::normalise_signature(sig);
+        }
+      });
+  }
+
 public:
   /** \brief Constructor
     */
-  signature(const LTS_T& lts_)
-    : m_lts(lts_), m_sig(m_lts.num_states(), signature_t())
+  signature(const LTS_T& lts_, std::size_t number_of_threads = 1)
+    : m_lts(lts_),
+      m_sig(m_lts.num_states(), signature_t()),
+      m_next_transitions(lts_.get_transitions(), lts_.num_states(), true),
+      m_number_of_threads(number_of_threads)
   {}
 
   /** \brief Compute a new signature based on \a partition.
@@ -74,13 +169,12 @@ template < class LTS_T >
 class signature_bisim: public signature<LTS_T>
 {
 protected:
-  using signature<LTS_T>::m_lts;
-  using signature<LTS_T>::m_sig;
+  using signature<LTS_T>::compute_direct_signatures;
 
 public:
   /** \brief Constructor */
-  signature_bisim(const LTS_T& lts_)
-    : signature<LTS_T>(lts_)
+  signature_bisim(const LTS_T& lts_, std::size_t number_of_threads = 1)
+    : signature<LTS_T>(lts_, number_of_threads)
   {
     mCRL2log(log::verbose, "sigref") << "initialising signature computation for strong bisimulation" << std::endl;
   }
@@ -89,12 +183,7 @@ public:
   virtual void
   compute_signature(const std::vector<std::size_t>& partition)
   {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      m_sig[i->from()].insert(std::make_pair(m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
-    }
+    compute_direct_signatures(partition, [](std::size_t, std::size_t, std::size_t) { return true; });
   }
 
 };
@@ -106,64 +195,242 @@ class signature_branching_bisim: public signature<LTS_T>
 protected:
   using signature<LTS_T>::m_lts;
   using signature<LTS_T>::m_sig;
+  using signature<LTS_T>::m_next_transitions;
+  using signature<LTS_T>::m_number_of_threads;
+
+  /** \brief The states ordered by level, where the level of a state is the length of the longest path of tau
+             transitions from it that ignores tau loops on a single state */
+  std::vector<std::size_t> m_level_states;
+
+  /** \brief The positions in m_level_states at which the levels start, followed by the number of states. This
+             vector is empty if the levels are not used. */
+  std::vector<std::size_t> m_level_begin;
+
+  /** \brief Returns whether s -a-> t is an inert tau transition, where a is the label after hiding */
+  bool is_inert(const std::vector<std::size_t>& partition, const std::size_t s, const std::size_t a, const std::size_t t) const
+  {
+    return m_lts.is_tau(a) && partition[s] == partition[t];
+  }
+
+  /** \brief Orders the states by level, such that inert transitions only lead to states of a lower level.
+    * \details Inert transitions are tau transitions, so the order remains valid when the partition is refined. It
+    *          only exists if the tau transitions do not form cycles other than tau loops on a single state, which
+    *          is the case after the tau cycles have been contracted. Otherwise m_level_begin remains empty.
+    */
+  void compute_tau_levels()
+  {
+    const std::size_t n = m_lts.num_states();
+    const outgoing_transitions_per_state_t incoming(m_lts.get_transitions(), n, false);
+
+    // The number of tau transitions of each state to states that have not been assigned a level yet.
+    std::vector<std::size_t> remaining(n, 0);
+    for (const transition& t: m_lts.get_transitions())
+    {
+      if (t.from() != t.to() && m_lts.is_tau(m_lts.apply_hidden_label_map(t.label())))
+      {
+        ++remaining[t.from()];
+      }
+    }
 
-  /** \brief Store the incoming transitions per state */
-  outgoing_transitions_per_state_t m_prev_transitions;
+    m_level_states.clear();
+    m_level_states.reserve(n);
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      if (remaining[s] == 0)
+      {
+        m_level_states.push_back(s);
+      }
+    }
+
+    std::vector<std::size_t> level_begin(1, 0);
+    for (std::size_t first = 0; first < m_level_states.size(); first = level_begin.back())
+    {
+      const std::size_t last = m_level_states.size();
+      for (std::size_t i = first; i < last; ++i)
+      {
+        const std::size_t t = m_level_states[i];
+        for (std::size_t j = incoming.lowerbound(t); j < incoming.upperbound(t); ++j)
+        {
+          // For incoming transitions, to(p) is the source state of the transition.
+          const outgoing_pair_t& p = incoming.get_transitions()[j];
+          if (to(p) != t && m_lts.is_tau(m_lts.apply_hidden_label_map(label(p))) && --remaining[to(p)] == 0)
+          {
+            m_level_states.push_back(to(p));
+          }
+        }
+      }
+      level_begin.push_back(last);
+    }
 
-  /** \brief Insert function
+    if (m_level_states.size() == n)
+    {
+      mCRL2log(log::verbose, "sigref") << "computing the inert signatures in parallel for " << level_begin.size() - 1 << " levels" << std::endl;
+      m_level_begin.swap(level_begin);
+    }
+    else
+    {
+      mCRL2log(log::verbose, "sigref") << "the LTS contains tau cycles, so the inert signatures are computed sequentially" << std::endl;
+      m_level_states.clear();
+    }
+  }
+
+  /** \brief Adds the signature of every state that is reachable via inert tau transitions to the signature of a state.
     * \param[in] partition The current partition
-    * \param[in] t source state
-    * \param[in] label_ transition label
-    * \param[in] block target block
     *
-    * Insert function as described in S. Blom, S. Orzan,
+    * This corresponds to the insert function as described in S. Blom, S. Orzan,
     * "Distributed Branching Bisimulation Reduction of State Spaces",
     * Proc. PDMC 2003.
     *
-    * Inserts the pair (label_, block) in the signature of t, as well as
-    * the signatures of all tau-predecessors of t within the same block.
+    * All states in a strongly connected component of inert tau transitions obtain the same signature. Tarjan's
+    * algorithm finds these components in reverse topological order, so when a component is found the signatures
+    * of the components that it can reach are already complete.
+    *
+    * If the states have been ordered by level, the levels are processed from the lowest upwards instead, and the
+    * states of one level are divided over the threads.
     */
-  void insert(const std::vector<std::size_t>& partition, const std::size_t t, const std::size_t label_, const std::size_t block)
+  void add_inert_signatures(const std::vector<std::size_t>& partition)
   {
-    if(m_sig[t].insert(std::make_pair(label_, block)).second)
+    if (!m_level_begin.empty())
+    {
+      for (std::size_t level = 0; level + 1 < m_level_begin.size(); ++level)
+      {
+        const std::vector<std::size_t>::const_iterator first = m_level_states.begin() + m_level_begin[level];
+        const std::size_t size = m_level_begin[level + 1] - m_level_begin[level];
+        detail::sigref_parallel_for(size, size < detail::sigref_minimal_parallel_level_size ? 1 : m_number_of_threads,
+          [&](std::size_t, std::size_t begin, std::size_t end)
+          {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+              complete_component(partition, first + i, first + i + 1);
+            }
+          });
+      }
+      return;
+    }
+
+    const std::size_t n = m_lts.num_states();
+    std::vector<std::size_t> index(n, 0);  // 0 means that the state has not been visited.
+    std::vector<std::size_t> low(n, 0);
+    std::vector<bool> on_stack(n, false);
+    std::vector<std::size_t> scc_stack;
+    std::vector<std::pair<std::size_t, std::size_t> > dfs_stack; // A state and the next outgoing transition to consider.
+    std::size_t next_index = 1;
+
+    auto visit = [&](const std::size_t s)
     {
-      // std::pair<outgoing_transitions_per_state_t::const_iterator, outgoing_transitions_per_state_t::const_iterator> pred_range
-      //    = m_prev_transitions.equal_range(t);
+      index[s] = next_index;
+      low[s] = next_index++;
+      scc_stack.push_back(s);
+      on_stack[s] = true;
+      dfs_stack.emplace_back(s, m_next_transitions.lowerbound(s));
+    };
+
+    for (std::size_t root = 0; root < n; ++root)
+    {
+      if (index[root] != 0)
+      {
+        continue;
+      }
 
-      // for(outgoing_transitions_per_state_t::const_iterator i = pred_range.first; i != pred_range.second; ++i)
-      // for(const outgoing_pair_t& p: m_prev_transitions[t])
-      for (std::size_t i=m_prev_transitions.lowerbound(t); i<m_prev_transitions.upperbound(t); ++i)
+      visit(root);
+      while (!dfs_stack.empty())
       {
-        const outgoing_pair_t& p = m_prev_transitions.get_transitions()[i];
-        if(m_lts.is_tau(m_lts.apply_hidden_label_map(label(p))) && partition[t] == partition[to(p)])
+        const std::size_t s = dfs_stack.back().first;
+        const std::size_t i = dfs_stack.back().second;
+        if (i < m_next_transitions.upperbound(s))
+        {
+          dfs_stack.back().second++;
+          const outgoing_pair_t& p = m_next_transitions.get_transitions()[i];
+          if (is_inert(partition, s, m_lts.apply_hidden_label_map(label(p)), to(p)))
+          {
+            if (index[to(p)] == 0)
+            {
+              visit(to(p));
+            }
+            else if (on_stack[to(p)])
+            {
+              low[s] = std::min(low[s], index[to(p)]);
+            }
+          }
+        }
+        else
         {
-          insert(partition, to(p), label_, block);
+          dfs_stack.pop_back();
+          if (!dfs_stack.empty())
+          {
+            low[dfs_stack.back().first] = std::min(low[dfs_stack.back().first], low[s]);
+          }
+
+          if (low[s] == index[s])
+          {
+            // The states on the scc_stack from s upwards form a component.
+            const std::size_t first = std::find(scc_stack.rbegin(), scc_stack.rend(), s).base() - scc_stack.begin() - 1;
+            complete_component(partition, scc_stack.begin() + first, scc_stack.end());
+            for (std::size_t k = first; k < scc_stack.size(); ++k)
+            {
+              on_stack[scc_stack[k]] = false;
+            }
+            scc_stack.resize(first);
+          }
         }
       }
     }
   }
 
+  /** \brief Gives all states in [first, last) the union of their own signatures and those of their inert successors */
+  template <typename Iterator>
+  void complete_component(const std::vector<std::size_t>& partition, Iterator first, Iterator last)
+  {
+    signature_t sig;
+    bool has_inert_successors = false;
+    for (Iterator it = first; it != last; ++it)
+    {
+      sig.insert(sig.end(), m_sig[*it].begin(), m_sig[*it].end());
+      for (std::size_t i = m_next_transitions.lowerbound(*it); i < m_next_transitions.upperbound(*it); ++i)
+      {
+        const outgoing_pair_t& p = m_next_transitions.get_transitions()[i];
+        if (is_inert(partition, *it, m_lts.apply_hidden_label_map(label(p)), to(p)))
+        {
+          has_inert_successors = true;
+          sig.insert(sig.end(), m_sig[to(p)].begin(), m_sig[to(p)].end());
+        }
+      }
+    }
+
+    if (!has_inert_successors)
+    {
+      // A single state without inert tau transitions, of which the signature is already complete.
+      return;
+    }
+
+    detail::normalise_signature(sig);
+    for (Iterator it = first; it != last; ++it)
+    {
+      m_sig[*it] = sig;
+    }
+  }
+
 public:
   /** \brief Constructor  */
-  signature_branching_bisim(const LTS_T& lts_)
-    : signature<LTS_T>(lts_),
-      m_prev_transitions(lts_.get_transitions(),lts_.num_states(),false)  // transitions stored backward. 
+  signature_branching_bisim(const LTS_T& lts_, std::size_t number_of_threads = 1)
+    : signature<LTS_T>(lts_, number_of_threads)
   {
     mCRL2log(log::verbose, "sigref") << "initialising signature computation for branching bisimulation" << std::endl;
+    if (number_of_threads > 1)
+    {
+      compute_tau_levels();
+    }
   }
 
-  /** \overload */
+  /** \overload
+    *
+    * The signatures of the non inert transitions are computed in parallel, after which the signatures are
+    * propagated backwards over the inert tau transitions.
+    */
   virtual void compute_signature(const std::vector<std::size_t>& partition)
   {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      if (!(m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())) && (partition[i->from()] == partition[i->to()])))
-      {
-        insert(partition, i->from(), m_lts.apply_hidden_label_map(i->label()), partition[i->to()]);
-      }
-    }
+    this->compute_direct_signatures(partition, [&](std::size_t s, std::size_t a, std::size_t t) { return !is_inert(partition, s, a, t); });
+    add_inert_signatures(partition);
   }
 
   /** \overload */
@@ -186,7 +453,8 @@ class signature_divergence_preserving_branching_bisim: public signature_branchin
 protected:
   using signature_branching_bisim<LTS_T>::m_lts;
   using signature_branching_bisim<LTS_T>::m_sig;
-  using signature_branching_bisim<LTS_T>::insert;
+  using signature_branching_bisim<LTS_T>::is_inert;
+  using signature_branching_bisim<LTS_T>::add_inert_signatures;
 
   /** \brief Record for each vertex whether it is in a tau-scc */
   std::vector<bool> m_divergent;
@@ -295,8 +563,8 @@ public:
     * This initialises \a m_divergent to record for each vertex whether it is
     * in a tau-scc.
     */
-  signature_divergence_preserving_branching_bisim(const LTS_T& lts_)
-    : signature_branching_bisim<LTS_T>(lts_),
+  signature_divergence_preserving_branching_bisim(const LTS_T& lts_, std::size_t number_of_threads = 1)
+    : signature_branching_bisim<LTS_T>(lts_, number_of_threads),
       m_divergent(lts_.num_states(), false)
   {
     mCRL2log(log::verbose, "sigref") << "initialising signature computation for divergence preserving branching bisimulation" << std::endl;
@@ -310,16 +578,8 @@ public:
     */
   virtual void compute_signature(const std::vector<std::size_t>& partition)
   {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      if(!(partition[i->from()] == partition[i->to()] && m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
-         || m_divergent[i->to()])
-      {
-        insert(partition, i->from(), m_lts.apply_hidden_label_map(i->label()), partition[i->to()]);
-      }
-    }
+    this->compute_direct_signatures(partition, [&](std::size_t s, std::size_t a, std::size_t t) { return !is_inert(partition, s, a, t) || m_divergent[t]; });
+    add_inert_signatures(partition);
   }
 
   /** \overload */
@@ -328,7 +588,7 @@ public:
     for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
     {
       if(!(partition[i->from()] == partition[i->to()] && m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
-         || m_sig[i->from()].find(std::make_pair(m_lts.apply_hidden_label_map(i->label()), partition[i->to()])) != m_sig[i->from()].end())
+         || std::binary_search(m_sig[i->from()].begin(), m_sig[i->from()].end(), std::make_pair(m_lts.apply_hidden_label_map(i->label()), partition[i->to()])))
       {
         transitions.insert(transition(partition[i->from()], m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
       }
@@ -364,6 +624,9 @@ protected:
              current equivalence */
   Signature m_signature;
 
+  /** \brief The number of threads that is used to compute and hash the signatures */
+  std::size_t m_number_of_threads;
+
   /** \brief Print a signature (for debugging purposes) */
   std::string print_sig(const signature_t& sig)
   {
@@ -395,22 +658,33 @@ protected:
 
       count_prev = m_count;
 
-      // Map signatures to block numbers
-      std::map<signature_t, std::size_t> hashtable;
+      // Map signatures to indices in a hash table, which is done by all threads concurrently.
+      const std::size_t n = m_lts.num_states();
+      // The number of blocks can only grow, so the previous number is used to size the hash table.
+      mcrl2::utilities::indexed_set<signature_t, true, detail::signature_hash> hashtable(m_number_of_threads, 2 * count_prev);
+      std::vector<std::size_t> signature_index(n);
+      detail::sigref_parallel_for(n, m_number_of_threads, [&](std::size_t thread_index, std::size_t first, std::size_t last)
+        {
+          for (std::size_t i = first; i < last; ++i)
+          {
+            signature_index[i] = hashtable.insert(m_signature.get_signature(i), thread_index).first;
+          }
+        });
+
+      // Map states to block numbers. The blocks are numbered in the order in which they occur, such that the
+      // partition does not depend on the order in which the threads inserted the signatures.
+      const std::size_t undefined_block = std::numeric_limits<std::size_t>::max();
+      std::vector<std::size_t> block(n == 0 ? 0 : *std::max_element(signature_index.begin(), signature_index.end()) + 1, undefined_block);
       m_count = 0;
-      for(std::size_t i = 0; i < m_lts.num_states(); ++i)
+      for(std::size_t i = 0; i < n; ++i)
       {
-        if(hashtable.find(m_signature.get_signature(i)) == hashtable.end())
+        std::size_t& b = block[signature_index[i]];
+        if (b == undefined_block)
         {
           mCRL2log(log::debug, "sigref") << "Adding block for signature " << print_sig(m_signature.get_signature(i)) << std::endl;
-          hashtable[m_signature.get_signature(i)] = m_count++;
+          b = m_count++;
         }
-      }
-
-      // Map states to block numbers
-      for(std::size_t i = 0; i < m_lts.num_states(); ++i)
-      {
-        m_partition[i] = hashtable[m_signature.get_signature(i)];
+        m_partition[i] = b;
       }
 
       ++iterations;
@@ -444,12 +718,14 @@ protected:
 public:
   /** \brief Constructor
     * \param[in] lts_ The LTS that is being reduced
+    * \param[in] number_of_threads The number of threads that is used to compute the signatures
     */
-  sigref(LTS_T& lts_)
+  sigref(LTS_T& lts_, std::size_t number_of_threads = 1)
     : m_partition(std::vector<std::size_t>(lts_.num_states(), 0)),
       m_count(0),
       m_lts(lts_),
-      m_signature(lts_)
+      m_signature(lts_, number_of_threads),
+      m_number_of_threads(number_of_threads)
   {}
 
   /** \brief Perform the reduction, modulo the equivalence for which the
@@ -13,6 +13,7 @@
 #define MCRL2_LTS_STATE_SPACE_GENERATOR_H
 
 #include "mcrl2/lps/explorer.h"
+#include "mcrl2/lts/detail/external_breadth_first_search.h"
 #include "mcrl2/lts/trace.h"
 
 namespace mcrl2::lts 
@@ -684,6 +685,20 @@ struct state_space_generator
   template <typename LTSBuilder>
   void explore(LTSBuilder& builder)
   {
+    if (!options.external_directory.empty())
+    {
+      if constexpr (Stochastic || Timed)
+      {
+        throw mcrl2::runtime_error("State space generation in external memory is not supported for stochastic or timed specifications.");
+      }
+      else
+      {
+        detail::external_breadth_first_search<explorer_type> search(explorer, builder, options.external_directory, options.external_buffer_size);
+        search.run();
+        return;
+      }
+    }
+
     std::vector<aligned_bool> has_outgoing_transitions(options.number_of_threads+1); // thread indices start at 1. 
     const lps::state* source = nullptr;
 
@@ -734,7 +749,7 @@ struct state_space_generator
           }
           else
           {
-            builder.add_transition(s0_index, a, s1_index, number_of_threads);
+            builder.add_transition(s0_index, a, s1_index, number_of_threads, thread_index);
           }
           assert(thread_index<has_outgoing_transitions.size());
           has_outgoing_transitions[thread_index].m_bool = true;
@@ -789,6 +804,7 @@ struct state_space_generator
         }
       );
       m_progress_monitor.finish_exploration(explorer.state_map().size(), options.number_of_threads);
+      explorer.print_cache_statistics();
       builder.finalize(explorer.state_map(), Timed);
     }
     catch (const data::enumerator_error& e)
@@ -17,7 +17,10 @@
 #ifndef MCRL2_LTS_TRANSITION_H
 #define MCRL2_LTS_TRANSITION_H
 
+#include <cassert>
+#include <cstdint>
 #include <functional>
+#include <limits>
 
 namespace mcrl2
 {
@@ -45,10 +48,23 @@ class transition
     /// \brief The type of the elements in a transition.
     typedef std::size_t size_type;
 
+    /// \brief The type in which the elements of a transition are stored.
+    /// \details When the toolset is built with MCRL2_ENABLE_COMPACT_TRANSITIONS, the elements
+    ///          are stored in 32 bits, which halves the size of a transition. An LTS can then have
+    ///          at most max_size states and action labels.
+#ifdef MCRL2_COMPACT_TRANSITIONS
+    typedef std::uint32_t storage_type;
+#else
+    typedef std::size_t storage_type;
+#endif
+
+    /// \brief The largest number of states or action labels of which the indices fit in a transition.
+    static constexpr std::size_t max_size = std::numeric_limits<storage_type>::max();
+
   private:
-    size_type m_from;
-    size_type m_label;
-    size_type m_to;
+    storage_type m_from;
+    storage_type m_label;
+    storage_type m_to;
 
   public:
     // There is no default constructor
@@ -57,8 +73,13 @@ class transition
     /// \brief Constructor (there is no default constructor).
     transition(const std::size_t f,
                const std::size_t l,
-               const std::size_t t):m_from(f),m_label(l),m_to(t)
-    {}
+               const std::size_t t)
+     : m_from(static_cast<storage_type>(f)),
+       m_label(static_cast<storage_type>(l)),
+       m_to(static_cast<storage_type>(t))
+    {
+      assert(f<max_size && l<max_size && t<max_size);
+    }
 
     /// \brief Copy constructor.
     transition(const transition& t) = default;
@@ -96,21 +117,24 @@ class transition
     void
     set_from(const size_type from)
     {
-      m_from = from;
+      assert(from<max_size);
+      m_from = static_cast<storage_type>(from);
     }
 
     /// \brief Set the label of the transition.
     void
     set_label(const size_type label)
     {
-      m_label = label;
+      assert(label<max_size);
+      m_label = static_cast<storage_type>(label);
     }
 
     ///\brief Set the target of the transition.
     void
     set_to(const size_type to)
     {
-      m_to = to;
+      assert(to<max_size);
+      m_to = static_cast<storage_type>(to);
     }
 
     ///\brief Standard equality on transitions.
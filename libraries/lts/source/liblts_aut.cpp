@@ -8,7 +8,14 @@
 //
 /// \file liblts_aut.cpp
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include "mcrl2/utilities/unordered_map.h"
 #include "mcrl2/lts/lts_aut.h"
 #include "mcrl2/lts/detail/liblts_swap_to_from_probabilistic_lts.h"
@@ -16,52 +23,7 @@
 
 using namespace mcrl2::lts;
 
-static void read_newline(std::istream& is, const std::size_t line_no)
-{
-  char ch;
-  is.get(ch);
-
-  // Skip over spaces
-  while (ch == ' ')
-  {
-    is.get(ch);
-  }
-
-  // Windows systems typically have a carriage return before a newline.
-  if (ch == '\r')
-  {
-    is.get(ch);
-  }
-
-  if (ch != '\n' && !is.eof()) // Last line does not need to be terminated with an eoln.
-  {
-    if (line_no==1)
-    {
-      throw mcrl2::runtime_error("Expect a newline after the header des(...,...,...).");
-    }
-    else
-    {
-      throw mcrl2::runtime_error("Expect a newline after the transition at line " + std::to_string(line_no) + ".");
-    }
-  }
-}
-
-// reads a number, puts it in s, and reads one extra character, which must be either a space or a closing bracket.
-static void read_natural_number_to_string(std::istream& is, std::string& s, const std::size_t line_no)
-{
-  assert(s.empty());
-  char ch;
-  is >> std::skipws >> ch;
-  for( ; isdigit(ch) ; is.get(ch))
-  {
-    s.push_back(ch);
-  }
-  is.putback(ch);
-  if (s.empty())
-  {
-    throw mcrl2::runtime_error("Expect a number at line " + std::to_string(line_no) + ".");
-  }
-}
+typedef mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t aut_probabilistic_state;
 
 template <class AUT_LTS_TYPE>
 static std::size_t find_label_index(const std::string& s, mcrl2::utilities::unordered_map < action_label_string, std::size_t >& labs, AUT_LTS_TYPE& l)
@@ -92,387 +54,683 @@ static void check_state(std::size_t state, std::size_t number_of_states, std::si
   }
 } 
 
-static void check_states(mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& probability_state,
-                         std::size_t number_of_states, std::size_t line_no)
+// A probabilistic state with more than one state, as it occurs in the input. Typical input is
+// 3 2/3 4 1/6 78, where state 78 gets the remaining probability 1/6. The probabilities are kept
+// as text, as the arithmetic on probabilities cannot be done by several threads at the same time.
+struct aut_probabilistic_target
+{
+  std::vector<std::size_t> states;
+  std::vector<std::pair<std::string, std::string> > probabilities;
+};
+
+static void make_probabilistic_state(const aut_probabilistic_target& target, aut_probabilistic_state& result)
 {
-  for(mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t::state_probability_pair& p: probability_state)
+  assert(result.size()==0 && target.states.size()==target.probabilities.size()+1);
+  mcrl2::lts::probabilistic_arbitrary_precision_fraction remainder=mcrl2::lts::probabilistic_arbitrary_precision_fraction::one();
+  for (std::size_t i=0; i<target.probabilities.size(); ++i)
   {
-    check_state(p.state(), number_of_states, line_no);
+    mcrl2::lts::probabilistic_arbitrary_precision_fraction frac(target.probabilities[i].first,target.probabilities[i].second);
+    remainder=remainder-frac;
+    result.add(target.states[i], frac);
   }
-} 
+  result.add(target.states.back(), remainder);
+}
 
-// This procedure tries to read states, indicated by numbers
-// with in between fractions of the shape number/number. The
-// last state number is put in state. The remainder as pairs
-// in the vector. Typical expected input is 3 2/3 4 1/6 78 1/6 3.
-static void read_probabilistic_state(
-  std::istream& is,
-  mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& result,
-  const std::size_t line_no)
+// A scanner for an .aut file that has been read into memory.
+class aut_scanner
 {
-  assert(result.size()==0);
+  protected:
+    const char* m_position;
+    const char* m_end;
+    std::size_t m_line_no;
+    std::size_t m_transition_line_no;
 
-  std::size_t state;
-
-  is >> std::skipws >> state;
+    static bool is_whitespace(const char ch)
+    {
+      return ch==' ' || ch=='\n' || ch=='\r' || ch=='\t' || ch=='\v' || ch=='\f';
+    }
 
-  if (!is.good())
-  {
-    throw mcrl2::runtime_error("Expect a state number at line " + std::to_string(line_no) + ".");
-  }
+    void skip_whitespace()
+    {
+      for( ; m_position!=m_end && is_whitespace(*m_position); ++m_position)
+      {
+        if (*m_position=='\n')
+        {
+          m_line_no++;
+        }
+      }
+    }
 
-  // Check whether the next character is a digit. If so a probability follows.
-  char ch;
-  is >> std::skipws >> ch;
-  is.putback(ch);
+    // Skips whitespace and returns the next character, or 0 at the end of the input.
+    char next_character()
+    {
+      skip_whitespace();
+      if (m_position==m_end)
+      {
+        return 0;
+      }
+      return *m_position++;
+    }
 
-  if (!isdigit(ch))
-  {
-    // There is only a single state.
-    result.set(state);
-    return;
-  }
-  bool ready=false;
+    bool next_is_digit()
+    {
+      skip_whitespace();
+      return m_position!=m_end && isdigit(*m_position);
+    }
 
-  mcrl2::lts::probabilistic_arbitrary_precision_fraction remainder=mcrl2::lts::probabilistic_arbitrary_precision_fraction::one();
-  while (is.good() && !ready)
-  {
-    // Now read a probabilities followed by the next state.
-    std::string enumerator;
-    read_natural_number_to_string(is,enumerator,line_no);
-    char ch;
-    is >> std::skipws >> ch;
-    if (ch != '/')
+    void expect(const char expected, const char* message)
     {
-      throw mcrl2::runtime_error("Expect a / in a probability at line " + std::to_string(line_no) + ".");
+      if (next_character()!=expected)
+      {
+        throw mcrl2::runtime_error(std::string(message) + " at line " + std::to_string(m_transition_line_no) + ".");
+      }
     }
 
-    std::string denominator;
-    read_natural_number_to_string(is,denominator,line_no);
-    mcrl2::lts::probabilistic_arbitrary_precision_fraction frac(enumerator,denominator);
-    remainder=remainder-frac;
-    result.add(state, frac);
-    
-    is >> std::skipws >> state;
+    std::string_view read_digits(const char* message)
+    {
+      skip_whitespace();
+      const char* first=m_position;
+      for( ; m_position!=m_end && isdigit(*m_position); ++m_position) {}
+      if (m_position==first)
+      {
+        throw mcrl2::runtime_error(std::string(message) + " at line " + std::to_string(m_transition_line_no) + ".");
+      }
+      return std::string_view(first,m_position-first);
+    }
 
-    if (!is.good())
+    std::size_t read_number(const char* message)
     {
-      throw mcrl2::runtime_error("Expect a state number at line " + std::to_string(line_no) + ".");
+      const std::string_view digits=read_digits(message);
+      // At most 19 digits are accepted, such that the number cannot overflow.
+      if (digits.size()>19)
+      {
+        throw mcrl2::runtime_error(std::string(message) + " at line " + std::to_string(m_transition_line_no) + ".");
+      }
+      std::size_t result=0;
+      for (const char ch: digits)
+      {
+        result=10*result+(ch-'0');
+      }
+      return result;
     }
 
-    // Check whether the next character is a digit.
-    
-    is >> std::skipws >> ch;
-    is.putback(ch);
+    void read_newline()
+    {
+      for( ; m_position!=m_end && *m_position==' '; ++m_position) {}
 
-    if (!isdigit(ch))
+      // Windows systems typically have a carriage return before a newline.
+      if (m_position!=m_end && *m_position=='\r')
+      {
+        ++m_position;
+      }
+
+      if (m_position!=m_end) // Last line does not need to be terminated with an eoln.
+      {
+        if (*m_position!='\n')
+        {
+          if (m_transition_line_no==1)
+          {
+            throw mcrl2::runtime_error("Expect a newline after the header des(...,...,...).");
+          }
+          throw mcrl2::runtime_error("Expect a newline after the transition at line " + std::to_string(m_transition_line_no) + ".");
+        }
+        ++m_position;
+        m_line_no++;
+      }
+    }
+
+    // Reads a state, followed by the probabilities and states of a probabilistic state, if any.
+    // If target is a nullptr, only a single state is accepted.
+    std::size_t read_target_state(aut_probabilistic_target* target)
     {
-      ready=true;
+      const std::size_t state=read_number("Expect a state number");
+      if (target==nullptr)
+      {
+        return state;
+      }
+      target->states.clear();
+      target->probabilities.clear();
+      if (next_is_digit())
+      {
+        target->states.push_back(state);
+        do
+        {
+          const std::string_view numerator=read_digits("Expect a number");
+          expect('/', "Expect a / in a probability");
+          const std::string_view denominator=read_digits("Expect a number");
+          target->probabilities.emplace_back(numerator,denominator);
+          target->states.push_back(read_number("Expect a state number"));
+        }
+        while (next_is_digit());
+      }
+      return state;
     }
-  }
-  
-  result.add(state, remainder);
-}
 
+  public:
+    aut_scanner(const char* first, const char* last, const std::size_t line_no)
+      : m_position(first),
+        m_end(last),
+        m_line_no(line_no),
+        m_transition_line_no(line_no)
+    {}
 
-static void read_aut_header(
-  std::istream& is,
-  mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& initial_state,
-  std::size_t& num_transitions,
-  std::size_t& num_states)
-{
-  std::string s;
-  is.width(3);
-  is >> std::skipws >> s;
+    const char* position() const
+    {
+      return m_position;
+    }
 
-  if (s!="des")
-  {
-    throw mcrl2::runtime_error("Expect an .aut file to start with 'des'.");
-  }
+    /// \brief The line at which the last transition that has been read starts.
+    std::size_t transition_line_no() const
+    {
+      return m_transition_line_no;
+    }
+
+    // Reads the header. If the initial state is probabilistic, initial_target contains its states.
+    std::size_t read_header(aut_probabilistic_target& initial_target, std::size_t& num_transitions, std::size_t& num_states)
+    {
+      skip_whitespace();
+      if (m_end-m_position<3 || std::string_view(m_position,3)!="des")
+      {
+        throw mcrl2::runtime_error("Expect an .aut file to start with 'des'.");
+      }
+      m_position+=3;
+      if (next_character()!='(')
+      {
+        throw mcrl2::runtime_error("Expect an opening bracket '(' after 'des' in the first line of a .aut file.");
+      }
+      const std::size_t initial_state=read_target_state(&initial_target);
+      if (next_character()!=',')
+      {
+        throw mcrl2::runtime_error("Expect a comma after the first number in the first line of a .aut file.");
+      }
+      num_transitions=read_number("Expect the number of transitions");
+      if (next_character()!=',')
+      {
+        throw mcrl2::runtime_error("Expect a comma after the second number in the first line of a .aut file.");
+      }
+      num_states=read_number("Expect the number of states");
+      if (next_character()!=')')
+      {
+        throw mcrl2::runtime_error("Expect a closing bracket ')' after the third number in the first line of a .aut file.");
+      }
+      read_newline();
+      return initial_state;
+    }
 
-  char ch;
-  is >> std::skipws >> ch;
+    // Reads a transition. A label that occurs in the input without whitespace is returned as a
+    // view on the input. Otherwise, the whitespace is removed in label_buffer, to which label refers.
+    // If target is not a nullptr, the target may be a probabilistic state, which is put in target.
+    bool read_transition(std::size_t& from, std::string_view& label, std::string& label_buffer, std::size_t& to,
+                         aut_probabilistic_target* target)
+    {
+      skip_whitespace();
+      if (m_position==m_end)
+      {
+        return false;
+      }
+      m_transition_line_no=m_line_no;
+      if (*m_position++!='(')
+      {
+        throw mcrl2::runtime_error("Expect an opening bracket at the start of the transition at line " + std::to_string(m_transition_line_no) + ".");
+      }
 
-  if (ch != '(')
-  {
-    throw mcrl2::runtime_error("Expect an opening bracket '(' after 'des' in the first line of a .aut file.");
-  }
+      from=read_number("Expect a state number");
+      expect(',', "Expect that the first number is followed by a comma");
 
-  read_probabilistic_state(is,initial_state,1);
+      skip_whitespace();
+      if (m_position!=m_end && *m_position=='"')
+      {
+        // In case the label is using quotes whitespaces
+        // in the label are preserved.
+        const char* first=++m_position;
+        m_position=static_cast<const char*>(std::memchr(first,'"',m_end-first));
+        if (m_position==nullptr)
+        {
+          throw mcrl2::runtime_error("Expect that the second item is a quoted label (using \") at line " + std::to_string(m_transition_line_no) + ".");
+        }
+        label=std::string_view(first,m_position-first);
+        m_line_no+=std::count(first,m_position,'\n');
+        ++m_position;
+        expect(',', "Expect a comma after the quoted label");
+      }
+      else
+      {
+        // In case the label is not within quotes,
+        // whitespaces are removed from the label.
+        const char* first=m_position;
+        const char* last=static_cast<const char*>(std::memchr(first,',',m_end-first));
+        if (last==nullptr)
+        {
+          throw mcrl2::runtime_error("Expect a comma after the quoted label at line " + std::to_string(m_transition_line_no) + ".");
+        }
+        if (std::find_if(first,last,is_whitespace)==last)
+        {
+          label=std::string_view(first,last-first);
+        }
+        else
+        {
+          label_buffer.clear();
+          std::copy_if(first,last,std::back_inserter(label_buffer),[](const char c){ return !is_whitespace(c); });
+          label=label_buffer;
+          m_line_no+=std::count(first,last,'\n');
+        }
+        m_position=last+1;
+      }
 
-  is >> std::skipws >> ch;
-  if (ch != ',')
-  {
-    throw mcrl2::runtime_error("Expect a comma after the first number in the first line of a .aut file.");
-  }
+      to=read_target_state(target);
+      expect(')', "Expect a closing bracket at the end of the transition");
+      read_newline();
+      return true;
+    }
+};
 
-  is >> std::skipws >> num_transitions;
+// The transitions in a part of an .aut file. The label of each transition is the index of its label
+// in labels, which contains the labels in the order in which they first occur in this part. The
+// target of the transitions in probabilistic_transitions is an index in probabilistic_targets.
+struct aut_chunk
+{
+  const char* first;
+  const char* last;
+  std::vector<transition> transitions;
+  std::vector<std::string> labels;
+  std::vector<std::size_t> probabilistic_transitions;
+  std::vector<aut_probabilistic_target> probabilistic_targets;
+  std::exception_ptr error;
+};
+
+static void read_aut_chunk(aut_chunk& chunk, const bool probabilistic, const std::size_t number_of_states, const std::size_t line_no)
+{
+  aut_scanner scanner(chunk.first,chunk.last,line_no);
+  std::unordered_map<std::string_view, std::size_t> label_indices;
+  std::deque<std::string> labels_without_whitespace; // Keeps the labels that are not a view on the input.
+  std::string label_buffer;
+  aut_probabilistic_target target;
 
-  is >> std::skipws >> ch;
-  if (ch != ',')
+  std::size_t from, to;
+  std::string_view label;
+  while (scanner.read_transition(from,label,label_buffer,to,probabilistic?&target:nullptr))
   {
-    throw mcrl2::runtime_error("Expect a comma after the second number in the first line of a .aut file.");
+    check_state(from, number_of_states, scanner.transition_line_no());
+    check_state(to, number_of_states, scanner.transition_line_no());
+    auto i=label_indices.find(label);
+    if (i==label_indices.end())
+    {
+      if (label.data()==label_buffer.data())
+      {
+        labels_without_whitespace.push_back(label_buffer);
+        label=labels_without_whitespace.back();
+      }
+      i=label_indices.emplace(label,chunk.labels.size()).first;
+      chunk.labels.emplace_back(label);
+    }
+    if (probabilistic && !target.states.empty())
+    {
+      for (const std::size_t s: target.states)
+      {
+        check_state(s, number_of_states, scanner.transition_line_no());
+      }
+      to=chunk.probabilistic_targets.size();
+      chunk.probabilistic_targets.push_back(target);
+      chunk.probabilistic_transitions.push_back(chunk.transitions.size());
+    }
+    chunk.transitions.emplace_back(from,i->second,to);
   }
+}
 
-  is >> std::skipws >> num_states;
-
-  is >> ch;
-
-  if (ch != ')')
+// Splits [first, last) into at least one and at most number_of_parts parts that each start at the beginning of a transition.
+// A part ends after a newline that follows a closing bracket, which assumes that no quoted label contains
+// a closing bracket directly followed by a newline.
+static std::vector<aut_chunk> split_aut_transitions(const char* first, const char* last, const std::size_t number_of_parts)
+{
+  std::vector<aut_chunk> result;
+  const char* begin=first;
+  for (std::size_t i=1; i<=number_of_parts && (i==1 || begin!=last); ++i)
   {
-    throw mcrl2::runtime_error("Expect a closing bracket ')' after the third number in the first line of a .aut file.");
+    const char* end=i==number_of_parts?last:std::max(begin,first+(last-first)*i/number_of_parts);
+    for( ; end!=last; ++end)
+    {
+      if (*end=='\n')
+      {
+        const char* p=end;
+        for( ; p!=begin && (*(p-1)==' ' || *(p-1)=='\r'); --p) {}
+        if (p!=begin && *(p-1)==')')
+        {
+          ++end;
+          break;
+        }
+      }
+    }
+    result.push_back(aut_chunk{begin,end,{},{},{},{},nullptr});
+    begin=end;
   }
-
-  read_newline(is,1);
+  return result;
 }
 
-static bool read_initial_part_of_an_aut_transition(
-  std::istream& is,
-  std::size_t& from,
-  std::string& label,
-  const std::size_t line_no)
+// Inputs with fewer characters than this per thread are read by fewer threads.
+static constexpr std::size_t aut_minimal_chunk_size=1<<20;
+
+// Reads the header and the transitions of the .aut file in [first, last). The transitions are split
+// in parts that are read in parallel. The labels of the transitions are already indices in the action
+// labels of l, which are numbered in the order in which they first occur in the input, as in a sequential reader.
+template <class AUT_LTS_TYPE>
+static std::vector<aut_chunk> read_aut_chunks(
+  AUT_LTS_TYPE& l,
+  const char* first,
+  const char* last,
+  const std::size_t number_of_threads,
+  std::size_t& initial_state,
+  aut_probabilistic_target& initial_target,
+  std::size_t& ntrans,
+  std::size_t& nstate)
 {
-  char ch;
-  is >> std::skipws >> ch;
-  if (is.eof())
+  // An EOT character separates two files, and ends this one.
+  const char* eot=static_cast<const char*>(std::memchr(first,0x04,last-first));
+  if (eot!=nullptr)
   {
-    return false;
+    last=eot;
   }
-  if (ch == 0x04) // found EOT character that separates two files
+
+  aut_scanner header_scanner(first,last,1);
+  initial_state=header_scanner.read_header(initial_target,ntrans,nstate);
+  if (!AUT_LTS_TYPE::is_probabilistic_lts && !initial_target.states.empty())
   {
-    return false;
+    throw mcrl2::runtime_error("Encountered an initial probability distribution while reading an non probabilistic .aut file.");
   }
 
-  is >> std::skipws >> from;
+  check_state(initial_state, nstate, 1);
+  for (const std::size_t s: initial_target.states)
+  {
+    check_state(s, nstate, 1);
+  }
 
-  is >> std::skipws >> ch;
-  if (ch != ',')
+  if (nstate==0)
   {
-    throw mcrl2::runtime_error("Expect that the first number is followed by a comma at line " + std::to_string(line_no) + ".");
+    throw mcrl2::runtime_error("cannot parse AUT input that has no states; at least an initial state is required.");
   }
 
-  is >> std::skipws >> ch;
-  if (ch == '"')
+  const char* body=header_scanner.position();
+  const std::size_t number_of_parts=std::max<std::size_t>(1,std::min<std::size_t>(number_of_threads,(last-body)/aut_minimal_chunk_size));
+  std::vector<aut_chunk> chunks=split_aut_transitions(body,last,number_of_parts);
+  auto read_chunk=[&](aut_chunk& chunk)
   {
-    label="";
-    // In case the label is using quotes whitespaces
-    // in the label are preserved. 
-    is >> std::noskipws >> ch;
-    while ((ch != '"') && !is.eof())
+    try
     {
-      label.push_back(ch);
-      is >> ch;
+      // Reserve space for the part of the transitions in the header that corresponds to the size of this chunk.
+      if (last!=body)
+      {
+        chunk.transitions.reserve(static_cast<std::size_t>(static_cast<double>(ntrans)*(chunk.last-chunk.first)/(last-body))+1);
+      }
+      read_aut_chunk(chunk,AUT_LTS_TYPE::is_probabilistic_lts,nstate,0);
     }
-    if (ch != '"')
+    catch (...)
     {
-      throw mcrl2::runtime_error("Expect that the second item is a quoted label (using \") at line " + std::to_string(line_no) + ".");
+      chunk.error=std::current_exception();
     }
-    is >> std::skipws >> ch;
+  };
+  if (chunks.size()==1)
+  {
+    read_chunk(chunks.front());
   }
   else
   {
-    // In case the label is not within quotes,
-    // whitespaces are removed from the label. 
-    label = ch;
-    is >> ch;
-    while ((ch != ',') && !is.eof())
+    std::vector<std::thread> threads;
+    threads.reserve(chunks.size());
+    for (aut_chunk& chunk: chunks)
+    {
+      threads.emplace_back(read_chunk,std::ref(chunk));
+    }
+    for (std::thread& t: threads)
     {
-      label.push_back(ch);
-      is >> ch;
+      t.join();
     }
   }
 
-  if (ch != ',')
+  // A part in which an error occurred is read again, with the line numbers of the whole input.
+  for (aut_chunk& chunk: chunks)
   {
-    throw mcrl2::runtime_error("Expect a comma after the quoted label at line " + std::to_string(line_no) + ".");
+    if (chunk.error!=nullptr)
+    {
+      aut_chunk fresh_chunk{chunk.first,chunk.last,{},{},{},{},nullptr};
+      read_aut_chunk(fresh_chunk,AUT_LTS_TYPE::is_probabilistic_lts,nstate,1+std::count(first,chunk.first,'\n'));
+      std::rethrow_exception(chunk.error);
+    }
   }
-  
-  return true;
-}
 
-static bool read_aut_transition(
-  std::istream& is,
-  std::size_t& from,
-  std::string& label,
-  mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& target_probabilistic_state,
-  const std::size_t line_no)
-{
-  if (!read_initial_part_of_an_aut_transition(is,from,label,line_no))
+  std::size_t number_of_transitions=0;
+  for (const aut_chunk& chunk: chunks)
   {
-    return false;
+    number_of_transitions+=chunk.transitions.size();
   }
-
-  read_probabilistic_state(is,target_probabilistic_state,line_no);
-
-  char ch;
-  is >> ch;
-  if (ch != ')')
+  if (ntrans != number_of_transitions)
   {
-    throw mcrl2::runtime_error("Expect a closing bracket at the end of the transition at line " + std::to_string(line_no) + ".");
+    throw mcrl2::runtime_error("number of transitions read (" + std::to_string(number_of_transitions) +
+                               ") does not correspond to the number of transition given in the header (" + std::to_string(ntrans) + ").");
   }
 
-  read_newline(is,line_no);
-  return true;
+  mcrl2::utilities::unordered_map < action_label_string, std::size_t > action_labels;
+  action_labels[action_label_string::tau_action()]=0; // A tau action is always stored at position 0.
+  for (aut_chunk& chunk: chunks)
+  {
+    std::vector<std::size_t> label_indices;
+    label_indices.reserve(chunk.labels.size());
+    for (const std::string& s: chunk.labels)
+    {
+      label_indices.push_back(find_label_index(s,action_labels,l));
+    }
+    for (transition& t: chunk.transitions)
+    {
+      t.set_label(label_indices[t.label()]);
+    }
+  }
+  return chunks;
 }
 
-static bool read_aut_transition(
-  std::istream& is,
-  std::size_t& from,
-  std::string& label,
-  std::size_t& to,
-  const std::size_t line_no)
+// Moves the transitions of the chunks into l. The transitions of the first chunk are not copied.
+template <class AUT_LTS_TYPE>
+static void append_aut_transitions(AUT_LTS_TYPE& l, std::vector<aut_chunk>& chunks)
 {
-  if (!read_initial_part_of_an_aut_transition(is,from,label,line_no))
+  std::size_t number_of_transitions=0;
+  for (const aut_chunk& chunk: chunks)
   {
-    return false;
+    number_of_transitions+=chunk.transitions.size();
   }
-
-  is >> std::skipws >> to;
-
-  char ch;
-  is >> ch;
-  if (ch != ')')
+  std::vector<transition>& transitions=l.get_transitions();
+  transitions=std::move(chunks.front().transitions);
+  transitions.reserve(number_of_transitions);
+  for (std::size_t i=1; i<chunks.size(); ++i)
   {
-    throw mcrl2::runtime_error("Expect a closing bracket at the end of the transition at line " + std::to_string(line_no) + ".");
+    transitions.insert(transitions.end(),chunks[i].transitions.begin(),chunks[i].transitions.end());
+    chunks[i].transitions=std::vector<transition>();
   }
-
-  read_newline(is,line_no);
-  return true;
 }
 
-
-static void read_from_aut(probabilistic_lts_aut_t& l, std::istream& is)
+static void read_from_aut(probabilistic_lts_aut_t& l, const char* first, const char* last, const std::size_t number_of_threads)
 {
-  std::size_t line_no = 1;
-  std::size_t ntrans=0, nstate=0;
-
-  mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t initial_probabilistic_state;
-  read_aut_header(is,initial_probabilistic_state,ntrans,nstate);
+  std::size_t initial_state=0, ntrans=0, nstate=0;
+  aut_probabilistic_target initial_target;
+  std::vector<aut_chunk> chunks=read_aut_chunks(l,first,last,number_of_threads,initial_state,initial_target,ntrans,nstate);
 
-  // The two unordered maps below are used to determine a unique index for each probabilistic state.
-  // Because most states consist of one probabilistic state, the unordered maps are duplicated into
-  // indices_of_single_probabilistic_states and indices_of_multiple_probabilistic_states.
-  // The map indices_of_single_probabilistic_states requires far less memory.
-  mcrl2::utilities::unordered_map < std::size_t, std::size_t> indices_of_single_probabilistic_states;
-  mcrl2::utilities::unordered_map < mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t, std::size_t> indices_of_multiple_probabilistic_states;
-  
-  check_states(initial_probabilistic_state, nstate, line_no);
+  l.set_num_states(nstate,false);
 
-  if (nstate==0)
+  aut_probabilistic_state probabilistic_state;
+  if (initial_target.states.empty())
   {
-    throw mcrl2::runtime_error("cannot parse AUT input that has no states; at least an initial state is required.");
+    probabilistic_state.set(initial_state);
   }
-
-  l.set_num_states(nstate,false);
-  l.clear_transitions(ntrans); // Reserve enough space for the transitions.
-  
-  mcrl2::utilities::unordered_map < action_label_string, std::size_t > action_labels;
-  action_labels[action_label_string::tau_action()]=0; // A tau action is always stored at position 0.
-  l.set_initial_probabilistic_state(initial_probabilistic_state); 
-
-  mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t probabilistic_target_state;
-  std::size_t from;
-  std::string s;
-
-  while (!is.eof())
+  else
   {
-    probabilistic_target_state.clear();
+    make_probabilistic_state(initial_target,probabilistic_state);
+  }
+  l.set_initial_probabilistic_state(probabilistic_state);
 
-    line_no++;
+  // Determine a unique index for each probabilistic state, in the order in which they occur. Most states consist
+  // of one probabilistic state, and their indices are stored in a vector indexed by the state, which is much
+  // faster and requires less memory than a map.
+  constexpr std::size_t undefined=std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> indices_of_single_probabilistic_states(nstate,undefined);
+  mcrl2::utilities::unordered_map < aut_probabilistic_state, std::size_t> indices_of_multiple_probabilistic_states;
+  std::size_t number_of_probabilistic_states=0;
 
-    if (!read_aut_transition(is,from,s,probabilistic_target_state,line_no))
+  for (aut_chunk& chunk: chunks)
+  {
+    std::vector<std::size_t>::const_iterator next_probabilistic_transition=chunk.probabilistic_transitions.begin();
+    for (std::size_t i=0; i<chunk.transitions.size(); ++i)
     {
-      break; // encountered EOF or something that is not a transition
-    }
+      transition& t=chunk.transitions[i];
+      std::size_t state=t.to();
+      if (next_probabilistic_transition!=chunk.probabilistic_transitions.end() && *next_probabilistic_transition==i)
+      {
+        ++next_probabilistic_transition;
+        probabilistic_state.clear();
+        make_probabilistic_state(chunk.probabilistic_targets[t.to()],probabilistic_state);
+        if (probabilistic_state.size()>1)
+        {
+          const std::size_t index=indices_of_multiple_probabilistic_states.insert(
+                       std::pair< aut_probabilistic_state, std::size_t>
+                       (probabilistic_state,number_of_probabilistic_states)).first->second;
+          if (index==number_of_probabilistic_states)
+          {
+            l.add_and_reset_probabilistic_state(probabilistic_state);
+            number_of_probabilistic_states++;
+          }
+          t.set_to(index);
+          continue;
+        }
+        state=probabilistic_state.get();
+      }
 
-    check_state(from, nstate, line_no);
-    check_states(probabilistic_target_state, nstate, line_no);
-    // Check whether probabilistic states exists. 
-    std::size_t fresh_index = indices_of_single_probabilistic_states.size()+indices_of_multiple_probabilistic_states.size();
-    std::size_t index;
-    if (probabilistic_target_state.size()<=1)
-    {
-      index = indices_of_single_probabilistic_states.insert(
-                       std::pair< std::size_t, std::size_t>
-                       (probabilistic_target_state.get(),fresh_index)).first->second;
-    }
-    else
-    {
-      assert(probabilistic_target_state.size()>1);
-      index = indices_of_multiple_probabilistic_states.insert(
-                       std::pair< mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t, std::size_t>
-                       (probabilistic_target_state,fresh_index)).first->second;
-    }
-    
-    if (index==fresh_index) 
-    {
-      std::size_t probabilistic_state_index=l.add_and_reset_probabilistic_state(probabilistic_target_state);
-      assert(probabilistic_state_index==index);
-      (void)probabilistic_state_index; // Avoid unused variable warning.
+      std::size_t& index=indices_of_single_probabilistic_states[state];
+      if (index==undefined)
+      {
+        index=number_of_probabilistic_states++;
+        probabilistic_state.clear();
+        probabilistic_state.set(state);
+        l.add_and_reset_probabilistic_state(probabilistic_state);
+      }
+      t.set_to(index);
     }
-
-    l.add_transition(transition(from,find_label_index(s,action_labels,l),index));
   }
+  append_aut_transitions(l,chunks);
+}
 
-  if (ntrans != l.num_transitions())
-  {
-    throw mcrl2::runtime_error("number of transitions read (" + std::to_string(l.num_transitions()) +
-                               ") does not correspond to the number of transition given in the header (" + std::to_string(ntrans) + ").");
-  }
+static void read_from_aut(lts_aut_t& l, const char* first, const char* last, const std::size_t number_of_threads)
+{
+  std::size_t initial_state=0, ntrans=0, nstate=0;
+  aut_probabilistic_target initial_target;
+  std::vector<aut_chunk> chunks=read_aut_chunks(l,first,last,number_of_threads,initial_state,initial_target,ntrans,nstate);
+
+  l.set_num_states(nstate,false);
+  l.set_initial_state(initial_state);
+  append_aut_transitions(l,chunks);
 }
 
-static void read_from_aut(lts_aut_t& l, std::istream& is)
+template <class AUT_LTS_TYPE>
+static void read_from_aut(AUT_LTS_TYPE& l, std::istream& is, const std::size_t number_of_threads)
+{
+  // Read up to the EOT character that separates two files, or up to the end of the stream.
+  std::string input;
+  std::getline(is,input,'\x04');
+  read_from_aut(l,input.data(),input.data()+input.size(),number_of_threads);
+}
+
+template <class AUT_LTS_TYPE>
+static void read_from_aut(AUT_LTS_TYPE& l, const std::string& filename, const std::size_t number_of_threads)
 {
-  std::size_t line_no = 1;
-  std::size_t ntrans=0, nstate=0;
+  std::ifstream is(filename.c_str(), std::ios::binary);
 
-  mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t initial_probabilistic_state;
-  read_aut_header(is,initial_probabilistic_state,ntrans,nstate);
-  
-  if (initial_probabilistic_state.size()>1)
+  if (!is.is_open())
   {
-    throw mcrl2::runtime_error("Encountered an initial probability distribution while reading an non probabilistic .aut file.");
+    throw mcrl2::runtime_error("cannot open .aut file '" + filename + ".");
   }
 
-  check_states(initial_probabilistic_state, nstate, line_no);
-
-  if (nstate==0)
+  // Read the whole file at once. If the size of the input is not known, it is read as a stream.
+  is.seekg(0,std::ios::end);
+  const std::streamoff size=is.tellg();
+  if (size<0)
   {
-    throw mcrl2::runtime_error("cannot parse AUT input that has no states; at least an initial state is required.");
+    is.clear();
+    is.seekg(0,std::ios::beg);
+    read_from_aut(l,is,number_of_threads);
+    return;
   }
+  is.seekg(0,std::ios::beg);
+  std::string input(static_cast<std::size_t>(size),'\0');
+  is.read(input.data(),size);
+  read_from_aut(l,input.data(),input.data()+is.gcount(),number_of_threads);
+}
 
-  l.set_num_states(nstate,false);
-  l.clear_transitions(ntrans); // Reserve enough space for the transitions.
-  
-  mcrl2::utilities::unordered_map < action_label_string, std::size_t > action_labels;
-  action_labels[action_label_string::tau_action()]=0; // A tau action is always stored at position 0.
-  l.set_initial_state(initial_probabilistic_state.get()); 
 
-  std::size_t from, to;
-  std::string s;
-  while (!is.eof())
-  {
-    line_no++;
+// Collects the output in a buffer that is written to the stream in large blocks. This is much
+// faster than writing the numbers and labels of each transition to the stream separately.
+class aut_output_buffer
+{
+  protected:
+    static constexpr std::size_t block_size=1<<20;
+
+    std::ostream& m_os;
+    std::string m_buffer;
+
+    aut_output_buffer& write_if_full()
+    {
+      if (m_buffer.size()>=block_size)
+      {
+        flush();
+      }
+      return *this;
+    }
 
-    if (!read_aut_transition(is,from,s,to,line_no))
+  public:
+    explicit aut_output_buffer(std::ostream& os)
+      : m_os(os)
     {
-      break; // eof encountered
+      m_buffer.reserve(2*block_size);
     }
 
-    check_state(from, nstate, line_no);
-    check_state(to, nstate, line_no);
-    l.add_transition(transition(from,find_label_index(s,action_labels,l),to));
-  }
+    ~aut_output_buffer()
+    {
+      flush();
+    }
+
+    void flush()
+    {
+      m_os.write(m_buffer.data(),m_buffer.size());
+      m_buffer.clear();
+    }
+
+    aut_output_buffer& operator<<(const char* s)
+    {
+      m_buffer.append(s);
+      return write_if_full();
+    }
+
+    aut_output_buffer& operator<<(const std::string& s)
+    {
+      m_buffer.append(s);
+      return write_if_full();
+    }
 
-  if (ntrans != l.num_transitions())
+    aut_output_buffer& operator<<(const std::size_t n)
+    {
+      char digits[std::numeric_limits<std::size_t>::digits10+1];
+      m_buffer.append(digits,std::to_chars(digits,digits+sizeof(digits),n).ptr);
+      return write_if_full();
+    }
+};
+
+// The text of each action label as it is written in a .aut file, taking hidden actions into account.
+template <class AUT_LTS_TYPE>
+static std::vector<std::string> aut_label_texts(const AUT_LTS_TYPE& l)
+{
+  std::vector<std::string> result;
+  result.reserve(l.num_action_labels());
+  for (std::size_t i=0; i<l.num_action_labels(); ++i)
   {
-    throw mcrl2::runtime_error("number of transitions read (" + std::to_string(l.num_transitions()) +
-                               ") does not correspond to the number of transition given in the header (" + std::to_string(ntrans) + ").");
+    result.push_back(pp(l.action_label(l.apply_hidden_label_map(i))));
   }
+  return result;
 }
 
-
-static void write_probabilistic_state(const mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& prob_state, std::ostream& os)
+static void write_probabilistic_state(const mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& prob_state, aut_output_buffer& os)
 {
   mcrl2::lts::probabilistic_arbitrary_precision_fraction previous_probability;
   bool first_element=true;
@@ -501,30 +759,30 @@ static void write_probabilistic_state(const mcrl2::lts::probabilistic_lts_aut_t:
 
 static void write_to_aut(const probabilistic_lts_aut_t& l, std::ostream& os)
 {
-  // Do not use "endl" below to avoid flushing. Use "\n" instead.
-  os << "des (";
-  write_probabilistic_state(l.initial_probabilistic_state(),os);
+  aut_output_buffer out(os);
+  out << "des (";
+  write_probabilistic_state(l.initial_probabilistic_state(),out);
 
-  os << "," << l.num_transitions() << "," << l.num_states() << ")" << "\n";
+  out << "," << l.num_transitions() << "," << l.num_states() << ")" << "\n";
 
+  const std::vector<std::string> labels=aut_label_texts(l);
   for (const transition& t: l.get_transitions())
   {
-    os << "(" << t.from() << ",\"" << pp(l.action_label(l.apply_hidden_label_map(t.label()))) << "\",";
-    write_probabilistic_state(l.probabilistic_state(t.to()),os);
-    os << ")" << "\n";
+    out << "(" << t.from() << ",\"" << labels[t.label()] << "\",";
+    write_probabilistic_state(l.probabilistic_state(t.to()),out);
+    out << ")" << "\n";
   }
 }
 
 static void write_to_aut(const lts_aut_t& l, std::ostream& os)
 {
-  // Do not use "endl" below to avoid flushing. Use "\n" instead.
-  os << "des (" << l.initial_state() << "," << l.num_transitions() << "," << l.num_states() << ")" << "\n"; 
+  aut_output_buffer out(os);
+  out << "des (" << l.initial_state() << "," << l.num_transitions() << "," << l.num_states() << ")" << "\n"; 
 
+  const std::vector<std::string> labels=aut_label_texts(l);
   for (const transition& t: l.get_transitions())
   {
-    os << "(" << t.from() << ",\"" 
-       << pp(l.action_label(l.apply_hidden_label_map(t.label()))) << "\"," 
-       << t.to() << ")" << "\n";
+    out << "(" << t.from() << ",\"" << labels[t.label()] << "\"," << t.to() << ")" << "\n";
   }
 }
 
@@ -533,29 +791,21 @@ namespace mcrl2
 namespace lts
 {
 
-void probabilistic_lts_aut_t::load(const std::string& filename)
+void probabilistic_lts_aut_t::load(const std::string& filename, const std::size_t number_of_threads)
 {
   if (filename=="" || filename=="-")
   {
-    read_from_aut(*this, std::cin);
+    read_from_aut(*this, std::cin, number_of_threads);
   }
   else
   {
-    std::ifstream is(filename.c_str());
-
-    if (!is.is_open())
-    {
-      throw mcrl2::runtime_error("cannot open .aut file '" + filename + ".");
-    }
-
-    read_from_aut(*this,is);
-    is.close();
+    read_from_aut(*this, filename, number_of_threads);
   }
 }
 
-void probabilistic_lts_aut_t::load(std::istream& is)
+void probabilistic_lts_aut_t::load(std::istream& is, const std::size_t number_of_threads)
 {
-  read_from_aut(*this,is);
+  read_from_aut(*this, is, number_of_threads);
 }
 
 void probabilistic_lts_aut_t::save(std::string const& filename) const
@@ -578,29 +828,21 @@ void probabilistic_lts_aut_t::save(std::string const& filename) const
   }
 }
 
-void lts_aut_t::load(const std::string& filename)
+void lts_aut_t::load(const std::string& filename, const std::size_t number_of_threads)
 {
   if (filename=="" || filename=="-")
   {
-    read_from_aut(*this, std::cin);
+    read_from_aut(*this, std::cin, number_of_threads);
   }
   else
   {
-    std::ifstream is(filename.c_str());
-
-    if (!is.is_open())
-    {
-      throw mcrl2::runtime_error("cannot open .aut file '" + filename + ".");
-    }
-
-    read_from_aut(*this,is);
-    is.close();
+    read_from_aut(*this, filename, number_of_threads);
   }
 }
 
-void lts_aut_t::load(std::istream& is)
+void lts_aut_t::load(std::istream& is, const std::size_t number_of_threads)
 {
-  read_from_aut(*this,is);
+  read_from_aut(*this, is, number_of_threads);
 }
 
 void lts_aut_t::save(std::string const& filename) const
@@ -128,13 +128,8 @@ static void set_initial_state(probabilistic_lts_lts_t& lts, const probabilistic_
   lts.set_initial_probabilistic_state(initial_state);
 }
 
-template <class LTS>
-static void read_lts(atermpp::aterm_istream& stream, LTS& lts)
+static void read_lts_contents(atermpp::aterm_istream& stream, lts_stream_handler& handler)
 {
-  static_assert(std::is_same<LTS,probabilistic_lts_lts_t>::value ||
-                std::is_same<LTS,lts_lts_t>::value,
-                "Function read_lts can only be applied to a (probabilistic) lts. ");
-
   atermpp::aterm_stream_state state(stream);
   stream >> data::detail::add_index_impl;
 
@@ -155,23 +150,7 @@ static void read_lts(atermpp::aterm_istream& stream, LTS& lts)
   stream >> parameters;
   stream >> action_labels;
 
-  lts.set_data(spec);
-  lts.set_process_parameters(parameters);
-  lts.set_action_label_declarations(action_labels);
-
-  // An indexed set to keep indices for multi actions.
-  mcrl2::utilities::indexed_set<action_label_lts> multi_actions;
-  multi_actions.insert(action_label_lts::tau_action()); // This action list represents 'tau'.
-
-  // The initial state is stored and set as last.
-  std::optional<probabilistic_lts_lts_t::probabilistic_state_t> initial_state;
-
-  // Ensure unique indices for the probabilistic states.
-  mcrl2::utilities::indexed_set<
-    probabilistic_lts_lts_t::probabilistic_state_t> probabilistic_states;
-
-  // Keep track of the number of states (derived from the transitions).
-  std::size_t number_of_states = 1;
+  handler.header(spec, parameters, action_labels);
 
   aterm term;
   aterm_int from;
@@ -193,136 +172,187 @@ static void read_lts(atermpp::aterm_istream& stream, LTS& lts)
       stream >> action;
       stream >> to;
 
-      const auto [index, inserted] = multi_actions.insert(action);
+      handler.transition(from.value(), action, to.value());
+    }
+    else if(term == probabilistic_transition_mark())
+    {
+      probabilistic_lts_lts_t::probabilistic_state_t to;
 
-      std::size_t target_index = to.value();
-      if constexpr (std::is_same<LTS, probabilistic_lts_lts_t>::value)
-      {
-        probabilistic_lts_lts_t::probabilistic_state_t lts_state(to.value());
-
-        // For probabilistic lts it is necessary to add the state first (and use the returned index).
-        bool state_inserted;
-        std::tie(target_index, state_inserted) = probabilistic_states.insert(lts_state);
-
-        if (state_inserted)
-        {
-          std::size_t actual_index = lts.add_probabilistic_state(lts_state);
-          utilities::mcrl2_unused(actual_index);
-          assert(actual_index == target_index);
-        }
-      }
+      stream >> from;
+      stream >> action;
+      stream >> to;
+
+      handler.probabilistic_transition(from.value(), action, to);
+    }
+    else if (term.function() == atermpp::detail::g_term_pool().as_list())
+    {
+      // Lists always represent state labels.
+      handler.state_label(reinterpret_cast<const state_label_lts&>(term));
+    }
+    else if (term == initial_state_mark())
+    {
+      // Read the initial state.
+      probabilistic_lts_lts_t::probabilistic_state_t state;
+      stream >> state;
+      handler.initial_state(state);
+    }
+    else
+    {
+      throw mcrl2::runtime_error("Unknown mark in labelled transition system (LTS) stream.");
+    }
+  }
+}
+
+/// \brief Stores the contents of an LTS stream in a (probabilistic) lts.
+template <class LTS>
+class lts_stream_builder: public lts_stream_handler
+{
+  static_assert(std::is_same<LTS,probabilistic_lts_lts_t>::value ||
+                std::is_same<LTS,lts_lts_t>::value,
+                "Class lts_stream_builder can only be applied to a (probabilistic) lts. ");
+
+  protected:
+    LTS& m_lts;
+
+    // An indexed set to keep indices for multi actions.
+    mcrl2::utilities::indexed_set<action_label_lts> m_multi_actions;
+
+    // The initial state is stored and set as last.
+    std::optional<probabilistic_state_t> m_initial_state;
+
+    // Ensure unique indices for the probabilistic states.
+    mcrl2::utilities::indexed_set<probabilistic_state_t> m_probabilistic_states;
+
+    // Keep track of the number of states (derived from the transitions).
+    std::size_t m_number_of_states = 1;
+
+    void add_transition(std::size_t from, const action_label_lts& action, std::size_t to_index)
+    {
+      const auto [index, inserted] = m_multi_actions.insert(action);
 
       // Add the transition and update the number of states.
-      lts.add_transition(transition(from.value(), index, target_index));
-      number_of_states = std::max(number_of_states, std::max(from.value() + 1, to.value() + 1));
+      m_lts.add_transition(mcrl2::lts::transition(from, index, to_index));
 
       if (inserted)
       {
-        std::size_t actual_index = lts.add_action(action);
+        std::size_t actual_index = m_lts.add_action(action);
         utilities::mcrl2_unused(actual_index);
         assert(actual_index == index);
       }
+    }
 
+    // For probabilistic lts it is necessary to add the state first (and use the returned index).
+    std::size_t add_probabilistic_state(const probabilistic_state_t& state)
+    {
+      const auto [index, inserted] = m_probabilistic_states.insert(state);
+      if (inserted)
+      {
+        std::size_t actual_index = m_lts.add_probabilistic_state(state);
+        utilities::mcrl2_unused(actual_index);
+        assert(actual_index == index);
+      }
+      return index;
     }
-    else if(term == probabilistic_transition_mark())
+
+  public:
+    explicit lts_stream_builder(LTS& lts)
+      : m_lts(lts)
+    {
+      m_multi_actions.insert(action_label_lts::tau_action()); // This action list represents 'tau'.
+    }
+
+    void header(const data::data_specification& data,
+                const data::variable_list& parameters,
+                const process::action_label_list& action_labels) override
+    {
+      m_lts.set_data(data);
+      m_lts.set_process_parameters(parameters);
+      m_lts.set_action_label_declarations(action_labels);
+    }
+
+    void transition(std::size_t from, const action_label_lts& label, std::size_t to) override
     {
+      std::size_t target_index = to;
       if constexpr (std::is_same<LTS, probabilistic_lts_lts_t>::value)
       {
-        probabilistic_lts_lts_t::probabilistic_state_t to;
-
-        stream >> from;
-        stream >> action;
-        stream >> to;
+        target_index = add_probabilistic_state(probabilistic_state_t(to));
+      }
 
-        const auto [index, inserted] = multi_actions.insert(action);
+      add_transition(from, label, target_index);
+      m_number_of_states = std::max(m_number_of_states, std::max(from + 1, to + 1));
+    }
 
+    void probabilistic_transition(std::size_t from, const action_label_lts& label, const probabilistic_state_t& to) override
+    {
+      if constexpr (std::is_same<LTS, probabilistic_lts_lts_t>::value)
+      {
         // Compute the index of the probabilistic state.
-        const auto [to_index, state_inserted] = probabilistic_states.insert(to);
-
-        if (state_inserted)
-        {
-          std::size_t actual_index = lts.add_probabilistic_state(to);
-          utilities::mcrl2_unused(actual_index);
-          assert(actual_index == to_index);
-        }
-
-        lts.add_transition(transition(from.value(), index, to_index));
-
-        // Update the number of states
-        number_of_states = std::max(number_of_states, std::max(from.value() + 1, to_index + 1));
-
-        if (inserted)
-        {
-          std::size_t actual_index = lts.add_action(action);
-          utilities::mcrl2_unused(actual_index);
-          assert(actual_index == index);
-        }
+        std::size_t to_index = add_probabilistic_state(to);
+
+        add_transition(from, label, to_index);
+        m_number_of_states = std::max(m_number_of_states, std::max(from + 1, to_index + 1));
       }
       else
       {
+        utilities::mcrl2_unused(from, label, to);
         throw mcrl2::runtime_error("Attempting to read a probabilistic LTS as a regular LTS.");
       }
     }
-    else if (term.function() == atermpp::detail::g_term_pool().as_list())
+
+    void state_label(const state_label_lts& label) override
     {
-      // Lists always represent state labels, only need to add the indices.
-      lts.add_state(reinterpret_cast<const state_label_lts&>(term));
+      m_lts.add_state(label);
     }
-    else if (term == initial_state_mark())
+
+    void initial_state(const probabilistic_state_t& state) override
     {
-      // Read the initial state.
-      probabilistic_lts_lts_t::probabilistic_state_t state;
-      stream >> state;
-      initial_state = state;
+      m_initial_state = state;
     }
-    else
+
+    /// \brief Sets the number of states and the initial state, which can only be done once all states are known.
+    void finish()
     {
-      throw mcrl2::runtime_error("Unknown mark in labelled transition system (LTS) stream.");
-    }
-  }
+      if (m_initial_state)
+      {
+        // If the lts has no state labels, we need to add empty states labels.
+        m_lts.set_num_states(m_number_of_states, m_lts.has_state_info());
 
-  // The initial state can only be set after the states are known.
-  if (initial_state)
-  {
-    // If the lts has no state labels, we need to add empty states labels.
-    lts.set_num_states(number_of_states, lts.has_state_info());
+        set_initial_state(m_lts, m_initial_state.value());
+      }
+      else
+      {
+        throw mcrl2::runtime_error("Missing initial state in labelled transition system (LTS) stream.");
+      }
+    }
+};
 
-    set_initial_state(lts, initial_state.value());
-  }
-  else
-  {
-    throw mcrl2::runtime_error("Missing initial state in labelled transition system (LTS) stream.");
-  }
+template <class LTS>
+static void read_lts(atermpp::aterm_istream& stream, LTS& lts)
+{
+  lts_stream_builder<LTS> builder(lts);
+  read_lts_contents(stream, builder);
+  builder.finish();
 }
 
-template <class LTS_TRANSITION_SYSTEM>     
-static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filename)
+/// \brief Opens the given file, or standard input if the filename is empty, and applies read to a binary aterm
+///        stream on it.
+template <typename ReadFunction>
+static void read_from_file(const std::string& filename, ReadFunction read)
 {
-  static_assert(std::is_same<LTS_TRANSITION_SYSTEM,probabilistic_lts_lts_t>::value || 
-                std::is_same<LTS_TRANSITION_SYSTEM,lts_lts_t>::value,
-                "Function read_from_lts can only be applied to a (probabilistic) lts. ");
-
   std::ifstream fstream;
   if (!filename.empty())
   {
     fstream.open(filename, std::ifstream::in | std::ifstream::binary);
     if (fstream.fail())
     {
-      if (filename.empty())
-      {
-        throw mcrl2::runtime_error("Fail to open standard input to read an lts.");
-      }
-      else 
-      {
-        throw mcrl2::runtime_error("Fail to open file " + filename + " to read an lts.");
-      }
+      throw mcrl2::runtime_error("Fail to open file " + filename + " to read an lts.");
     }
   }
 
   try
   {
     atermpp::binary_aterm_istream stream(filename.empty() ? std::cin : fstream);
-    stream >> lts;
+    read(stream);
   }
   catch (const std::exception& ex)
   {
@@ -338,6 +368,16 @@ static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filenam
   }
 }
 
+template <class LTS_TRANSITION_SYSTEM>     
+static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filename)
+{
+  static_assert(std::is_same<LTS_TRANSITION_SYSTEM,probabilistic_lts_lts_t>::value || 
+                std::is_same<LTS_TRANSITION_SYSTEM,lts_lts_t>::value,
+                "Function read_from_lts can only be applied to a (probabilistic) lts. ");
+
+  read_from_file(filename, [&lts](atermpp::aterm_istream& stream) { stream >> lts; });
+}
+
 void write_initial_state(atermpp::aterm_ostream& stream, const probabilistic_lts_lts_t& lts)
 {
   stream << detail::initial_state_mark();
@@ -447,6 +487,16 @@ atermpp::aterm_ostream& operator<<(atermpp::aterm_ostream& stream, const probabi
   return stream;
 }
 
+void read_lts_stream(atermpp::aterm_istream& stream, lts_stream_handler& handler)
+{
+  detail::read_lts_contents(stream, handler);
+}
+
+void read_lts_stream(const std::string& filename, lts_stream_handler& handler)
+{
+  detail::read_from_file(filename, [&handler](atermpp::aterm_istream& stream) { detail::read_lts_contents(stream, handler); });
+}
+
 void write_lts_header(atermpp::aterm_ostream& stream,
   const data::data_specification& data_spec,
   const data::variable_list& parameters,
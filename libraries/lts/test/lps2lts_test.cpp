@@ -18,6 +18,7 @@
 
 #include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/lps/is_stochastic.h"
+#include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/lts/state_space_generator.h"
 #include "mcrl2/lts/stochastic_lts_builder.h"
 #include "mcrl2/utilities/test_utilities.h"
@@ -51,7 +52,10 @@ void run_generatelts(
   lps::exploration_strategy estrategy,
   lts::lts_type output_format,
   const std::string& outputfile,
-  const std::string& priority_action
+  const std::string& priority_action,
+  std::size_t number_of_threads = 1,
+  bool save_at_end = true,
+  bool compress_states = false
 )
 {
   lps::explorer_options options;
@@ -59,7 +63,9 @@ void run_generatelts(
   options.confluence_action = priority_action;
   options.rewrite_strategy = rstrategy;
   options.search_strategy = estrategy;
-  options.save_at_end = true;
+  options.save_at_end = save_at_end;
+  options.number_of_threads = number_of_threads;
+  options.compress_states = compress_states;
 
   bool is_timed = stochastic_lpsspec.process().has_time();
 
@@ -78,7 +84,7 @@ void run_generatelts(
   else
   {
     lps::specification lpsspec = lps::remove_stochastic_operators(stochastic_lpsspec);
-    auto builder = create_lts_builder(lpsspec, options, output_format);
+    auto builder = create_lts_builder(lpsspec, options, output_format, outputfile);
     if (is_timed)
     {
       generate_state_space<false, true>(lpsspec, *builder, outputfile, options);
@@ -218,6 +224,195 @@ BOOST_AUTO_TEST_CASE(test_abp)
   );
   check_lps2lts_specification(abp, 74, 92, 20);
   check_lps2lts_specification(abp, 74, 92, 20, "tau");
+
+  if (atermpp::detail::GlobalThreadSafe)
+  {
+    lps::stochastic_specification lpsspec;
+    parse_lps(abp, lpsspec);
+    for (lps::exploration_strategy estrategy: { lps::es_breadth, lps::es_depth })
+    {
+      // The builders that store the lts in memory and the builders that write it to disk directly.
+      for (bool save_at_end: { true, false })
+      {
+        const std::string outputfile = "test_abp_multiple_threads.aut";
+        run_generatelts(lpsspec, data::jitty, estrategy, lts::lts_aut, outputfile, "", 4, save_at_end);
+        lts::lts_aut_t result;
+        result.load(outputfile);
+        BOOST_CHECK_EQUAL(result.num_states(), 74u);
+        BOOST_CHECK_EQUAL(result.num_transitions(), 92u);
+        BOOST_CHECK_EQUAL(result.num_action_labels(), 20u);
+        std::remove(outputfile.c_str());
+
+        const std::string lts_outputfile = "test_abp_multiple_threads.lts";
+        run_generatelts(lpsspec, data::jitty, estrategy, lts::lts_lts, lts_outputfile, "", 4, save_at_end);
+        lts::lts_lts_t lts_result;
+        lts_result.load(lts_outputfile);
+        BOOST_CHECK_EQUAL(lts_result.num_states(), 74u);
+        BOOST_CHECK_EQUAL(lts_result.num_transitions(), 92u);
+        BOOST_CHECK_EQUAL(lts_result.num_action_labels(), 20u);
+        std::remove(lts_outputfile.c_str());
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_read_lts_stream)
+{
+  const std::string spec(
+    "act  a, b;\n"
+    "proc P(n: Nat) = (n < 3) -> a . P(n + 1) + (n == 3) -> b . P(0) + (n == 2) -> b . P(5);\n"
+    "init P(0);\n"
+  );
+  lps::stochastic_specification lpsspec;
+  parse_lps(spec, lpsspec);
+
+  const std::string outputfile = "test_read_lts_stream.lts";
+  run_generatelts(lpsspec, data::jitty, lps::es_breadth, lts::lts_lts, outputfile, "", 1, true);
+  lts::lts_lts_t result;
+  result.load(outputfile);
+
+  lts::lts_stream_counter counter;
+  lts::read_lts_stream(outputfile, counter);
+  BOOST_CHECK_EQUAL(result.num_states(), 5u);
+  BOOST_CHECK_EQUAL(counter.number_of_states, result.num_states());
+  BOOST_CHECK_EQUAL(counter.number_of_transitions, result.num_transitions());
+  BOOST_CHECK_EQUAL(counter.number_of_state_labels, result.num_state_labels());
+  BOOST_CHECK_EQUAL(counter.initial_probabilistic_state.get(), result.initial_state());
+  std::remove(outputfile.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_bounded_enumeration_cache)
+{
+  const std::string spec(
+    "act  a: Nat;\n"
+    "proc P(n, k: Nat) = sum m: Nat . (m < n) -> a(m) . P((n + 1) mod 5, (k + m) mod 3);\n"
+    "init P(0, 0);\n"
+  );
+  lps::stochastic_specification stochastic_lpsspec;
+  parse_lps(spec, stochastic_lpsspec);
+  lps::specification lpsspec = lps::remove_stochastic_operators(stochastic_lpsspec);
+
+  auto generate = [&](bool cached, bool global_cache, std::size_t cache_size, std::size_t number_of_threads)
+  {
+    lps::explorer_options options;
+    options.search_strategy = lps::es_breadth;
+    options.cached = cached;
+    options.global_cache = global_cache;
+    options.cache_size = cache_size;
+    options.number_of_threads = number_of_threads;
+    const std::string outputfile = "test_bounded_enumeration_cache.aut";
+    auto builder = create_lts_builder(lpsspec, options, lts::lts_aut, outputfile);
+    generate_state_space<false, false>(lpsspec, *builder, outputfile, options);
+    lts::lts_aut_t result;
+    result.load(outputfile);
+    std::remove(outputfile.c_str());
+    return std::make_pair(result.num_states(), result.num_transitions());
+  };
+
+  const auto expected = generate(false, false, 0, 1);
+  BOOST_CHECK(generate(true, false, 0, 1) == expected);
+  BOOST_CHECK(generate(true, false, 2, 1) == expected);
+  BOOST_CHECK(generate(true, true, 0, 1) == expected);
+  BOOST_CHECK(generate(true, true, 1, 1) == expected);
+
+  if (atermpp::detail::GlobalThreadSafe)
+  {
+    BOOST_CHECK(generate(true, false, 2, 4) == expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_compressed_states)
+{
+  const std::string spec(
+    "act  a: Nat;\n"
+    "     b;\n"
+    "proc P(n, k: Nat, c: Bool) = (n < 4) -> a(n) . P(n + 1, k, !c) + (k < 3) -> b . P(n, k + 1, c) + delta;\n"
+    "init P(0, 0, true);\n"
+  );
+  lps::stochastic_specification lpsspec;
+  parse_lps(spec, lpsspec);
+
+  const std::string outputfile = "test_compressed_states.lts";
+  run_generatelts(lpsspec, data::jitty, lps::es_breadth, lts::lts_lts, outputfile, "", 1, true, false);
+  lts::lts_lts_t expected;
+  expected.load(outputfile);
+  BOOST_CHECK_EQUAL(expected.num_states(), 20u);
+
+  for (std::size_t number_of_threads: { 1, 4 })
+  {
+    if (number_of_threads > 1 && !atermpp::detail::GlobalThreadSafe)
+    {
+      continue;
+    }
+    for (bool save_at_end: { true, false })
+    {
+      run_generatelts(lpsspec, data::jitty, lps::es_breadth, lts::lts_lts, outputfile, "", number_of_threads, save_at_end, true);
+      lts::lts_lts_t result;
+      result.load(outputfile);
+      BOOST_CHECK_EQUAL(result.num_states(), expected.num_states());
+      BOOST_CHECK_EQUAL(result.num_transitions(), expected.num_transitions());
+      std::set<lts::state_label_lts> expected_labels(expected.state_labels().begin(), expected.state_labels().end());
+      std::set<lts::state_label_lts> labels(result.state_labels().begin(), result.state_labels().end());
+      BOOST_CHECK(labels == expected_labels);
+      if (number_of_threads == 1)
+      {
+        BOOST_CHECK(result.state_labels() == expected.state_labels());
+      }
+    }
+  }
+  std::remove(outputfile.c_str());
+}
+
+// Returns the transitions of an lts in terms of the labels of the states.
+static std::set<std::tuple<lts::state_label_lts, std::string, lts::state_label_lts>> labelled_transitions(const lts::lts_lts_t& l)
+{
+  std::set<std::tuple<lts::state_label_lts, std::string, lts::state_label_lts>> result;
+  for (const lts::transition& t: l.get_transitions())
+  {
+    result.insert(std::make_tuple(l.state_label(t.from()), pp(l.action_label(t.label())), l.state_label(t.to())));
+  }
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(test_external_breadth_first_search)
+{
+  const std::string spec(
+    "act  a: Nat;\n"
+    "     b;\n"
+    "proc P(n, k: Nat, c: Bool) = (n < 4) -> a(n) . P(n + 1, k, !c) + (k < 3) -> b . P(n, k + 1, c) + (n == 4) -> b . P(0, 0, c);\n"
+    "init P(0, 0, true);\n"
+  );
+  lps::stochastic_specification stochastic_lpsspec;
+  parse_lps(spec, stochastic_lpsspec);
+  lps::specification lpsspec = lps::remove_stochastic_operators(stochastic_lpsspec);
+
+  const std::string outputfile = "test_external_breadth_first_search.lts";
+  run_generatelts(stochastic_lpsspec, data::jitty, lps::es_breadth, lts::lts_lts, outputfile, "");
+  lts::lts_lts_t expected;
+  expected.load(outputfile);
+
+  for (std::size_t buffer_size: { 1, 3, 1000 })
+  {
+    for (bool save_at_end: { true, false })
+    {
+      lps::explorer_options options;
+      options.search_strategy = lps::es_breadth;
+      options.save_at_end = save_at_end;
+      options.external_directory = ".";
+      options.external_buffer_size = buffer_size;
+      {
+        auto builder = create_lts_builder(lpsspec, options, lts::lts_lts, outputfile);
+        generate_state_space<false, false>(lpsspec, *builder, outputfile, options);
+      }
+      lts::lts_lts_t result;
+      result.load(outputfile);
+      BOOST_CHECK_EQUAL(result.num_states(), expected.num_states());
+      BOOST_CHECK_EQUAL(result.num_transitions(), expected.num_transitions());
+      BOOST_CHECK(result.state_label(result.initial_state()) == expected.state_label(expected.initial_state()));
+      BOOST_CHECK(labelled_transitions(result) == labelled_transitions(expected));
+    }
+  }
+  std::remove(outputfile.c_str());
 }
 
 BOOST_AUTO_TEST_CASE(test_confluence)
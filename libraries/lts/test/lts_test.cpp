@@ -936,3 +936,103 @@ BOOST_AUTO_TEST_CASE(hide_actions4)
   test_lts("regression test for GJKW bug (branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l,expected_label_count, expected_state_count, expected_transition_count);
 }
 
+
+BOOST_AUTO_TEST_CASE(transition_storage)
+{
+  // The elements of a transition are stored without padding, in 32 bits for compact transitions.
+  BOOST_CHECK_EQUAL(sizeof(lts::transition), 3 * sizeof(lts::transition::storage_type));
+
+  lts::transition t(1, 2, 3);
+  t.set_to(lts::transition::max_size - 1);
+  BOOST_CHECK(t.from() == 1 && t.label() == 2 && t.to() == lts::transition::max_size - 1);
+
+  if (lts::transition::max_size < std::numeric_limits<std::size_t>::max())
+  {
+    lts::lts_aut_t l;
+    BOOST_CHECK_THROW(l.set_num_states(lts::transition::max_size + 1), mcrl2::runtime_error);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(read_aut_in_parallel)
+{
+  // An .aut file that is large enough to be split in several parts, with quoted labels and
+  // unquoted labels from which the whitespace is removed.
+  const std::size_t n=200000;
+  std::string automaton="des (0," + std::to_string(n) + "," + std::to_string(n) + ")\n";
+  for (std::size_t i=0; i<n; ++i)
+  {
+    if (i%3==0)
+    {
+      automaton+="(" + std::to_string(i) + ", b (" + std::to_string(i%11) + ") ," + std::to_string((i+1)%n) + ")\r\n";
+    }
+    else
+    {
+      automaton+="(" + std::to_string(i) + ",\"a" + std::to_string(i%7) + "\"," + std::to_string((7*i)%n) + ")\n";
+    }
+  }
+
+  lts::lts_aut_t l1;
+  std::istringstream is1(automaton);
+  l1.load(is1);
+  BOOST_CHECK_EQUAL(l1.num_transitions(), n);
+  BOOST_CHECK_EQUAL(l1.num_action_labels(), 1+11+7);
+  BOOST_CHECK_EQUAL(l1.action_label(1), "b(0)");
+
+  lts::lts_aut_t l4;
+  std::istringstream is4(automaton);
+  l4.load(is4, 4);
+  BOOST_CHECK(l1==l4);
+
+  // The probabilistic reader numbers the probabilistic states in the same way with several threads.
+  lts::probabilistic_lts_aut_t p1;
+  std::istringstream is_p1(automaton);
+  p1.load(is_p1);
+  lts::probabilistic_lts_aut_t p4;
+  std::istringstream is_p4(automaton);
+  p4.load(is_p4, 4);
+  BOOST_CHECK(p1==p4);
+
+  // Writing and reading the transition system again gives the same result.
+  const std::string temp_filename = "read_aut_in_parallel.aut";
+  l4.save(temp_filename);
+  lts::lts_aut_t l5;
+  l5.load(temp_filename, 3);
+  std::remove(temp_filename.c_str());
+  BOOST_CHECK(l1==l5);
+
+  // An error is reported at the line in the whole file, also when it is found by another thread.
+  automaton+="(1,\"a\",2" + std::string(n-1, ' ') + "\n";
+  automaton.replace(automaton.find(std::to_string(n) + ","), std::to_string(n).size(), std::to_string(n+1));
+  std::istringstream is_error(automaton);
+  lts::lts_aut_t l_error;
+  try
+  {
+    l_error.load(is_error, 4);
+    BOOST_CHECK(false);
+  }
+  catch (const mcrl2::runtime_error& e)
+  {
+    BOOST_CHECK(std::string(e.what()).find("at line " + std::to_string(n+2) + ".")!=std::string::npos);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(read_aut_separated_by_eot)
+{
+  std::string automata =
+    "des (0,1,2)\n"
+    "(0,\"a\",1)\n"
+    "\x04"
+    "des (1,2,2)\n"
+    "(0,\"b\",1)\n"
+    "(1,tau,0)\n";
+
+  std::istringstream is(automata);
+  lts::lts_aut_t l1;
+  l1.load(is);
+  lts::lts_aut_t l2;
+  l2.load(is);
+  BOOST_CHECK_EQUAL(l1.num_transitions(), 1);
+  BOOST_CHECK_EQUAL(l2.num_transitions(), 2);
+  BOOST_CHECK_EQUAL(l2.initial_state(), 1);
+  BOOST_CHECK_EQUAL(l2.num_action_labels(), 2);
+}
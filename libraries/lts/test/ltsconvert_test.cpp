@@ -775,3 +775,205 @@ BOOST_AUTO_TEST_CASE(test_state_space_reductions)
  }
 }
 
+
+// Generates an lts with n states and a mix of tau transitions and visible transitions, which contains
+// tau loops as well as states that are only bisimilar after several refinement steps.
+static lts_aut_t generate_aut(std::size_t n)
+{
+  std::stringstream aut;
+  std::size_t number_of_transitions = 0;
+  std::stringstream transitions;
+  for (std::size_t s = 0; s < n; ++s)
+  {
+    transitions << "(" << s << ",\"tau\"," << (s * 7 + 1) % n << ")\n";
+    ++number_of_transitions;
+    if (s % 3 == 0)
+    {
+      transitions << "(" << s << ",\"a\"," << (s + 2) % n << ")\n";
+      ++number_of_transitions;
+    }
+    if (s % 5 == 0)
+    {
+      transitions << "(" << s << ",\"b\"," << (s * s) % n << ")\n";
+      ++number_of_transitions;
+    }
+  }
+  aut << "des (0," << number_of_transitions << "," << n << ")\n" << transitions.str();
+  return parse_aut(aut.str());
+}
+
+BOOST_AUTO_TEST_CASE(test_sigref_threads)
+{
+  const std::vector<std::pair<lts_equivalence, lts_equivalence>> equivalences = {
+    { lts_eq_bisim_sigref, lts_eq_bisim },
+    { lts_eq_branching_bisim_sigref, lts_eq_branching_bisim },
+    { lts_eq_divergence_preserving_branching_bisim_sigref, lts_eq_divergence_preserving_branching_bisim }
+  };
+
+  for (const auto& [sigref_equivalence, equivalence]: equivalences)
+  {
+    for (std::size_t n: { 1, 10, 100, 2000 })
+    {
+      lts_aut_t expected = generate_aut(n);
+      reduce(expected, equivalence);
+
+      lts_aut_t sequential = generate_aut(n);
+      reduce(sequential, sigref_equivalence);
+      BOOST_CHECK_EQUAL(sequential.num_states(), expected.num_states());
+      BOOST_CHECK_EQUAL(sequential.num_transitions(), expected.num_transitions());
+
+      // The numbering of the blocks does not depend on the number of threads.
+      lts_aut_t parallel = generate_aut(n);
+      reduce(parallel, sigref_equivalence, 4);
+      BOOST_CHECK_EQUAL(parallel.num_states(), sequential.num_states());
+      BOOST_CHECK(parallel.get_transitions() == sequential.get_transitions());
+      BOOST_CHECK_EQUAL(parallel.initial_state(), sequential.initial_state());
+    }
+  }
+}
+
+// Generates an lts with n states in which the tau transitions form loops, with chains of tau transitions
+// between them and towards them. 
+static lts_aut_t generate_tau_chains_aut(std::size_t n)
+{
+  std::stringstream aut;
+  aut << "des (0," << 2 * n << "," << n << ")\n";
+  for (std::size_t s = 0; s < n; ++s)
+  {
+    aut << "(" << s << ",\"tau\"," << (s * s + 1) % n << ")\n";
+    aut << "(" << s << ",\"" << (s % 10 == 0 ? "tau" : "a") << "\"," << (s + 1) % n << ")\n";
+  }
+  return parse_aut(aut.str());
+}
+
+// Generates an lts with levels of width states without tau cycles. Every state above the lowest level has a tau
+// transition to a state of the level below it, so a level contains the states whose longest tau path has its index
+// as length.
+static lts_aut_t generate_tau_levels_aut(std::size_t levels, std::size_t width)
+{
+  const std::size_t n = levels * width;
+  std::size_t number_of_transitions = 0;
+  std::stringstream transitions;
+  for (std::size_t s = 0; s < n; ++s)
+  {
+    if (s >= width)
+    {
+      transitions << "(" << s << ",\"tau\"," << (s / width - 1) * width + (s * 7 + 3) % width << ")\n";
+      ++number_of_transitions;
+    }
+    if (s % 3 == 0)
+    {
+      transitions << "(" << s << ",\"a\"," << (s * s) % n << ")\n";
+      ++number_of_transitions;
+    }
+    if (s % 5 == 0)
+    {
+      transitions << "(" << s << ",\"b\"," << (s + width + 1) % n << ")\n";
+      ++number_of_transitions;
+    }
+  }
+  std::stringstream aut;
+  aut << "des (0," << number_of_transitions << "," << n << ")\n" << transitions.str();
+  return parse_aut(aut.str());
+}
+
+BOOST_AUTO_TEST_CASE(test_scc_threads)
+{
+  for (std::size_t n: { 1, 10, 100, 2000, 20000 })
+  {
+    for (lts_aut_t l: { generate_aut(n), generate_tau_chains_aut(n) })
+    {
+      detail::scc_partitioner<lts_aut_t> sequential(l);
+      detail::scc_partitioner<lts_aut_t> parallel(l, 4);
+
+      // The partitions are equal, but the components can be numbered differently.
+      BOOST_CHECK_EQUAL(parallel.num_eq_classes(), sequential.num_eq_classes());
+      std::vector<std::size_t> renumbering(sequential.num_eq_classes(), l.num_states());
+      for (std::size_t s = 0; s < l.num_states(); ++s)
+      {
+        std::size_t& c = renumbering[sequential.get_eq_class(s)];
+        if (c == l.num_states())
+        {
+          c = parallel.get_eq_class(s);
+        }
+        BOOST_CHECK_EQUAL(c, parallel.get_eq_class(s));
+      }
+    }
+  }
+
+  for (lts_equivalence equivalence: { lts_eq_branching_bisim, lts_eq_divergence_preserving_branching_bisim, lts_red_tau_star })
+  {
+    lts_aut_t sequential = generate_aut(2000);
+    reduce(sequential, equivalence);
+    lts_aut_t parallel = generate_aut(2000);
+    reduce(parallel, equivalence, 4);
+    BOOST_CHECK_EQUAL(parallel.num_states(), sequential.num_states());
+    BOOST_CHECK_EQUAL(parallel.num_transitions(), sequential.num_transitions());
+  }
+
+  // An exception in one of the threads is rethrown by the calling thread.
+  BOOST_CHECK_THROW(detail::scc_parallel_for(100000, 4, [](std::size_t first, std::size_t)
+    {
+      if (first == 50 * detail::scc_chunk_size)
+      {
+        throw mcrl2::runtime_error("Failure in a thread.");
+      }
+    }), mcrl2::runtime_error);
+}
+
+// The inert signatures of branching bisimulation are computed level by level over the chains of tau transitions.
+BOOST_AUTO_TEST_CASE(test_sigref_threads_tau_chains)
+{
+  const std::vector<std::pair<lts_equivalence, lts_equivalence>> equivalences = {
+    { lts_eq_bisim_sigref, lts_eq_bisim },
+    { lts_eq_branching_bisim_sigref, lts_eq_branching_bisim },
+    { lts_eq_divergence_preserving_branching_bisim_sigref, lts_eq_divergence_preserving_branching_bisim }
+  };
+
+  for (const auto& [sigref_equivalence, equivalence]: equivalences)
+  {
+    for (std::size_t n: { 1, 10, 100, 2000, 20000 })
+    {
+      lts_aut_t expected = generate_tau_chains_aut(n);
+      reduce(expected, equivalence);
+
+      lts_aut_t sequential = generate_tau_chains_aut(n);
+      reduce(sequential, sigref_equivalence);
+      BOOST_CHECK_EQUAL(sequential.num_states(), expected.num_states());
+      BOOST_CHECK_EQUAL(sequential.num_transitions(), expected.num_transitions());
+
+      // The numbering of the blocks does not depend on the number of threads.
+      lts_aut_t parallel = generate_tau_chains_aut(n);
+      reduce(parallel, sigref_equivalence, 4);
+      BOOST_CHECK_EQUAL(parallel.num_states(), sequential.num_states());
+      BOOST_CHECK(parallel.get_transitions() == sequential.get_transitions());
+      BOOST_CHECK_EQUAL(parallel.initial_state(), sequential.initial_state());
+    }
+  }
+}
+
+// Without tau cycles the inert signatures of all states of a level are computed by multiple threads.
+BOOST_AUTO_TEST_CASE(test_sigref_threads_tau_levels)
+{
+  const std::vector<std::pair<lts_equivalence, lts_equivalence>> equivalences = {
+    { lts_eq_branching_bisim_sigref, lts_eq_branching_bisim },
+    { lts_eq_divergence_preserving_branching_bisim_sigref, lts_eq_divergence_preserving_branching_bisim }
+  };
+
+  for (const auto& [sigref_equivalence, equivalence]: equivalences)
+  {
+    lts_aut_t expected = generate_tau_levels_aut(5, 2000);
+    reduce(expected, equivalence);
+
+    lts_aut_t sequential = generate_tau_levels_aut(5, 2000);
+    reduce(sequential, sigref_equivalence);
+    BOOST_CHECK_EQUAL(sequential.num_states(), expected.num_states());
+    BOOST_CHECK_EQUAL(sequential.num_transitions(), expected.num_transitions());
+
+    lts_aut_t parallel = generate_tau_levels_aut(5, 2000);
+    reduce(parallel, sigref_equivalence, 4);
+    BOOST_CHECK_EQUAL(parallel.num_states(), sequential.num_states());
+    BOOST_CHECK(parallel.get_transitions() == sequential.get_transitions());
+    BOOST_CHECK_EQUAL(parallel.initial_state(), sequential.initial_state());
+  }
+}
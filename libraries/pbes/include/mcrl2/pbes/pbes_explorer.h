@@ -13,6 +13,7 @@
 
 #define PBES_EXPLORER_VERSION 1
 
+#include <unordered_map>
 #include "mcrl2/pbes/detail/pbes_greybox_interface.h"
 #include "mcrl2/pbes/detail/ppg_rewriter.h"
 #include "mcrl2/pbes/detail/ppg_traverser.h"
@@ -123,7 +124,8 @@ public:
 
 private:
     int priority; // Priority (depends on fixpoint operator and equation order)
-    std::string var; // Propositional variable name
+    core::identifier_string var; // Propositional variable name
+    int var_index; // Index of the propositional variable in the tables of lts_info, or -1 if not yet known
     operation_type type; // player or type (And/Or, Abelard/Eloise, Odd/Even)
     std::vector<data_expression> param_values; // List of parameter values
 
@@ -131,7 +133,12 @@ protected:
     /// \brief Constructor.
     /// \param varname the propositional variable of the state.
     /// \param e a propositional variable instantiation.
-    ltsmin_state(const std::string& varname, const pbes_expression& e);
+    ltsmin_state(const core::identifier_string& varname, const pbes_expression& e);
+
+    /// \brief Constructor for a state without parameter values.
+    /// \param varname the propositional variable of the state.
+    /// \param index the index of varname in the tables of lts_info.
+    ltsmin_state(const core::identifier_string& varname, int index);
 
     /// \brief Returns the list of parameter values.
     const std::vector<data_expression>& get_parameter_values() const;
@@ -147,16 +154,16 @@ public:
     /// \param varname the name of the propositional variable of the state.
     ltsmin_state(const std::string& varname);
 
-    /// \brief Compares two PBES_State objects. Uses lexicographical ordering on priority, type, variable and parameter values.
+    /// \brief Compares two PBES_State objects. Uses lexicographical ordering on the index of the variable,
+    /// the variable name (only if the index is not known) and the parameter values.
     /// \param other an other PBES_State object.
-    /// \return true if this.priority < other.priority || (this.priority==other.priority && (this.type < other.type ||
-    ///   (this.type==other.type && this.var < other.var || (this.var==other.var && this.param_values < other.param_values) ) ) ).
+    /// \return true if this.var_index < other.var_index || (this.var_index==other.var_index && (this.var < other.var ||
+    ///   (this.var==other.var && this.param_values < other.param_values) ) ).
     bool operator<( const ltsmin_state& other ) const;
 
     /// \brief Checks if two PBES_State objects are equal.
     /// \param other an other PBES_State object.
-    /// \return true if this.priority==other.priority && this.type==other.type && this.var==other.var
-    /// && param_values==param_values.
+    /// \return true if this.var_index==other.var_index && this.var==other.var && param_values==param_values.
     bool operator==( const ltsmin_state& other ) const;
 
     /// \brief Returns the priority for the state, which depends on the fixpoint operator of
@@ -211,6 +218,16 @@ private:
     std::map<std::string, std::vector<int> > variable_parameter_indices;
     std::map<std::string, std::map<int,int> > variable_parameter_index_positions;
 
+    // The same information as above, indexed by the number of the propositional variable.
+    // These tables are used when computing successors, to avoid lookups by variable name.
+    std::unordered_map<core::identifier_string, int> variable_index;
+    std::vector<core::identifier_string> indexed_variable_identifiers;
+    std::vector<std::string> indexed_variable_names;
+    std::vector<operation_type> indexed_variable_types;
+    std::vector<std::vector<int> > indexed_variable_parameter_indices;
+    std::vector<std::vector<int> > indexed_variable_parameter_positions;
+    std::vector<int> transition_variable_index;
+
     static std::map<variable,std::string> variable_signatures;
 
     /// \brief Counts the number of propositional variables in an expression.
@@ -234,6 +251,11 @@ private:
     /// \brief Computes LTS Type from PBES.
     void compute_lts_type();
 
+    /// \brief Adds a propositional variable to the tables that are indexed by variable number.
+    /// \param var the propositional variable.
+    /// \param var_type the operation type of the equation for the variable.
+    void add_indexed_variable(const propositional_variable& var, operation_type var_type);
+
     /// \brief Computes transition groups from PBES.
     void compute_transition_groups();
 
@@ -369,6 +391,38 @@ public:
     /// (in the list of types for the system).
     const std::map<std::string, std::map<int,int> >& get_variable_parameter_index_positions() const;
 
+    /// \brief Returns the number of propositional variables, including <tt>true</tt> and <tt>false</tt>,
+    /// which have index 0 and 1 respectively.
+    int get_number_of_variables() const;
+
+    /// \brief Returns the index of the propositional variable with name <tt>name</tt>, or -1 if it does not exist.
+    /// \param name the name of a propositional variable.
+    int get_variable_index(const core::identifier_string& name) const;
+
+    /// \brief Returns the index of the propositional variable with name <tt>name</tt>, or -1 if it does not exist.
+    /// \param name the name of a propositional variable.
+    int get_variable_index(const std::string& name) const;
+
+    /// \brief Returns the name of the propositional variable with index <tt>var_index</tt>.
+    const std::string& get_variable_name(int var_index) const;
+
+    /// \brief Returns the name of the propositional variable with index <tt>var_index</tt> as identifier string.
+    const core::identifier_string& get_variable_identifier(int var_index) const;
+
+    /// \brief Returns the type of the right hand side of the equation for the variable with index <tt>var_index</tt>.
+    operation_type get_variable_type(int var_index) const;
+
+    /// \brief Returns the indices of the parameter signatures of the variable with index <tt>var_index</tt>
+    /// according the order in the list of parameter signatures for the system.
+    const std::vector<int>& get_variable_parameter_indices(int var_index) const;
+
+    /// \brief Returns the position of the parameter signature with index <tt>param_index</tt> in the parameter
+    /// list of the variable with index <tt>var_index</tt>, or -1 if the variable does not have this parameter.
+    int get_variable_parameter_position(int var_index, int param_index) const;
+
+    /// \brief Returns the index of the variable of the equation to which transition group <tt>group</tt> belongs.
+    int get_transition_variable_index(int group) const;
+
     /// \brief Returns the LTS Type.
     const lts_type& get_lts_type() const;
 
@@ -441,7 +495,9 @@ private:
     lts_info* info;
     std::map<std::string,int> localmap_string2int;
     std::vector<std::string> localmap_int2string;
-    std::vector<std::map<data_expression,int> > localmaps_data2int;
+    std::vector<int> localmap_int2variable; // Variable index for each string value, or -1 if it is not a variable
+    std::vector<int> localmap_variable2int; // String index for each variable, or -1 if it is not stored yet
+    std::vector<std::unordered_map<data_expression,int> > localmaps_data2int;
     std::vector<std::vector<data_expression> > localmaps_int2data;
 
 protected:
@@ -475,6 +531,19 @@ protected:
     /// \return the value at position <tt>index</tt> in local store <tt>type_no</tt>.
     const data_expression& get_data_value(int type_no, int index);
 
+    /// \brief Returns the index of the variable of <tt>state</tt> in the tables of lts_info.
+    /// An exception is thrown if the variable does not exist.
+    int get_variable_index(const ltsmin_state& state) const;
+
+    /// \brief Returns the index in the local store for string values of the variable with
+    /// index <tt>var_index</tt>. The name of the variable is added to the store if it is not already present.
+    int get_variable_string_index(int var_index);
+
+    /// \brief Returns the index of the variable that is stored at position <tt>index</tt> in the local store
+    /// for string values, or -1 if that string is not a variable.
+    /// An exception is thrown if the index does not exist in the store.
+    int get_string_variable_index(int index) const;
+
     /// \brief the PBES greybox interface
     detail::pbes_greybox_interface* pgg;
 
@@ -616,9 +685,7 @@ public:
         void next_state_long(int* const& src, int group, callback& cb)
     {
         int state_length = this->info->get_lts_type().get_state_length();
-        std::string group_varname = info->get_transition_variable_names()[group];
-        std::string varname = this->get_string_value(src[0]);
-        if (varname==group_varname)
+        if (this->get_string_variable_index(src[0])==info->get_transition_variable_index(group))
         {
             ltsmin_state state = this->from_state_vector(src);
             std::vector<ltsmin_state> successors = this->get_successors(state, group);
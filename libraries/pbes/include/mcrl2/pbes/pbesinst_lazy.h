@@ -9,6 +9,9 @@
 /// \file mcrl2/pbes/pbesinst_lazy_algorithm.h
 /// \brief A lazy algorithm for instantiating a PBES, ported from bes_deprecated.h.
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <shared_mutex>
@@ -137,8 +140,8 @@ class pbesinst_lazy_todo
 
     void set_todo(atermpp::deque<propositional_variable_instantiation>& new_todo)
     {
-      using utilities::detail::contains;
       std::size_t size_before = todo.size() + irrelevant.size();
+      const std::unordered_set<propositional_variable_instantiation> new_todo_elements(new_todo.begin(), new_todo.end());
       std::unordered_set<propositional_variable_instantiation> new_irrelevant;
       /* for (const propositional_variable_instantiation& x: all_elements()) The range::join of boost does not seem to work with GCC. 
  *                                                                           Therefore it is split below. 
@@ -150,14 +153,14 @@ class pbesinst_lazy_todo
       } */
       for (const propositional_variable_instantiation& x: todo)
       {
-        if (!contains(new_todo, x))
+        if (new_todo_elements.count(x) == 0)
         {
           new_irrelevant.insert(x);
         }
       } 
       for (const propositional_variable_instantiation& x: irrelevant)
       {
-        if (!contains(new_todo, x))
+        if (new_todo_elements.count(x) == 0)
         {
           new_irrelevant.insert(x);
         }
@@ -212,6 +215,24 @@ class pbesinst_lazy_algorithm
     /// \brief The rewriter.
     enumerate_quantifiers_rewriter m_global_R;
 
+    /// \brief A todo queue that is owned by a single thread. Other threads only take elements
+    ///        from it when their own queue is empty.
+    struct thread_todo
+    {
+      std::mutex access;
+      atermpp::deque<propositional_variable_instantiation> elements;
+    };
+
+    /// \brief The todo queues of the threads, which are only used if the shared todo set is not needed.
+    std::vector<std::unique_ptr<thread_todo>> m_thread_todos;
+
+    /// \brief The total number of elements in the todo queues of the threads.
+    std::atomic<std::size_t> m_thread_todo_count{0};
+
+    /// \brief Idle threads wait on this condition variable until work becomes available or the exploration ends.
+    std::mutex m_idle_access;
+    std::condition_variable m_idle_condition;
+
     // Mutexes
     std::mutex m_todo_access;
     std::shared_mutex m_graph_access;
@@ -374,6 +395,169 @@ class pbesinst_lazy_algorithm
       return false;
     }
 
+    /// \brief Returns true if the algorithm must maintain a single todo set for all threads. This is
+    ///        needed by the optimisations that inspect or modify the todo set.
+    bool uses_shared_todo() const
+    {
+      return m_options.number_of_threads == 1 || m_options.optimization >= 7 || m_options.prune_todo_list;
+    }
+
+    // Takes an element from the todo queue of the given thread, or steals one from the other threads
+    // if this queue is empty. Returns false if no element was found.
+    bool next_thread_todo(const std::size_t thread_index, propositional_variable_instantiation& result)
+    {
+      {
+        thread_todo& own = *m_thread_todos[thread_index - 1];
+        std::lock_guard<std::mutex> guard(own.access);
+        if (!own.elements.empty())
+        {
+          if (m_options.exploration_strategy == breadth_first)
+          {
+            result = own.elements.front();
+            own.elements.pop_front();
+          }
+          else
+          {
+            result = own.elements.back();
+            own.elements.pop_back();
+          }
+          m_thread_todo_count--;
+          return true;
+        }
+      }
+
+      // Steal the oldest element of another thread, starting with the next thread.
+      const std::size_t number_of_threads = m_thread_todos.size();
+      for (std::size_t i = 1; i < number_of_threads; ++i)
+      {
+        thread_todo& other = *m_thread_todos[(thread_index - 1 + i) % number_of_threads];
+        std::lock_guard<std::mutex> guard(other.access);
+        if (!other.elements.empty())
+        {
+          result = other.elements.front();
+          other.elements.pop_front();
+          m_thread_todo_count--;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Wakes up the idle threads. The idle mutex is taken such that a thread that is about to wait
+    // cannot miss the notification.
+    void wake_idle_threads()
+    {
+      {
+        std::lock_guard<std::mutex> guard(m_idle_access);
+      }
+      m_idle_condition.notify_all();
+    }
+
+    /// \brief The exploration of a single thread when each thread has its own todo queue. Only the
+    ///        reporting of equations is done under a global lock; new elements are claimed through the
+    ///        thread safe set of discovered elements and pushed on the queue of this thread.
+    void run_thread_with_work_stealing(const std::size_t thread_index,
+                                       std::atomic<std::size_t>& number_of_active_processes,
+                                       data::mutable_indexed_substitution<> sigma,
+                                       enumerate_quantifiers_rewriter R
+                                      )
+    {
+      mCRL2log(log::debug) << "Start thread " << thread_index << ".\n";
+      R.thread_initialise();
+
+      propositional_variable_instantiation X_e;
+      pbes_expression psi_e;
+      thread_todo& own = *m_thread_todos[thread_index - 1];
+
+      while (!m_must_abort)
+      {
+        if (!next_thread_todo(thread_index, X_e))
+        {
+          // This thread becomes idle. It terminates when all threads are idle and there is no
+          // work left, and becomes active again as soon as some queue contains work.
+          {
+            std::unique_lock<std::mutex> lock(m_idle_access);
+            if (--number_of_active_processes == 0)
+            {
+              m_idle_condition.notify_all();
+            }
+            m_idle_condition.wait(lock, [&]()
+              {
+                return m_must_abort || m_thread_todo_count > 0 || number_of_active_processes == 0;
+              });
+            // The todo count is decreased without holding the idle mutex, so a thread that observes
+            // no work while other threads are active still tries again to obtain work.
+            if (m_must_abort || (number_of_active_processes == 0 && m_thread_todo_count == 0))
+            {
+              break;
+            }
+            number_of_active_processes++;
+          }
+          continue;
+        }
+
+        std::size_t index = m_equation_index.index(X_e.name());
+        const pbes_equation& eqn = m_pbes.equations()[index];
+        const auto& phi = eqn.formula();
+        data::add_assignments(sigma, eqn.variable().parameters(), X_e.parameters());
+        R(psi_e, phi, sigma);
+        R.clear_identifier_generator();
+        data::remove_assignments(sigma, eqn.variable().parameters());
+
+        // optional step
+        m_graph_access.lock_shared();
+        rewrite_psi(thread_index, psi_e, eqn.symbol(), X_e, psi_e);
+        m_graph_access.unlock_shared();
+
+        std::set<propositional_variable_instantiation> occ = find_propositional_variable_instantiations(psi_e);
+
+        // report the generated equation
+        std::size_t k = m_equation_index.rank(X_e.name());
+        {
+          std::lock_guard<std::mutex> guard(m_todo_access);
+          ++m_iteration_count;
+          mCRL2log(log::status) << status_message(m_iteration_count);
+          detail::check_bes_equation_limit(m_iteration_count);
+
+          mCRL2log(log::debug) << "generated equation " << X_e << " = " << psi_e
+                               << " with rank " << k << std::endl;
+          on_report_equation(thread_index, m_graph_access, X_e, psi_e, k);
+          m_graph_access.lock();
+          on_discovered_elements(occ);
+          m_graph_access.unlock();
+
+          if (solution_found(init))
+          {
+            m_must_abort = true;
+          }
+        }
+        if (m_must_abort)
+        {
+          wake_idle_threads();
+          break;
+        }
+
+        // Only the thread that inserts an element in discovered puts it in its todo queue.
+        bool pushed = false;
+        for (const propositional_variable_instantiation& Y: occ)
+        {
+          if (discovered.insert(Y, thread_index).second)
+          {
+            std::lock_guard<std::mutex> guard(own.access);
+            own.elements.push_back(Y);
+            m_thread_todo_count++;
+            pushed = true;
+          }
+        }
+        if (pushed && number_of_active_processes < m_thread_todos.size())
+        {
+          wake_idle_threads();
+        }
+      }
+
+      mCRL2log(log::debug) << "Stop thread " << thread_index << ".\n";
+    }
+
     virtual void run_thread(const std::size_t thread_index,
                             pbesinst_lazy_todo& todo,
                             std::atomic<std::size_t>& number_of_active_processes,
@@ -427,7 +611,10 @@ class pbesinst_lazy_algorithm
           {
             discovered.insert(*i, thread_index);
           }
+          // The optimisations in on_discovered_elements may modify data that is read in rewrite_psi.
+          m_graph_access.lock();
           on_discovered_elements(occ);
+          m_graph_access.unlock();
 
           if (solution_found(init))
           {
@@ -468,21 +655,48 @@ class pbesinst_lazy_algorithm
       }
 
       init = atermpp::down_cast<propositional_variable_instantiation>(m_global_R(m_pbes.initial_state(), sigma));
-      todo.insert(init);
       discovered.insert(init, initialisation_thread_index);
 
+      if (uses_shared_todo())
+      {
+        todo.insert(init);
+      }
+      else
+      {
+        // The queues are created by the main thread, such that their elements remain protected
+        // after the threads have terminated.
+        m_thread_todos.clear();
+        for (std::size_t i = 1; i <= number_of_threads; ++i)
+        {
+          m_thread_todos.push_back(std::make_unique<thread_todo>());
+        }
+        m_thread_todos.front()->elements.push_back(init);
+        m_thread_todo_count = 1;
+      }
+
       if (number_of_threads>1)
       {
         threads.reserve(number_of_threads);
         for (std::size_t i = 1; i <= number_of_threads; ++i)
         {
           std::thread tr([&, i](){
-            run_thread(i,
-                       todo,
-                       number_of_active_processes,
-                       sigma.clone(),
-                       m_global_R.clone()
-                      );
+            if (uses_shared_todo())
+            {
+              run_thread(i,
+                         todo,
+                         number_of_active_processes,
+                         sigma.clone(),
+                         m_global_R.clone()
+                        );
+            }
+            else
+            {
+              run_thread_with_work_stealing(i,
+                                            number_of_active_processes,
+                                            sigma.clone(),
+                                            m_global_R.clone()
+                                           );
+            }
           });
           threads.push_back(std::move(tr));
         }
@@ -503,6 +717,7 @@ class pbesinst_lazy_algorithm
                    m_global_R
                   );
       }
+      m_thread_todos.clear();
       on_end_while_loop();
     }
 
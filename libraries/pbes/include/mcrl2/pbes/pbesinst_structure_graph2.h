@@ -534,6 +534,9 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
     {
       super::on_report_equation(thread_index, realloc_mutex, X, psi, k);
 
+      // S[0] and S[1] are read by other threads in rewrite_psi, so they are only modified under an exclusive lock.
+      std::unique_lock<std::shared_mutex> guard(realloc_mutex);
+
       // The structure graph has just been extended, so S[0] and S[1] need to be resized.
       S[0].resize(m_graph_builder.extent());
       S[1].resize(m_graph_builder.extent());
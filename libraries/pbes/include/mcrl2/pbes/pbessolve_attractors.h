@@ -12,6 +12,12 @@
 #ifndef MCRL2_PBES_PBESSOLVE_ATTRACTORS_H
 #define MCRL2_PBES_PBESSOLVE_ATTRACTORS_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include "mcrl2/pbes/pbessolve_vertex_set.h"
 
 namespace mcrl2 {
@@ -184,6 +190,250 @@ vertex_set attr_default_with_tau(const StructureGraph& G, vertex_set A, std::siz
   return attr_default_generic(G, A, alpha, global_local_strategy<StructureGraph>(G, tau, alpha));
 }
 
+namespace detail {
+
+/// \brief A fixed set of threads that repeatedly apply a function to consecutive parts of [0, n).
+///        The threads are started once, and wait on a condition variable in between.
+class parallel_for_workers
+{
+  protected:
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_finished;
+    std::function<void(std::size_t, std::size_t)> m_function;
+    std::size_t m_n = 0;
+    std::size_t m_number_of_parts = 0;
+    std::size_t m_generation = 0;
+    std::size_t m_busy = 0;
+    bool m_stop = false;
+
+    // The work of the worker that handles part i of every job.
+    void work(std::size_t i)
+    {
+      std::size_t generation = 0;
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (true)
+      {
+        m_start.wait(lock, [&]() { return m_stop || m_generation != generation; });
+        if (m_stop)
+        {
+          return;
+        }
+        generation = m_generation;
+        if (i < m_number_of_parts)
+        {
+          const std::size_t first = (m_n * i) / m_number_of_parts;
+          const std::size_t last = (m_n * (i + 1)) / m_number_of_parts;
+          lock.unlock();
+          m_function(first, last);
+          lock.lock();
+          if (--m_busy == 0)
+          {
+            m_finished.notify_one();
+          }
+        }
+      }
+    }
+
+  public:
+    /// \brief Constructor. The calling thread is one of the number_of_threads threads.
+    explicit parallel_for_workers(std::size_t number_of_threads)
+    {
+      for (std::size_t i = 1; i < number_of_threads; ++i)
+      {
+        m_threads.emplace_back([this, i]() { work(i); });
+      }
+    }
+
+    parallel_for_workers(const parallel_for_workers&) = delete;
+    parallel_for_workers& operator=(const parallel_for_workers&) = delete;
+
+    ~parallel_for_workers()
+    {
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stop = true;
+      }
+      m_start.notify_all();
+      for (std::thread& t: m_threads)
+      {
+        t.join();
+      }
+    }
+
+    /// \brief The number of threads, including the calling thread.
+    std::size_t size() const
+    {
+      return m_threads.size() + 1;
+    }
+
+    /// \brief Calls f(first, last) for number_of_parts consecutive parts of [0, n). The first part is
+    ///        handled by the calling thread, and the others by the workers.
+    /// \pre number_of_parts <= size()
+    template <typename Function>
+    void run(std::size_t n, std::size_t number_of_parts, Function f)
+    {
+      assert(number_of_parts <= size());
+      if (number_of_parts <= 1)
+      {
+        f(0, n);
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_function = f;
+        m_n = n;
+        m_number_of_parts = number_of_parts;
+        m_busy = number_of_parts - 1;
+        ++m_generation;
+      }
+      m_start.notify_all();
+      f(0, n / number_of_parts);
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_finished.wait(lock, [&]() { return m_busy == 0; });
+    }
+};
+
+} // namespace detail
+
+// Computes attractor sets using multiple threads. An attractor is computed layer by layer, and the vertices
+// of a layer are divided over the threads. Every vertex that does not belong to player alpha has an atomic
+// counter of its successors outside the attractor, and is added to the attractor by the thread that decrements
+// this counter to zero. Layers with fewer than minimum_part_size vertices per thread are handled by the
+// calling thread only.
+//
+// The worker threads and the per vertex data are reused between calls. The per vertex data is stamped with
+// the number of the call, such that only vertices that are reached backwards from A are initialised.
+// The strategies are stored in the vertices of G, as with attr_default.
+class parallel_attractor
+{
+  protected:
+    using index_type = structure_graph::index_type;
+
+    std::size_t m_minimum_part_size;
+    detail::parallel_for_workers m_workers;
+
+    // m_in_attractor[u] == m_epoch iff u is in the attractor that is being computed.
+    std::vector<std::atomic<std::uint32_t>> m_in_attractor;
+
+    // The upper half of m_remaining[u] is the epoch in which the lower half, which is the number of
+    // successors of u outside the attractor, was initialised.
+    std::vector<std::atomic<std::uint64_t>> m_remaining;
+
+    std::uint32_t m_epoch = 0;
+    std::vector<index_type> m_layer;
+    std::vector<std::vector<index_type>> m_next_layers;
+
+    std::size_t number_of_parts(std::size_t n) const
+    {
+      return std::max(std::size_t(1), std::min(m_workers.size(), n / std::max(std::size_t(1), m_minimum_part_size)));
+    }
+
+    // Prepares the per vertex data for a new attractor computation in a graph with N vertices.
+    void start_epoch(std::size_t N)
+    {
+      if (m_in_attractor.size() < N)
+      {
+        std::vector<std::atomic<std::uint32_t>>(N).swap(m_in_attractor);
+        std::vector<std::atomic<std::uint64_t>>(N).swap(m_remaining);
+        m_epoch = 0;
+      }
+      if (++m_epoch == 0)
+      {
+        // All stamps are reset when the epoch wraps around.
+        for (std::size_t u = 0; u < m_in_attractor.size(); ++u)
+        {
+          m_in_attractor[u].store(0, std::memory_order_relaxed);
+          m_remaining[u].store(0, std::memory_order_relaxed);
+        }
+        m_epoch = 1;
+      }
+    }
+
+    // Decrements the number of successors of v outside the attractor, and returns true if it becomes zero.
+    bool decrement_remaining(const structure_graph& G, index_type v)
+    {
+      const std::uint64_t epoch = std::uint64_t(m_epoch) << 32;
+      std::uint64_t word = m_remaining[v].load();
+      while (true)
+      {
+        std::uint64_t count;
+        if ((word & ~std::uint64_t(0xffffffff)) == epoch)
+        {
+          count = word & 0xffffffff;
+        }
+        else
+        {
+          auto successors = G.successors(v);
+          count = static_cast<std::uint64_t>(std::distance(successors.begin(), successors.end()));
+        }
+        if (m_remaining[v].compare_exchange_weak(word, epoch | (count - 1)))
+        {
+          return count == 1;
+        }
+      }
+    }
+
+  public:
+    parallel_attractor(std::size_t number_of_threads, std::size_t minimum_part_size = 1024)
+      : m_minimum_part_size(minimum_part_size),
+        m_workers(number_of_threads),
+        m_next_layers(number_of_threads)
+    {}
+
+    // Computes an attractor set, by extending A.
+    // alpha = 0: disjunctive
+    // alpha = 1: conjunctive
+    vertex_set operator()(const structure_graph& G, vertex_set A, std::size_t alpha)
+    {
+      start_epoch(G.extent());
+      for (index_type u: A.vertices())
+      {
+        m_in_attractor[u].store(m_epoch, std::memory_order_relaxed);
+      }
+
+      m_layer.assign(A.vertices().begin(), A.vertices().end());
+      while (!m_layer.empty())
+      {
+        std::atomic<std::size_t> next_part = 0;
+        m_workers.run(m_layer.size(), number_of_parts(m_layer.size()), [&](std::size_t first, std::size_t last)
+          {
+            std::vector<index_type>& next_layer = m_next_layers[next_part++];
+            for (std::size_t i = first; i < last; ++i)
+            {
+              index_type u = m_layer[i];
+              for (index_type v: G.predecessors(u))
+              {
+                if (m_in_attractor[v].load(std::memory_order_relaxed) == m_epoch)
+                {
+                  continue;
+                }
+                if ((G.decoration(v) == alpha || decrement_remaining(G, v)) && m_in_attractor[v].exchange(m_epoch) != m_epoch)
+                {
+                  G.find_vertex(v).strategy = u;
+                  next_layer.push_back(v);
+                }
+              }
+            }
+          });
+
+        m_layer.clear();
+        for (std::vector<index_type>& next_layer: m_next_layers)
+        {
+          for (index_type v: next_layer)
+          {
+            A.insert(v);
+          }
+          m_layer.insert(m_layer.end(), next_layer.begin(), next_layer.end());
+          next_layer.clear();
+        }
+      }
+
+      return A;
+    }
+};
+
 } // namespace pbes_system
 
 } // namespace mcrl2
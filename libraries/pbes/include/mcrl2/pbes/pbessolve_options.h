@@ -39,6 +39,9 @@ struct pbessolve_options
   bool prune_todo_alternative = false;
 
   std::size_t number_of_threads = 1;
+
+  // the number of threads that is used to compute attractors when solving the structure graph
+  std::size_t solve_threads = 1;
 };
 
 inline
@@ -54,6 +57,7 @@ std::ostream& operator<<(std::ostream& out, const pbessolve_options& options)
   out << "check-strategy = " << std::boolalpha << options.check_strategy << std::endl;
   out << "prune-todo-alternative = " << std::boolalpha << options.prune_todo_alternative << std::endl;
   out << "threads = " << options.number_of_threads << std::endl;
+  out << "solve-threads = " << options.solve_threads << std::endl;
   return out;
 }
 
@@ -60,12 +60,12 @@ class simple_structure_graph
       return m_vertices;
     }
 
-    const std::vector<index_type>& predecessors(index_type u) const
+    const structure_graph::edge_list& predecessors(index_type u) const
     {
       return find_vertex(u).predecessors;
     }
 
-    const std::vector<index_type>& successors(index_type u) const
+    const structure_graph::edge_list& successors(index_type u) const
     {
       return find_vertex(u).successors;
     }
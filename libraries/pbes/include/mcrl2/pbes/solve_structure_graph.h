@@ -79,6 +79,22 @@ class solve_structure_graph_algorithm
 
     bool use_toms_optimization = false;
 
+    // the number of threads that is used to compute attractor sets
+    std::size_t number_of_threads = 1;
+
+    // computes attractor sets if more than one thread is used; its threads are reused between calls
+    std::shared_ptr<parallel_attractor> m_parallel_attractor;
+
+    // computes an attractor set, in parallel if more than one thread is used
+    vertex_set attractor(const structure_graph& G, const vertex_set& A, std::size_t alpha) const
+    {
+      if (m_parallel_attractor)
+      {
+        return (*m_parallel_attractor)(G, A, alpha);
+      }
+      return attr_default(G, A, alpha);
+    }
+
     // find a successor of u
     static structure_graph::index_type succ(const structure_graph& G, structure_graph::index_type u)
     {
@@ -172,14 +188,14 @@ class solve_structure_graph_algorithm
       vertex_set W[2]   = { vertex_set(N), vertex_set(N) };
       vertex_set W_1[2];
 
-      vertex_set A = attr_default(G, U, alpha);
+      vertex_set A = attractor(G, U, alpha);
       std::tie(W_1[0], W_1[1]) = solve_recursive(G, A);
 
       if (use_toms_optimization)
       {
         // More efficient than Zielonka, because some recursive calls are skipped.
         // As a consequence, the computed strategy may be wrong.
-        vertex_set B = attr_default(G, W_1[1 - alpha], 1 - alpha);
+        vertex_set B = attractor(G, W_1[1 - alpha], 1 - alpha);
         if (W_1[1 - alpha].size() == B.size())
         {
           W[alpha] = set_union(A, W_1[alpha]);
@@ -201,7 +217,7 @@ class solve_structure_graph_algorithm
          }
          else
          {
-           vertex_set B = attr_default(G, W_1[1 - alpha], 1 - alpha);
+           vertex_set B = attractor(G, W_1[1 - alpha], 1 - alpha);
            std::tie(W[0], W[1]) = solve_recursive(G, B);
            W[1 - alpha] = set_union(W[1 - alpha], B);
          }
@@ -245,11 +261,11 @@ class solve_structure_graph_algorithm
       // extend Vconj and Vdisj
       if (!Vconj.is_empty())
       {
-        Vconj = attr_default(G, Vconj, 1);
+        Vconj = attractor(G, Vconj, 1);
       }
       if (!Vdisj.is_empty())
       {
-        Vdisj = attr_default(G, Vdisj, 0);
+        Vdisj = attractor(G, Vdisj, 0);
       }
 
       // default case
@@ -357,10 +373,16 @@ class solve_structure_graph_algorithm
     }
 
   public:
-    explicit solve_structure_graph_algorithm(bool check_strategy_ = false, bool use_toms_optimization_ = false)
+    explicit solve_structure_graph_algorithm(bool check_strategy_ = false, bool use_toms_optimization_ = false, std::size_t number_of_threads_ = 1)
       : check_strategy(check_strategy_),
-        use_toms_optimization(use_toms_optimization_)
-    {}
+        use_toms_optimization(use_toms_optimization_),
+        number_of_threads(number_of_threads_)
+    {
+      if (number_of_threads > 1)
+      {
+        m_parallel_attractor = std::make_shared<parallel_attractor>(number_of_threads);
+      }
+    }
 
     inline
     bool solve(structure_graph& G)
@@ -461,7 +483,9 @@ class lps_solve_structure_graph_algorithm: public solve_structure_graph_algorith
     }
 
   public:
-    lps_solve_structure_graph_algorithm() = default;
+    explicit lps_solve_structure_graph_algorithm(std::size_t number_of_threads_ = 1)
+      : solve_structure_graph_algorithm(false, false, number_of_threads_)
+    {}
 
     /// \brief Solve a pbes for some equation, while constructing a counter example or wittness based on the accompanying linear process.
     /// \param G       A structure graph.
@@ -543,7 +567,9 @@ class lts_solve_structure_graph_algorithm: public solve_structure_graph_algorith
     }
 
   public:
-    lts_solve_structure_graph_algorithm() = default;
+    explicit lts_solve_structure_graph_algorithm(std::size_t number_of_threads_ = 1)
+      : solve_structure_graph_algorithm(false, false, number_of_threads_)
+    {}
 
     /// \brief Solve a boolean equation system while generating a counter example.
     /// \param G       A structure graph.
@@ -565,27 +591,28 @@ class lts_solve_structure_graph_algorithm: public solve_structure_graph_algorith
 };
 
 inline
-bool solve_structure_graph(structure_graph& G, bool check_strategy = false)
+bool solve_structure_graph(structure_graph& G, bool check_strategy = false, std::size_t number_of_threads = 1)
 {
   bool use_toms_optimization = !check_strategy;
-  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization);
+  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization, number_of_threads);
   return algorithm.solve(G);
 }
 
 inline
-std::pair<bool, lps::specification> solve_structure_graph_with_counter_example(structure_graph& G, const lps::specification& lpsspec, const pbes& p, const pbes_equation_index& p_index)
+std::pair<bool, lps::specification> solve_structure_graph_with_counter_example(structure_graph& G, const lps::specification& lpsspec, const pbes& p, const pbes_equation_index& p_index, std::size_t number_of_threads = 1)
 {
-  lps_solve_structure_graph_algorithm algorithm;
+  lps_solve_structure_graph_algorithm algorithm(number_of_threads);
   return algorithm.solve_with_counter_example(G, lpsspec, p, p_index);
 }
 
 /// \brief Solve this pbes_system using a structure graph generating a counter example.
 /// \param G       The structure graph.
 /// \param ltsspec The original LTS that was used to create the PBES.
+/// \param number_of_threads The number of threads that is used to compute attractor sets.
 inline
-bool solve_structure_graph_with_counter_example(structure_graph& G, lts::lts_lts_t& ltsspec)
+bool solve_structure_graph_with_counter_example(structure_graph& G, lts::lts_lts_t& ltsspec, std::size_t number_of_threads = 1)
 {
-  lts_solve_structure_graph_algorithm algorithm;
+  lts_solve_structure_graph_algorithm algorithm(number_of_threads);
   return algorithm.solve_with_counter_example(G, ltsspec);
 }
 
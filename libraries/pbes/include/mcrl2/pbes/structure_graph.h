@@ -79,20 +79,171 @@ class structure_graph
     // TODO: when using the CMake build, this declaration causes strange linker errors
     // static constexpr index_type undefined_vertex = (std::numeric_limits<index_type>::max)();
 
+    /// \brief The predecessors or successors of a vertex. As long as the structure graph is not frozen, the
+    ///        edges are stored in an array that is owned by the edge list. Freezing the structure graph makes
+    ///        the edge list refer to a part of a flat array of the structure graph instead, see freeze.
+    class edge_list
+    {
+      friend class structure_graph;
+
+      protected:
+        index_type* m_data;
+        index_type m_size;
+        index_type m_capacity; // The array m_data is owned by the edge list iff m_capacity != 0.
+
+        // Copies the edges to an owned array with the given capacity.
+        void reallocate(std::size_t capacity)
+        {
+          index_type* data = new index_type[capacity];
+          std::copy(m_data, m_data + m_size, data);
+          if (m_capacity != 0)
+          {
+            delete[] m_data;
+          }
+          m_data = data;
+          m_capacity = static_cast<index_type>(capacity);
+        }
+
+        // Makes the edge list refer to the edges [first, first + size), which it does not own.
+        void refer_to(index_type* first, std::size_t size)
+        {
+          clear();
+          m_data = first;
+          m_size = static_cast<index_type>(size);
+        }
+
+      public:
+        typedef index_type value_type;
+        typedef const index_type* iterator;
+        typedef const index_type* const_iterator;
+
+        edge_list()
+          : m_data(nullptr), m_size(0), m_capacity(0)
+        {}
+
+        edge_list(const edge_list& other)
+          : edge_list()
+        {
+          *this = other;
+        }
+
+        edge_list(edge_list&& other) noexcept
+          : edge_list()
+        {
+          swap(other);
+        }
+
+        ~edge_list()
+        {
+          clear();
+        }
+
+        edge_list& operator=(const edge_list& other)
+        {
+          if (this != &other)
+          {
+            clear();
+            if (!other.empty())
+            {
+              reallocate(other.size());
+              m_size = other.m_size;
+              std::copy(other.begin(), other.end(), m_data);
+            }
+          }
+          return *this;
+        }
+
+        edge_list& operator=(edge_list&& other) noexcept
+        {
+          swap(other);
+          return *this;
+        }
+
+        void swap(edge_list& other) noexcept
+        {
+          std::swap(m_data, other.m_data);
+          std::swap(m_size, other.m_size);
+          std::swap(m_capacity, other.m_capacity);
+        }
+
+        const index_type* begin() const
+        {
+          return m_data;
+        }
+
+        const index_type* end() const
+        {
+          return m_data + m_size;
+        }
+
+        std::size_t size() const
+        {
+          return m_size;
+        }
+
+        std::size_t capacity() const
+        {
+          return m_capacity;
+        }
+
+        bool empty() const
+        {
+          return m_size == 0;
+        }
+
+        void reserve(std::size_t capacity)
+        {
+          if (capacity > m_capacity)
+          {
+            reallocate(std::max(capacity, std::size_t(m_size)));
+          }
+        }
+
+        void push_back(index_type u)
+        {
+          if (m_capacity == 0 || m_size == m_capacity)
+          {
+            reallocate(m_size == 0 ? 1 : 2 * std::size_t(m_size));
+          }
+          m_data[m_size++] = u;
+        }
+
+        // Removes all occurrences of u.
+        void remove(index_type u)
+        {
+          if (m_capacity == 0 && m_size != 0)
+          {
+            reallocate(m_size);
+          }
+          m_size = static_cast<index_type>(std::remove(m_data, m_data + m_size, u) - m_data);
+        }
+
+        void clear()
+        {
+          if (m_capacity != 0)
+          {
+            delete[] m_data;
+          }
+          m_data = nullptr;
+          m_size = 0;
+          m_capacity = 0;
+        }
+    };
+
     struct vertex
     {
       atermpp::detail::reference_aterm<pbes_expression> m_formula;
       decoration_type decoration;
       std::size_t rank;
-      std::vector<index_type> predecessors;
-      std::vector<index_type> successors;
+      edge_list predecessors;
+      edge_list successors;
       mutable index_type strategy;
 
       explicit vertex(pbes_expression  formula_,
              decoration_type decoration_ = structure_graph::d_none,
              std::size_t rank_ = data::undefined_index(),
-             std::vector<index_type> pred_ = std::vector<index_type>(),
-             std::vector<index_type> succ_ = std::vector<index_type>(),
+             edge_list pred_ = edge_list(),
+             edge_list succ_ = edge_list(),
              index_type strategy_ = undefined_vertex()
             )
         : m_formula(std::move(formula_)),
@@ -105,7 +256,7 @@ class structure_graph
 
       void remove_predecessor(index_type u)
       {
-        predecessors.erase(std::remove(predecessors.begin(), predecessors.end(), u), predecessors.end());
+        predecessors.remove(u);
       }
 
       // Downcast reference aterm
@@ -116,7 +267,7 @@ class structure_graph
 
       void remove_successor(index_type u)
       {
-        successors.erase(std::remove(successors.begin(), successors.end(), u), successors.end());
+        successors.remove(u);
       }
 
       bool is_defined() const
@@ -131,11 +282,75 @@ class structure_graph
       }
     };
 
+    /// \brief A range of vertex indices that is stored contiguously in memory.
+    class index_range
+    {
+      protected:
+        const index_type* m_first;
+        const index_type* m_last;
+
+      public:
+        typedef const index_type* iterator;
+        typedef const index_type* const_iterator;
+
+        index_range(const index_type* first, const index_type* last)
+          : m_first(first), m_last(last)
+        {}
+
+        const index_type* begin() const
+        {
+          return m_first;
+        }
+
+        const index_type* end() const
+        {
+          return m_last;
+        }
+
+        std::size_t size() const
+        {
+          return m_last - m_first;
+        }
+
+        bool empty() const
+        {
+          return m_first == m_last;
+        }
+    };
+
   protected:
     atermpp::vector<vertex> m_vertices;
     index_type m_initial_vertex = 0;
     boost::dynamic_bitset<> m_exclude;
 
+    // The edges of a frozen structure graph. The edge lists of the vertices refer to consecutive parts of
+    // these arrays, see freeze. For a graph that is not frozen they are empty.
+    std::vector<index_type> m_predecessors;
+    std::vector<index_type> m_successors;
+    bool m_frozen = false;
+
+    // Moves the edges that are selected by get_edges from the vertices to edges.
+    template <typename GetEdges>
+    void freeze_edges(std::vector<index_type>& edges, GetEdges get_edges)
+    {
+      std::size_t number_of_edges = 0;
+      for (vertex& u: m_vertices)
+      {
+        number_of_edges += get_edges(u).size();
+      }
+
+      // The edges are reserved in advance, such that the edge lists can refer to them while they are inserted.
+      edges.clear();
+      edges.reserve(number_of_edges);
+      for (vertex& u: m_vertices)
+      {
+        edge_list& u_edges = get_edges(u);
+        const std::size_t first = edges.size();
+        edges.insert(edges.end(), u_edges.begin(), u_edges.end());
+        u_edges.refer_to(edges.data() + first, u_edges.size());
+      }
+    }
+
     struct integers_not_contained_in
     {
       const boost::dynamic_bitset<>& subset;
@@ -176,6 +391,32 @@ class structure_graph
         m_exclude(std::move(exclude))
     {}
 
+    // A copy of a frozen structure graph is frozen separately, since the edge lists of the copied vertices
+    // own their edges.
+    structure_graph(const structure_graph& other)
+      : m_vertices(other.m_vertices),
+        m_initial_vertex(other.m_initial_vertex),
+        m_exclude(other.m_exclude)
+    {
+      if (other.is_frozen())
+      {
+        freeze();
+      }
+    }
+
+    structure_graph(structure_graph&&) = default;
+
+    structure_graph& operator=(const structure_graph& other)
+    {
+      if (this != &other)
+      {
+        *this = structure_graph(other);
+      }
+      return *this;
+    }
+
+    structure_graph& operator=(structure_graph&&) = default;
+
     index_type initial_vertex() const
     {
       return m_initial_vertex;
@@ -201,14 +442,16 @@ class structure_graph
       return m_vertices;
     }
 
-    const std::vector<index_type>& all_predecessors(index_type u) const
+    index_range all_predecessors(index_type u) const
     {
-      return find_vertex(u).predecessors;
+      const edge_list& predecessors = find_vertex(u).predecessors;
+      return index_range(predecessors.begin(), predecessors.end());
     }
 
-    const std::vector<index_type>& all_successors(index_type u) const
+    index_range all_successors(index_type u) const
     {
-      return find_vertex(u).successors;
+      const edge_list& successors = find_vertex(u).successors;
+      return index_range(successors.begin(), successors.end());
     }
 
     boost::filtered_range<vertices_not_contained_in, const atermpp::vector<vertex>> vertices() const
@@ -216,12 +459,12 @@ class structure_graph
       return all_vertices() | boost::adaptors::filtered(vertices_not_contained_in(m_vertices, m_exclude));
     }
 
-    boost::filtered_range<integers_not_contained_in, const std::vector<index_type>> predecessors(index_type u) const
+    boost::filtered_range<integers_not_contained_in, const index_range> predecessors(index_type u) const
     {
       return all_predecessors(u) | boost::adaptors::filtered(integers_not_contained_in(m_exclude));
     }
 
-    boost::filtered_range<integers_not_contained_in, const std::vector<index_type>> successors(index_type u) const
+    boost::filtered_range<integers_not_contained_in, const index_range> successors(index_type u) const
     {
       return all_successors(u) | boost::adaptors::filtered(integers_not_contained_in(m_exclude));
     }
@@ -269,6 +512,27 @@ class structure_graph
     {
       return std::all_of(m_vertices.begin(), m_vertices.end(), [](const vertex& u) { return u.is_defined(); });
     }
+
+    // Returns true if the edges are stored in flat arrays of the structure graph, see freeze.
+    bool is_frozen() const
+    {
+      return m_frozen;
+    }
+
+    // Moves the edges of all vertices into two flat arrays, to which the edge lists of the vertices refer.
+    // This is done once the structure graph has been generated, since it saves two heap allocations per
+    // vertex and stores the edges of consecutive vertices next to each other. Changing the edges of a vertex
+    // afterwards copies them to an array that is owned by its edge list.
+    void freeze()
+    {
+      if (is_frozen())
+      {
+        return;
+      }
+      freeze_edges(m_predecessors, [](vertex& u) -> edge_list& { return u.predecessors; });
+      freeze_edges(m_successors, [](vertex& u) -> edge_list& { return u.successors; });
+      m_frozen = true;
+    }
 };
 
 template <typename StructureGraph>
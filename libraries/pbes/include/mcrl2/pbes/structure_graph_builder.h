@@ -228,8 +228,8 @@ struct structure_graph_builder
     }
 
     // computes new predecessors / successors
-    auto update = [&](const std::vector<index_type>& V) {
-      std::vector<index_type> result;
+    auto update = [&](const structure_graph::edge_list& V) {
+      structure_graph::edge_list result;
       for (auto v: V)
       {
         if (index[v] != undefined_vertex())
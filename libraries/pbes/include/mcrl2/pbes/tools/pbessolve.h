@@ -74,6 +74,10 @@ class pbessolve_tool
                     "be an LTS.",
                     'f');
     desc.add_option("prune-todo-list", "Prune the todo list periodically.");
+    desc.add_option("solve-threads",
+                    utilities::make_optional_argument("NUM", "1"),
+                    "Use NUM threads to compute the attractor sets when "
+                    "solving the parity game.");
     desc.add_hidden_option("no-remove-unused-rewrite-rules",
                            "do not remove unused rewrite rules. ", 'u');
     desc.add_option("evidence-file", utilities::make_file_argument("NAME"),
@@ -137,7 +141,14 @@ class pbessolve_tool
             "search-strategy");
     options.rewrite_strategy = rewrite_strategy();
     options.number_of_threads = number_of_threads();
-    
+    options.solve_threads = parser.option_argument_as<std::size_t>("solve-threads");
+    if (options.solve_threads == 0)
+    {
+      throw mcrl2::runtime_error("The number of solve threads must be at least 1.");
+    }
+
+    // The threads that are halted during garbage collection are used to mark the terms in parallel.
+    atermpp::detail::g_term_pool().set_garbage_collection_threads(number_of_threads());
 
     if (parser.has_option("file"))
     {
@@ -239,6 +250,9 @@ class pbessolve_tool
     mCRL2log(log::verbose) << "Number of vertices in the structure graph: "
                            << G.all_vertices().size() << std::endl;
 
+    // The structure graph is not modified anymore, so its edges can be stored in a compact form.
+    G.freeze();
+
     if ((!lpsfile.empty() || !ltsfile.empty()) &&
         !has_counter_example_information(pbesspec))
     {
@@ -258,7 +272,7 @@ class pbessolve_tool
       lps::specification evidence;
       timer().start("solving");
       std::tie(result, evidence) = solve_structure_graph_with_counter_example(
-          G, lpsspec, pbesspec, algorithm.equation_index());
+          G, lpsspec, pbesspec, algorithm.equation_index(), options.solve_threads);
       timer().finish("solving");
       std::cout << (result ? "true" : "false") << std::endl;
       if (evidence_file.empty())
@@ -276,7 +290,7 @@ class pbessolve_tool
       ltsspec.load(ltsfile);
       lts::lts_lts_t evidence;
       timer().start("solving");
-      bool result = solve_structure_graph_with_counter_example(G, ltsspec);
+      bool result = solve_structure_graph_with_counter_example(G, ltsspec, options.solve_threads);
       timer().finish("solving");
       std::cout << (result ? "true" : "false") << std::endl;
       if (evidence_file.empty())
@@ -291,7 +305,7 @@ class pbessolve_tool
     else
     {
       timer().start("solving");
-      bool result = solve_structure_graph(G, options.check_strategy);
+      bool result = solve_structure_graph(G, options.check_strategy, options.solve_threads);
       timer().finish("solving");
       std::cout << (result ? "true" : "false") << std::endl;
     }
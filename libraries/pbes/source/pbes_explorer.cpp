@@ -398,6 +398,37 @@ std::vector<pbes_expression> lts_info::split_expression_and_substitute_variables
 }
 
 
+void lts_info::add_indexed_variable(const propositional_variable& var, operation_type var_type)
+{
+    int index = this->get_number_of_variables();
+    std::pair<std::unordered_map<core::identifier_string,int>::iterator,bool> it =
+            this->variable_index.insert(std::make_pair(var.name(), index));
+    if (it.second)
+    {
+        this->indexed_variable_identifiers.push_back(var.name());
+        this->indexed_variable_names.push_back(std::string(var.name()));
+        this->indexed_variable_types.emplace_back();
+        this->indexed_variable_parameter_indices.emplace_back();
+        this->indexed_variable_parameter_positions.emplace_back();
+    }
+    else
+    {
+        index = it.first->second;
+    }
+    this->indexed_variable_types[index] = var_type;
+    std::vector<int> parameter_indices = this->get_param_indices(var.parameters());
+    std::vector<int> parameter_positions(this->type.get_state_length() - 1, -1);
+    int position = 0;
+    for (int parameter_index: parameter_indices)
+    {
+        parameter_positions[parameter_index] = position;
+        position++;
+    }
+    this->indexed_variable_parameter_indices[index] = parameter_indices;
+    this->indexed_variable_parameter_positions[index] = parameter_positions;
+}
+
+
 void lts_info::compute_transition_groups()
 {
     mCRL2log(log::verbose) << "Compute transition groups." << std::endl;
@@ -418,9 +449,11 @@ void lts_info::compute_transition_groups()
     this->variable_parameter_signatures[name] = get_param_sequence(t.parameters());
     this->variable_parameter_indices[name] = this->get_param_indices(t.parameters());
     this->variable_parameter_index_positions[name] = this->get_param_index_positions(t.parameters());
+    this->add_indexed_variable(t, type);
     this->transition_expression_plain.push_back(true_());
     this->transition_expression.push_back(pgg->rewrite_and_simplify_expression(true_()));
     this->transition_variable_name.push_back(name);
+    this->transition_variable_index.push_back(get_variable_index(core::identifier_string(name)));
     this->transition_type.push_back(type);
     group++;
     priority++;
@@ -437,9 +470,11 @@ void lts_info::compute_transition_groups()
     this->variable_parameter_signatures[name] = get_param_sequence(f.parameters());
     this->variable_parameter_indices[name] = this->get_param_indices(f.parameters());
     this->variable_parameter_index_positions[name] = this->get_param_index_positions(f.parameters());
+    this->add_indexed_variable(f, type);
     this->transition_expression_plain.push_back(false_());
     this->transition_expression.push_back(pgg->rewrite_and_simplify_expression(false_()));
     this->transition_variable_name.push_back(name);
+    this->transition_variable_index.push_back(get_variable_index(core::identifier_string(name)));
     this->transition_type.push_back(type);
     group++;
     priority++;
@@ -464,6 +499,7 @@ void lts_info::compute_transition_groups()
         this->variable_parameter_indices[variable_name] = this->get_param_indices(eqn.variable().parameters());
         this->variable_parameter_index_positions[variable_name] = this->get_param_index_positions(eqn.variable().parameters());
         this->variable_expression[variable_name] = expr;
+        this->add_indexed_variable(eqn.variable(), type);
     }
 
     // Skip 'unused' equations....
@@ -519,6 +555,7 @@ void lts_info::compute_transition_groups()
                 this->transition_expression_plain.push_back(*e);
                 this->transition_expression.push_back(pgg->rewrite_and_simplify_expression(*e));
                 this->transition_variable_name.push_back(variable_name);
+                this->transition_variable_index.push_back(get_variable_index(eqn.variable().name()));
                 this->transition_type.push_back(type);
                 mCRL2log(log::debug) << "Add transition group " << group << ": "
                         << (type==parity_game_generator::PGAME_AND ? "AND" : "OR") << " " << variable_name << " "
@@ -641,6 +678,61 @@ const std::map<std::string, std::map<int,int> >& lts_info::get_variable_paramete
 }
 
 
+int lts_info::get_number_of_variables() const
+{
+    return indexed_variable_names.size();
+}
+
+
+int lts_info::get_variable_index(const core::identifier_string& name) const
+{
+    std::unordered_map<core::identifier_string,int>::const_iterator it = variable_index.find(name);
+    return it == variable_index.end() ? -1 : it->second;
+}
+
+
+int lts_info::get_variable_index(const std::string& name) const
+{
+    return get_variable_index(core::identifier_string(name));
+}
+
+
+const std::string& lts_info::get_variable_name(int var_index) const
+{
+    return indexed_variable_names.at(var_index);
+}
+
+
+const core::identifier_string& lts_info::get_variable_identifier(int var_index) const
+{
+    return indexed_variable_identifiers.at(var_index);
+}
+
+
+lts_info::operation_type lts_info::get_variable_type(int var_index) const
+{
+    return indexed_variable_types.at(var_index);
+}
+
+
+const std::vector<int>& lts_info::get_variable_parameter_indices(int var_index) const
+{
+    return indexed_variable_parameter_indices.at(var_index);
+}
+
+
+int lts_info::get_variable_parameter_position(int var_index, int param_index) const
+{
+    return indexed_variable_parameter_positions.at(var_index)[param_index];
+}
+
+
+int lts_info::get_transition_variable_index(int group) const
+{
+    return transition_variable_index.at(group);
+}
+
+
 const lts_type& lts_info::get_lts_type() const
 {
     return type;
@@ -1167,19 +1259,25 @@ std::string lts_info::get_param_signature(const std::string& paramname,
 // ltsmin_state
 
 ltsmin_state::ltsmin_state(const std::string& varname)
+  : var(varname), var_index(-1)
+{
+}
+
+
+ltsmin_state::ltsmin_state(const core::identifier_string& varname, int index)
+  : var(varname), var_index(index)
 {
-    this->var = varname;
 }
 
 
-ltsmin_state::ltsmin_state(const std::string& varname,
+ltsmin_state::ltsmin_state(const core::identifier_string& varname,
                        const pbes_expression& e)
+  : var(varname), var_index(-1)
 {
     data_expression novalue;
     //std::clog << "ltsmin_state v = " << pp(v) << std::endl;
-    this->var = varname;
     if (is_propositional_variable_instantiation(e)) {
-        assert(std::string(atermpp::down_cast<propositional_variable_instantiation>(e).name()) == varname);
+        assert(atermpp::down_cast<propositional_variable_instantiation>(e).name() == varname);
         //std::clog << "ltsmin_state: var = " << atermpp::down_cast<propositional_variable_instantiation>(e).name() << std::endl;
         const data::data_expression_list& values = atermpp::down_cast<propositional_variable_instantiation>(e).parameters();
         for (const auto & value : values)
@@ -1200,8 +1298,15 @@ ltsmin_state::ltsmin_state(const std::string& varname,
 
 bool ltsmin_state::operator<( const ltsmin_state& other ) const
 {
-  if (this->var < other.var) return true;
-  else if (this->var == other.var)
+  // States obtained from the explorer carry the index of their variable, which is
+  // cheaper to compare than the name. The names are only compared if the index is not known.
+  if (this->var_index < other.var_index) return true;
+  else if (this->var_index > other.var_index) return false;
+  else if (this->var != other.var)
+  {
+    return this->var_index < 0 && std::string(this->var) < std::string(other.var);
+  }
+  else
   {
     if (param_values.size() < other.param_values.size()) return true;
     else if (param_values.size() == other.param_values.size())
@@ -1215,7 +1320,8 @@ bool ltsmin_state::operator<( const ltsmin_state& other ) const
 
 bool ltsmin_state::operator==( const ltsmin_state& other ) const
 {
-  return this->var==other.var
+  return this->var_index==other.var_index
+      && this->var==other.var
       && param_values.size()==other.param_values.size()
       && param_values == other.param_values;
 }
@@ -1248,7 +1354,7 @@ pbes_expression ltsmin_state::to_pbes_expression() const
     data::data_expression_list parameter_values_list(parameter_values.begin(), parameter_values.end());
     // Create propositional variable instantiation.
     propositional_variable_instantiation expr =
-            propositional_variable_instantiation(core::identifier_string(var), parameter_values_list);
+            propositional_variable_instantiation(var, parameter_values_list);
     return workaround::return_std_move(expr);
 }
 
@@ -1258,7 +1364,7 @@ std::string ltsmin_state::state_to_string() const
     std::string result;
     std::stringstream ss;
     ss << (type==parity_game_generator::PGAME_AND ? "AND" : "OR");
-    ss << ":" << var;
+    ss << ":" << std::string(var);
     ss << "[" << std::endl;
     for (std::vector<data_expression>::const_iterator entry =
             param_values.begin(); entry != param_values.end(); ++entry) {
@@ -1294,11 +1400,12 @@ explorer::explorer(const std::string& filename, const std::string& rewrite_strat
     this->info = new lts_info(p, pgg, reset_flag, always_split_flag);
     //std::clog << "explorer" << std::endl;
     for (std::size_t i = 0; i < info->get_lts_type().get_number_of_state_types(); ++i) {
-        std::map<data_expression,int> data2int_map;
+        std::unordered_map<data_expression,int> data2int_map;
         this->localmaps_data2int.push_back(data2int_map);
         std::vector<data_expression> int2data_map;
         this->localmaps_int2data.push_back(int2data_map);
     }
+    this->localmap_variable2int.resize(info->get_number_of_variables(), -1);
     //std::clog << "-- end of explorer." << std::endl;
 }
 
@@ -1310,11 +1417,12 @@ explorer::explorer(const pbes& p_, const std::string& rewrite_strategy = "jittyc
     this->info = new lts_info(p, pgg, reset_flag, always_split_flag);
     //std::clog << "explorer" << std::endl;
     for (std::size_t i = 0; i < info->get_lts_type().get_number_of_state_types(); i++) {
-        std::map<data_expression,int> data2int_map;
+        std::unordered_map<data_expression,int> data2int_map;
         this->localmaps_data2int.push_back(data2int_map);
         std::vector<data_expression> int2data_map;
         this->localmaps_int2data.push_back(int2data_map);
     }
+    this->localmap_variable2int.resize(info->get_number_of_variables(), -1);
     //std::clog << "-- end of explorer." << std::endl;
 }
 
@@ -1353,22 +1461,25 @@ ltsmin_state explorer::get_state(const propositional_variable_instantiation& exp
     //std::clog << "  expr = " << expr << std::endl;
     propositional_variable_instantiation novalue;
     assert(is_propositional_variable_instantiation(expr) && expr != novalue);
-    std::string varname = expr.name();
-    //std::clog << "  varname = " << varname << std::endl;
-    ltsmin_state s(varname, expr);
+    ltsmin_state s(expr.name(), expr);
+    s.var_index = info->get_variable_index(expr.name());
     return s;
 }
 
 
 ltsmin_state explorer::true_state()
 {
-    return ltsmin_state("true");
+    ltsmin_state s("true");
+    s.var_index = 0;
+    return s;
 }
 
 
 ltsmin_state explorer::false_state()
 {
-    return ltsmin_state("false");
+    ltsmin_state s("false");
+    s.var_index = 1;
+    return s;
 }
 
 
@@ -1402,6 +1513,12 @@ int explorer::get_string_index(const std::string& s)
     } else {
         this->localmap_int2string.push_back(s);
         index = this->localmap_int2string.size() - 1;
+        int var_index = info->get_variable_index(s);
+        this->localmap_int2variable.push_back(var_index);
+        if (var_index >= 0)
+        {
+            this->localmap_variable2int[var_index] = index;
+        }
         //std::clog << "[" << getpid() << "] get_string_index DEBUG push_back " << index << ": " << s << std::endl;
         this->localmap_string2int.insert(std::make_pair(s,index));
     }
@@ -1415,8 +1532,8 @@ int explorer::get_value_index(int type_no, const data_expression& value)
     //std::clog << "    get_value_index type_no=" << type_no << " (" << info->get_lts_type().get_number_of_state_types() << ")" << std::endl;
     //std::clog << "                type=" << info->get_lts_type().get_state_type_name(type_no) << std::endl;
     //std::clog << "                value=" << value << std::endl;
-    std::map<data_expression,int>& data2int_map = this->localmaps_data2int.at(type_no);
-    std::map<data_expression,int>::iterator it = data2int_map.find(value);
+    std::unordered_map<data_expression,int>& data2int_map = this->localmaps_data2int.at(type_no);
+    std::unordered_map<data_expression,int>::iterator it = data2int_map.find(value);
     std::size_t index;
     if (it != data2int_map.end()) {
         index = it->second;
@@ -1429,6 +1546,42 @@ int explorer::get_value_index(int type_no, const data_expression& value)
 }
 
 
+int explorer::get_variable_index(const ltsmin_state& state) const
+{
+    if (state.var_index >= 0)
+    {
+        return state.var_index;
+    }
+    int var_index = info->get_variable_index(state.var);
+    if (var_index < 0)
+    {
+        throw(std::runtime_error("Error: " + state.get_variable() + " is not a propositional variable."));
+    }
+    return var_index;
+}
+
+
+int explorer::get_variable_string_index(int var_index)
+{
+    int index = localmap_variable2int[var_index];
+    if (index < 0)
+    {
+        index = get_string_index(info->get_variable_name(var_index));
+    }
+    return index;
+}
+
+
+int explorer::get_string_variable_index(int index) const
+{
+    if (index < 0 || index >= (int)(localmap_int2variable.size()))
+    {
+        throw(std::runtime_error("Error in get_string_value: Value not found for index " + std::to_string(index) + "."));
+    }
+    return localmap_int2variable[index];
+}
+
+
 void explorer::to_state_vector(const ltsmin_state& dst_state, int* dst, const ltsmin_state& src_state, int* const& src)
 {
     //std::clog << "to_state_vector: " << dst_state.to_string() << std::endl;
@@ -1437,33 +1590,22 @@ void explorer::to_state_vector(const ltsmin_state& dst_state, int* dst, const lt
     //std::clog << "-- to_state_vector -- " << std::endl;
     int state_length = info->get_lts_type().get_state_length();
 
-    std::string varname = dst_state.get_variable();
-    std::string src_varname;
-    bool same_var = false;
-    if (!(src==nullptr)) {
-        src_varname = src_state.get_variable();
-        same_var = (varname==src_varname);
+    int var_index = get_variable_index(dst_state);
+    int src_var_index = -1;
+    if (src != nullptr) {
+        src_var_index = get_variable_index(src_state);
     }
-    int varindex;
-    if (same_var) {
-        varindex = src[0];
+    if (var_index == src_var_index) {
+        dst[0] = src[0];
     } else {
-        varindex = this->get_string_index(varname);
+        dst[0] = this->get_variable_string_index(var_index);
     }
-    dst[0] = varindex;
-    //std::clog << "  to_state_vector: DEBUG: varname = " << varname << " index = " << varindex << (same_var ? " SAME VAR": "") << std::endl;
-
-
-    // data_expression values[state_length]; N.B. This is not portable C++
-    std::vector < data_expression > values(state_length);
 
     if (info->get_reset_option() || src == nullptr) {
         int type_no;
         for (int i = 1; i < state_length; i++) {
-            data_expression default_value = info->get_default_value(i-1);
-            values[i] = default_value;
             type_no = info->get_lts_type().get_state_type_no(i);
-            dst[i] = this->get_value_index(type_no, values[i]);
+            dst[i] = this->get_value_index(type_no, info->get_default_value(i-1));
         }
     } else {
         for (int i = 1; i < state_length; i++) {
@@ -1472,48 +1614,29 @@ void explorer::to_state_vector(const ltsmin_state& dst_state, int* dst, const lt
     }
     bool error = false;
     const std::vector<data_expression>& parameter_values = dst_state.get_parameter_values();
-    std::vector<int> parameter_indices =
-                        detail::map_at(info->get_variable_parameter_indices(), varname);
-    std::vector<std::string> parameter_signatures =
-                    detail::map_at(info->get_variable_parameter_signatures(), varname);
-    std::vector<std::string>::iterator param_signature = parameter_signatures.begin();
-    int value_index = 0;
-    for(int & parameter_indice : parameter_indices)
-    {
-        int i = parameter_indice + 1;
-        int type_no = info->get_lts_type().get_state_type_no(i);
-        values[i] = parameter_values[value_index];
-        if (values[i]==novalue)
+    const std::vector<int>& parameter_indices = info->get_variable_parameter_indices(var_index);
+    for (std::size_t value_index = 0; value_index < parameter_indices.size(); value_index++)
+    {
+        int parameter_index = parameter_indices[value_index];
+        int i = parameter_index + 1;
+        const data_expression& value = parameter_values[value_index];
+        if (value==novalue)
         {
             error = true;
-        } else {
-          if (src==nullptr) {
-                // no source state available; compute index for value.
-                dst[i] = this->get_value_index(type_no, values[i]);
-            }
-            else
-            {
-                // lookup src parameter value
-                // FIXME: this could be computed statically: a map from src_var, dst_var and part to boolean
-                std::map<int,int> src_param_index_positions = detail::map_at(info->get_variable_parameter_index_positions(), src_state.get_variable());
-                std::map<int,int>::iterator src_param_index_position_it = src_param_index_positions.find(parameter_indice);
-                if ( src_param_index_position_it != src_param_index_positions.end()
-                        && src_state.get_parameter_values()[src_param_index_position_it->second] == values[i])
-                {
-                    // src value exists and is equal to the dst value.
-                    // save to copy index from src_state
-                    // which has been done earlier
-                } else {
-                    // parameter value has changed or does not exists in src; compute index for value.
-                    dst[i] = this->get_value_index(type_no, values[i]);
-                }
-            }
+            continue;
         }
-        if (param_signature != parameter_signatures.end())
+        if (src != nullptr)
         {
-            ++param_signature;
+            // Copy the index from src if the parameter value has not changed.
+            int src_position = info->get_variable_parameter_position(src_var_index, parameter_index);
+            if (src_position >= 0 && src_state.get_parameter_values()[src_position] == value)
+            {
+                dst[i] = src[i];
+                continue;
+            }
         }
-        value_index++;
+        // The parameter value has changed or does not exist in src; compute index for value.
+        dst[i] = this->get_value_index(info->get_lts_type().get_state_type_no(i), value);
     }
     if (error)
     {
@@ -1570,43 +1693,26 @@ ltsmin_state explorer::from_state_vector(int* const& src)
 {
     //std::clog << "-- from_state_vector(model, src) --" << std::endl;
     data_expression novalue;
-    int state_length = info->get_lts_type().get_state_length();
 
-    std::string varname = this->get_string_value(src[0]);
-    //std::clog << "from_state_vector: varname = " << varname << std::endl;
-
-    bool error = false;
+    int var_index = this->get_string_variable_index(src[0]);
+    if (var_index < 0)
+    {
+        throw(std::runtime_error("Error in from_state_vector: " + this->get_string_value(src[0]) + " is not a propositional variable."));
+    }
 
-    // data_expression values[state_length]; N.B. This is not portable C++
-    std::vector <data_expression> values(state_length);
-
-    int type_no;
-    for (int i = 1; i < state_length; i++) {
-        //std::clog << "from_state_vector: values: " << i << " (" << src[i] << "): " << std::endl;
-        type_no = info->get_lts_type().get_state_type_no(i);
-        values[i] = this->get_data_value(type_no, src[i]);
-        //std::clog << "from_state_vector:   " << values[i].to_string() << std::endl;
-    }
-    //std::clog << "from_state_vector: values done." << std::endl;
-    data::data_expression_vector parameters;
-    std::vector<int> parameter_indices =
-            detail::map_at(info->get_variable_parameter_indices(), varname);
-    for (int & parameter_indice : parameter_indices) {
-        if (values[parameter_indice+1]==novalue)
+    ltsmin_state state(info->get_variable_identifier(var_index), var_index);
+    const std::vector<int>& parameter_indices = info->get_variable_parameter_indices(var_index);
+    state.param_values.reserve(parameter_indices.size());
+    for (int parameter_index : parameter_indices) {
+        int i = parameter_index + 1;
+        int type_no = info->get_lts_type().get_state_type_no(i);
+        const data_expression& value = this->get_data_value(type_no, src[i]);
+        if (value==novalue)
         {
-            error = true;
-            //std::clog << "from_state_vector: varname = " << varname << ", values[" << *param_index+1 << "] = " << values[*param_index+1].to_string() << "(" << src[*param_index+1] << ")" << std::endl;
+            throw(std::runtime_error("Error in from_state_vector: NoValue in parameters."));
         }
-        parameters.push_back(values[parameter_indice+1]);
-    }
-    if (error)
-    {
-        throw(std::runtime_error("Error in from_state_vector: NoValue in parameters."));
+        state.add_parameter_value(value);
     }
-    data::data_expression_list paramlist(parameters.begin(), parameters.end());
-    propositional_variable_instantiation state_expression(varname, paramlist);
-    //std::clog << "from_state_vector: state_expression = " << state_expression.to_string() << std::endl;
-    ltsmin_state state = this->get_state(state_expression);
     //std::clog << "from_state_vector: state = " << state->to_string() << std::endl;
     return state;
 }
@@ -1617,23 +1723,25 @@ std::vector<ltsmin_state> explorer::get_successors(const ltsmin_state& state)
     //std::cout << "get_successors: " << state->to_string() << std::endl;
     std::vector<ltsmin_state> result;
 
-    pbes_expression e = state.to_pbes_expression();
-    assert(core::detail::check_term_PropVarInst(e));
-    if (state.get_variable()=="true")
+    int var_index = get_variable_index(state);
+    if (var_index==0) // true
     {
         // Adding true=true
         result.push_back(state);
     }
-    else if (state.get_variable()=="false")
+    else if (var_index==1) // false
     {
         // Adding false=false
         result.push_back(state);
     }
     else
     {
+        const std::vector<data_expression>& values = state.get_parameter_values();
+        pbes_expression e = propositional_variable_instantiation(info->get_variable_identifier(var_index),
+                                                                 data::data_expression_list(values.begin(), values.end()));
         std::set<pbes_expression> successors
                 = pgg->get_successors(e);
-        operation_type type = detail::map_at(info->get_variable_types(), state.get_variable());
+        operation_type type = info->get_variable_type(var_index);
         for (const auto & successor : successors) {
             if (is_propositional_variable_instantiation(successor)) {
                 result.push_back(get_state(atermpp::down_cast<propositional_variable_instantiation>(successor)));
@@ -1662,27 +1770,28 @@ std::vector<ltsmin_state> explorer::get_successors(const ltsmin_state& state,
     //std::clog << "get_successors: group=" << group << std::endl;
     std::vector<ltsmin_state> result;
 
-    if (group == 0 && state.get_variable()=="true")
+    int var_index = get_variable_index(state);
+    if (group == 0 && var_index==0) // true
     {
         // Adding true=true
         result.push_back(state);
     }
-    else if (group == 1 && state.get_variable()=="false")
+    else if (group == 1 && var_index==1) // false
     {
         // Adding false=false
         result.push_back(state);
     }
     else
     {
-        std::string varname = state.get_variable();
-        std::string group_varname = info->get_transition_variable_names()[group];
-        if (varname==group_varname)
+        if (var_index==info->get_transition_variable_index(group))
         {
-            pbes_expression e = state.to_pbes_expression();
+            const std::vector<data_expression>& values = state.get_parameter_values();
+            pbes_expression e = propositional_variable_instantiation(info->get_variable_identifier(var_index),
+                                                                     data::data_expression_list(values.begin(), values.end()));
             std::set<pbes_expression> successors
-                    = pgg->get_successors(e, group_varname,
+                    = pgg->get_successors(e, info->get_variable_name(var_index),
                                              info->get_transition_expressions()[group]);
-            operation_type type = detail::map_at(info->get_variable_types(), state.get_variable());
+            operation_type type = info->get_variable_type(var_index);
             for (const auto & successor : successors) {
                 //std::clog << " * successor: " << pp(*expr) << std::endl;
                 if (is_propositional_variable_instantiation(successor)) {
@@ -242,6 +242,21 @@ void run_pbes_explorer(const std::string& pbes_text, int num_parts, int num_grou
   (void)write_matrix;
   // TODO: check matrices ...
 
+  // check that the tables indexed by variable number agree with the tables indexed by variable name:
+  BOOST_CHECK(info->get_variable_name(0)=="true");
+  BOOST_CHECK(info->get_variable_name(1)=="false");
+  for (int var_index = 0; var_index < info->get_number_of_variables(); var_index++)
+  {
+    const std::string& varname = info->get_variable_name(var_index);
+    BOOST_CHECK(info->get_variable_index(varname)==var_index);
+    BOOST_CHECK(info->get_variable_type(var_index)==map_at(info->get_variable_types(), varname));
+    BOOST_CHECK(info->get_variable_parameter_indices(var_index)==info->get_variable_parameter_indices().at(varname));
+  }
+  for (int group = 0; group < info->get_number_of_groups(); group++)
+  {
+    BOOST_CHECK(info->get_variable_name(info->get_transition_variable_index(group))==info->get_transition_variable_names()[group]);
+  }
+
   pbes_explorer->bfs();
   // check number of states and transitions:
   //BOOST_CHECK(num_states==(int)pbes_explorer->get_state_count());
@@ -18,8 +18,10 @@
 #include "mcrl2/pbes/is_bes.h"
 #include "mcrl2/pbes/lps2pbes.h"
 #include "mcrl2/pbes/pbesinst_finite_algorithm.h"
+#include "mcrl2/pbes/pbesinst_structure_graph2.h"
 #include "mcrl2/pbes/pbesinst_symbolic.h"
 #include "mcrl2/pbes/rewriter.h"
+#include "mcrl2/pbes/solve_structure_graph.h"
 #include "mcrl2/pbes/txt2pbes.h"
 
 using namespace mcrl2;
@@ -260,6 +262,116 @@ BOOST_AUTO_TEST_CASE(test_abp_no_deadlock)
   BOOST_CHECK(is_bes(q));
 }
 
+// Instantiates the pbes with the given number of threads and returns the solution and the size of the structure graph.
+static std::pair<bool, std::size_t> pbesinst_structure_graph(const pbes& p, std::size_t number_of_threads, int optimization)
+{
+  pbessolve_options options;
+  options.number_of_threads = number_of_threads;
+  options.optimization = optimization;
+  structure_graph G;
+  if (optimization < 2)
+  {
+    pbesinst_structure_graph_algorithm algorithm(options, p, G);
+    algorithm.run();
+  }
+  else
+  {
+    pbesinst_structure_graph_algorithm2 algorithm(options, p, G);
+    algorithm.run();
+  }
+  return std::make_pair(solve_structure_graph(G), G.all_vertices().size());
+}
+
+BOOST_AUTO_TEST_CASE(test_abp_no_deadlock_threads)
+{
+  lps::specification spec=remove_stochastic_operators(lps::linearise(lps::detail::ABP_SPECIFICATION()));
+  state_formulas::state_formula formula = state_formulas::parse_state_formula(lps::detail::NO_DEADLOCK(), spec);
+  pbes p = lps2pbes(spec, formula, false);
+  pbes_system::algorithms::normalize(p);
+
+  if (atermpp::detail::GlobalThreadSafe)
+  {
+    for (int optimization: {0, 2, 7})
+    {
+      const std::pair<bool, std::size_t> sequential = pbesinst_structure_graph(p, 1, optimization);
+      const std::pair<bool, std::size_t> parallel = pbesinst_structure_graph(p, 4, optimization);
+      BOOST_CHECK(sequential.first);
+      BOOST_CHECK_EQUAL(sequential.first, parallel.first);
+      if (optimization == 0)
+      {
+        // Without optimisations the complete structure graph is generated, which does not depend on the order of exploration.
+        BOOST_CHECK_EQUAL(sequential.second, parallel.second);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_attractor)
+{
+  lps::specification spec=remove_stochastic_operators(lps::linearise(lps::detail::ABP_SPECIFICATION()));
+  state_formulas::state_formula formula = state_formulas::parse_state_formula(lps::detail::NO_DEADLOCK(), spec);
+  pbes p = lps2pbes(spec, formula, false);
+  pbes_system::algorithms::normalize(p);
+
+  pbessolve_options options;
+  structure_graph G;
+  pbesinst_structure_graph_algorithm algorithm(options, p, G);
+  algorithm.run();
+
+  // Compare the attractors of all single vertices, where the parallel version divides every layer over the threads.
+  // The same parallel_attractor is used for all of them, such that its data is reused between the calls.
+  parallel_attractor attr_parallel(4, 1);
+  const std::size_t N = G.extent();
+  for (structure_graph::index_type u = 0; u < N; ++u)
+  {
+    for (std::size_t alpha: {0, 1})
+    {
+      vertex_set A(N);
+      A.insert(u);
+      BOOST_CHECK(attr_default_no_strategy(G, A, alpha) == attr_parallel(G, A, alpha));
+    }
+  }
+
+  BOOST_CHECK_EQUAL(solve_structure_graph(G), solve_structure_graph(G, false, 4));
+  BOOST_CHECK_EQUAL(solve_structure_graph(G, true), solve_structure_graph(G, true, 4));
+}
+
+BOOST_AUTO_TEST_CASE(test_frozen_structure_graph)
+{
+  lps::specification spec=remove_stochastic_operators(lps::linearise(lps::detail::ABP_SPECIFICATION()));
+  state_formulas::state_formula formula = state_formulas::parse_state_formula(lps::detail::NO_DEADLOCK(), spec);
+  pbes p = lps2pbes(spec, formula, false);
+  pbes_system::algorithms::normalize(p);
+
+  pbessolve_options options;
+  structure_graph G;
+  pbesinst_structure_graph_algorithm algorithm(options, p, G);
+  algorithm.run();
+
+  structure_graph H = G;
+  H.freeze();
+  BOOST_CHECK(H.is_frozen());
+  BOOST_CHECK_EQUAL(G.is_defined(), H.is_defined());
+  for (structure_graph::index_type u = 0; u < G.extent(); ++u)
+  {
+    BOOST_CHECK(structure_graph_successors(G, u) == structure_graph_successors(H, u));
+    BOOST_CHECK(structure_graph_predecessors(G, u) == structure_graph_predecessors(H, u));
+    BOOST_CHECK_EQUAL(G.find_vertex(u).is_defined(), H.find_vertex(u).is_defined());
+    std::ostringstream out_G;
+    std::ostringstream out_H;
+    out_G << G.find_vertex(u);
+    out_H << H.find_vertex(u);
+    BOOST_CHECK_EQUAL(out_G.str(), out_H.str());
+  }
+
+  // A copy of a frozen structure graph is frozen too.
+  structure_graph K = H;
+  BOOST_CHECK(K.is_frozen());
+  BOOST_CHECK_EQUAL(solve_structure_graph(H, true), solve_structure_graph(K, true));
+
+  BOOST_CHECK_EQUAL(solve_structure_graph(G, true), solve_structure_graph(H, true));
+}
+
 // Example supplied by Tim Willemse, 23-05-2011
 BOOST_AUTO_TEST_CASE(test_functions)
 {
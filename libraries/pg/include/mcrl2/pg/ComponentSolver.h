@@ -20,6 +20,13 @@
     general solver.  Whenever a component is solved, its attractor set in the
     complete graph is computed, and the graph is decomposed again, in hopes of
     generating even smaller components.
+
+    With more than one thread, the components are first collected and then
+    solved by a pool of worker threads.  A component is dispatched as soon as
+    all components it has edges to are solved, so independent components are
+    solved at the same time.  The attractor sets of a solved component can only
+    contain vertices of components that depend on it, which have not been
+    dispatched yet, so the result is the same as with a single thread.
 */
 class ComponentSolver : public ParityGameSolver
 {
@@ -32,9 +39,13 @@ public:
         recursively decomposed (up to the give depth) if it turns out they have
         been partially solved already (i.e. when some of their vertices lie in
         the attractor sets of winning regions identified earlier).
+
+        When `number_of_threads` > 1, components of the main graph that do
+        not depend on each other are solved in parallel.
     */
     ComponentSolver( const ParityGame &game, ParityGameSolverFactory &pgsf,
-                     int max_depth, const verti *vmap = 0, verti vmap_size = 0
+                     int max_depth, const verti *vmap = 0, verti vmap_size = 0,
+                     std::size_t number_of_threads = 1
                    );
     ~ComponentSolver();
 
@@ -45,11 +56,30 @@ private:
     int operator()(const verti *vertices, std::size_t num_vertices);
     friend class SCC<ComponentSolver>;
 
+    //! Solves the components with `number_of_threads_` worker threads.
+    int solve_in_parallel();
+
+    //! Returns the vertices of a component that are not in a winning set yet.
+    std::vector<verti> unsolved_vertices( const verti *vertices,
+                                          std::size_t num_vertices ) const;
+
+    /*! Solves the subgame induced by the `unsolved` vertices of a component
+        with `num_vertices` vertices.  Returns an empty strategy on failure. */
+    ParityGame::Strategy solve_component( ParityGame &subgame,
+        const std::vector<verti> &unsolved, std::size_t num_vertices );
+
+    /*! Adds the solution of a subgame to the resulting strategy and extends
+        the winning sets with their attractor sets in the complete game. */
+    void add_solution( const ParityGame &subgame,
+        const ParityGame::Strategy &substrat,
+        const std::vector<verti> &unsolved );
+
 protected:
     ParityGameSolverFactory  &pgsf_;        //!< Solver factory to use
     const int                max_depth_;    //!< Max. recusion depth
     const verti              *vmap_;        //!< Current vertex map
     const verti              vmap_size_;    //!< Size of vertex map
+    const std::size_t        number_of_threads_; //!< Number of worker threads
     ParityGame::Strategy     strategy_;     //!< Resulting strategy
     DenseSet<verti>          *winning_[2];  //!< Resulting winning sets
 };
@@ -59,8 +89,10 @@ class ComponentSolverFactory : public ParityGameSolverFactory
 {
 public:
     //! \see ComponentSolver::ComponentSolver()
-    ComponentSolverFactory(ParityGameSolverFactory &pgsf, int max_depth = 10)
-        : pgsf_(pgsf), max_depth_(max_depth) { pgsf_.ref(); }
+    ComponentSolverFactory(ParityGameSolverFactory &pgsf, int max_depth = 10,
+                           std::size_t number_of_threads = 1)
+        : pgsf_(pgsf), max_depth_(max_depth),
+          number_of_threads_(number_of_threads) { pgsf_.ref(); }
     ~ComponentSolverFactory() { pgsf_.deref(); }
 
     //! Return a new ComponentSolver instance.
@@ -70,6 +102,7 @@ public:
 protected:
     ParityGameSolverFactory &pgsf_;     //!< Factory used to create subsolvers
     const int max_depth_;               //!< Maximum recursion depth
+    const std::size_t number_of_threads_; //!< Number of worker threads
 };
 
 #endif /* ndef MCRL2_PG_COMPONENT_SOLVER_H */
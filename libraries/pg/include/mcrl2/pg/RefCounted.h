@@ -10,6 +10,7 @@
 #ifndef MCRL2_PG_REFCOUNTED_H
 #define MCRL2_PG_REFCOUNTED_H
 
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 
@@ -24,6 +25,9 @@
     provided the caller has the only reference to the object.  In effect, this
     is the same as calling deref(), but supports use cases like putting
     instances into std::auto_ptr wrappers.
+
+    The reference count is atomic, so references may be added and removed
+    from different threads.
 */
 class RefCounted
 {
@@ -49,7 +53,7 @@ protected:
     virtual ~RefCounted() { assert(refs_ <= 1); }
 
 protected:
-    mutable std::size_t refs_;  //!< Number of references to this object
+    mutable std::atomic<std::size_t> refs_;  //!< Number of references to this object
 };
 
 #endif /* ndef MCRL2_PG_REFCOUNTED_H */
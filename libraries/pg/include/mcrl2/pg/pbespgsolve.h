@@ -135,6 +135,7 @@ struct pbespgsolve_options
   bool verify_solution;
   bool only_generate;
   data::rewriter::strategy rewrite_strategy;
+  std::size_t number_of_threads;
 
   pbespgsolve_options()
     : solver_type(spm_solver),
@@ -143,7 +144,8 @@ struct pbespgsolve_options
       use_deloop_solver(true),
       verify_solution(true),
       only_generate(false),
-      rewrite_strategy(data::jitty)
+      rewrite_strategy(data::jitty),
+      number_of_threads(1)
   {
   }
 };
@@ -189,7 +191,7 @@ class pbespgsolve_algorithm
       {
         // Wrap solver factory into a component solver factory:
         solver_factory.reset(
-          new ComponentSolverFactory(*solver_factory.release()));
+          new ComponentSolverFactory(*solver_factory.release(), 10, options.number_of_threads));
       }
 
       if (options.use_decycle_solver)
@@ -10,11 +10,51 @@
 #include "mcrl2/pg/ComponentSolver.h"
 #include "mcrl2/pg/attractor.h"
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace {
+
+/*! SCC callback that collects all components in a single array and records
+    for each vertex the index of the component it belongs to. */
+struct ComponentCollector
+{
+    std::vector<verti> vertices;        //!< Vertices of all components
+    std::vector<std::size_t> begin;     //!< Offset of each component, and the end
+    std::vector<verti> component;       //!< Component index of each vertex
+
+    ComponentCollector(verti V)
+        : begin(1, 0), component(V, NO_VERTEX)
+    {
+        vertices.reserve(V);
+    }
+
+    verti size() const { return begin.size() - 1; }
+
+    int operator()(const verti *scc, std::size_t size)
+    {
+        verti c = this->size();
+        for (std::size_t n = 0; n < size; ++n)
+        {
+            vertices.push_back(scc[n]);
+            component[scc[n]] = c;
+        }
+        begin.push_back(vertices.size());
+        return 0;
+    }
+};
+
+} // namespace
+
 ComponentSolver::ComponentSolver(
     const ParityGame &game, ParityGameSolverFactory &pgsf,
-    int max_depth, const verti *vmap, verti vmap_size )
+    int max_depth, const verti *vmap, verti vmap_size,
+    std::size_t number_of_threads )
     : ParityGameSolver(game), pgsf_(pgsf), max_depth_(max_depth),
-      vmap_(vmap), vmap_size_(vmap_size)
+      vmap_(vmap), vmap_size_(vmap_size), number_of_threads_(number_of_threads)
 {
     pgsf_.ref();
 }
@@ -31,7 +71,9 @@ ParityGame::Strategy ComponentSolver::solve()
     DenseSet<verti> W0(0, V), W1(0, V);
     winning_[0] = &W0;
     winning_[1] = &W1;
-    if (decompose_graph(game_.graph(), *this) != 0) strategy_.clear();
+    int res = number_of_threads_ > 1 ? solve_in_parallel()
+                                     : decompose_graph(game_.graph(), *this);
+    if (res != 0) strategy_.clear();
     winning_[0] = NULL;
     winning_[1] = NULL;
     ParityGame::Strategy result;
@@ -46,6 +88,153 @@ int ComponentSolver::operator()(const verti *vertices, std::size_t num_vertices)
     assert(num_vertices > 0);
 
     // Filter out solved vertices:
+    std::vector<verti> unsolved = unsolved_vertices(vertices, num_vertices);
+    if (unsolved.empty()) return 0;
+
+    ParityGame subgame;
+    ParityGame::Strategy substrat = solve_component(subgame, unsolved, num_vertices);
+    if (substrat.empty()) return -1;  // solving failed
+
+    add_solution(subgame, substrat, unsolved);
+    return 0;
+}
+
+int ComponentSolver::solve_in_parallel()
+{
+    const StaticGraph &graph = game_.graph();
+
+    // Collect the components; they are found in reverse topological order.
+    ComponentCollector components(graph.V());
+    decompose_graph(graph, components);
+    const verti C = components.size();
+    mCRL2log(mcrl2::log::verbose, "ComponentSolver") << "Solving " << C << " SCCs with "
+                                                     << number_of_threads_ << " threads..." << std::endl;
+
+    /* Determine for each component the number of distinct components it has
+       edges to, and for each component the list of components that have edges
+       to it.  The first pass counts, the second pass fills in the lists. */
+    std::vector<verti> pending(C, 0);
+    std::vector<std::size_t> pred_begin(C + 1, 0);
+    std::vector<std::size_t> pred_end;
+    std::vector<verti> preds;
+    std::vector<verti> last_seen(C);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        std::fill(last_seen.begin(), last_seen.end(), NO_VERTEX);
+        for (verti c = 0; c < C; ++c)
+        {
+            for (std::size_t n = components.begin[c]; n < components.begin[c + 1]; ++n)
+            {
+                verti v = components.vertices[n];
+                for (StaticGraph::const_iterator it = graph.succ_begin(v);
+                     it != graph.succ_end(v); ++it)
+                {
+                    verti d = components.component[*it];
+                    if (d == c || last_seen[d] == c) continue;
+                    last_seen[d] = c;
+                    if (pass == 0)
+                    {
+                        ++pending[c];
+                        ++pred_begin[d + 1];
+                    }
+                    else
+                    {
+                        preds[pred_end[d]++] = c;
+                    }
+                }
+            }
+        }
+        if (pass == 0)
+        {
+            std::partial_sum(pred_begin.begin(), pred_begin.end(), pred_begin.begin());
+            preds.resize(pred_begin[C]);
+            pred_end.assign(pred_begin.begin(), pred_begin.end() - 1);
+        }
+    }
+
+    // Components without outgoing edges can be solved immediately.
+    std::deque<verti> ready;
+    for (verti c = 0; c < C; ++c)
+    {
+        if (pending[c] == 0) ready.push_back(c);
+    }
+
+    /* The winning sets, the strategy and the scheduling data are only accessed
+       while holding `mutex`; subgames are constructed and solved without it. */
+    std::mutex mutex;
+    std::condition_variable cv;
+    verti finished = 0;
+    bool failed = false;
+    std::exception_ptr error;
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        try
+        {
+            while (true)
+            {
+                cv.wait(lock, [&]() { return failed || finished == C || !ready.empty(); });
+                if (failed || finished == C) return;
+
+                verti c = ready.front();
+                ready.pop_front();
+                std::size_t num_vertices = components.begin[c + 1] - components.begin[c];
+                std::vector<verti> unsolved = unsolved_vertices(
+                    &components.vertices[components.begin[c]], num_vertices );
+
+                bool solved = !aborted();
+                if (solved && !unsolved.empty())
+                {
+                    lock.unlock();
+                    ParityGame subgame;
+                    ParityGame::Strategy substrat = solve_component(subgame, unsolved, num_vertices);
+                    lock.lock();
+                    solved = !substrat.empty();
+                    if (solved) add_solution(subgame, substrat, unsolved);
+                }
+                if (!solved)
+                {
+                    failed = true;
+                    cv.notify_all();
+                    return;
+                }
+
+                ++finished;
+                for (std::size_t n = pred_begin[c]; n < pred_begin[c + 1]; ++n)
+                {
+                    if (--pending[preds[n]] == 0) ready.push_back(preds[n]);
+                }
+                cv.notify_all();
+            }
+        }
+        catch (...)
+        {
+            // An exception of a subsolver, e.g. std::bad_alloc, stops all
+            // threads and is rethrown after they have been joined.
+            if (!lock.owns_lock()) lock.lock();
+            if (!error) error = std::current_exception();
+            failed = true;
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < number_of_threads_; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+    for (std::thread &t : threads)
+    {
+        t.join();
+    }
+    if (error) std::rethrow_exception(error);
+    return failed ? -1 : 0;
+}
+
+std::vector<verti> ComponentSolver::unsolved_vertices(
+    const verti *vertices, std::size_t num_vertices ) const
+{
     std::vector<verti> unsolved;
     unsolved.reserve(num_vertices);
     for (std::size_t n = 0; n < num_vertices; ++n)
@@ -58,11 +247,13 @@ int ComponentSolver::operator()(const verti *vertices, std::size_t num_vertices)
     }
     mCRL2log(mcrl2::log::verbose, "ComponentSolver") << "SCC of size " << num_vertices << " with "
                                                      << unsolved.size() << " unsolved vertices..." << std::endl;
+    return unsolved;
+}
 
-    if (unsolved.empty()) return 0;
-
+ParityGame::Strategy ComponentSolver::solve_component( ParityGame &subgame,
+    const std::vector<verti> &unsolved, std::size_t num_vertices )
+{
     // Construct a subgame for unsolved vertices in this component:
-    ParityGame subgame;
     subgame.make_subgame(game_, unsolved.begin(), unsolved.end(), true);
 
     ParityGame::Strategy substrat;
@@ -106,8 +297,12 @@ int ComponentSolver::operator()(const verti *vertices, std::size_t num_vertices)
         }
         subsolver->solve().swap(substrat);
     }
-    if (substrat.empty()) return -1;  // solving failed
+    return substrat;
+}
 
+void ComponentSolver::add_solution( const ParityGame &subgame,
+    const ParityGame::Strategy &substrat, const std::vector<verti> &unsolved )
+{
     mCRL2log(mcrl2::log::verbose, "ComponentSolver") << "Merging strategies..." << std::endl;
     merge_strategies(strategy_, substrat, unsolved);
 
@@ -131,12 +326,11 @@ int ComponentSolver::operator()(const verti *vertices, std::size_t num_vertices)
     }
 
     mCRL2log(mcrl2::log::verbose, "ComponentSolver") << "Leaving." << std::endl;
-    return 0;
 }
 
 ParityGameSolver *ComponentSolverFactory::create( const ParityGame &game,
         const verti *vertex_map, verti vertex_map_size )
 {
-    return new ComponentSolver( game, pgsf_, max_depth_, 
-                                vertex_map, vertex_map_size );
+    return new ComponentSolver( game, pgsf_, max_depth_,
+                                vertex_map, vertex_map_size, number_of_threads_ );
 }
@@ -0,0 +1,107 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file component_solver_test.cpp
+/// \brief Tests whether solving the strongly connected components of a parity game
+///        with multiple threads yields the same winners as solving them with one thread.
+
+#define BOOST_TEST_MODULE component_solver_test
+#include <boost/test/included/unit_test.hpp>
+
+#include "mcrl2/pg/ComponentSolver.h"
+#include "mcrl2/pg/PredecessorLiftingStrategy.h"
+#include "mcrl2/pg/PriorityPromotionSolver.h"
+#include "mcrl2/pg/RecursiveSolver.h"
+#include "mcrl2/pg/SmallProgressMeasures.h"
+
+// Solves the game with a component solver that uses the given number of threads and subsolvers created by
+// factory. The strategy is verified, and the winners of all vertices are returned.
+static std::vector<ParityGame::Player> solve(const ParityGame& game, ParityGameSolverFactory& factory, std::size_t number_of_threads)
+{
+  ComponentSolverFactory component_factory(factory, 10, number_of_threads);
+  std::unique_ptr<ParityGameSolver> solver(component_factory.create(game, nullptr, 0));
+  ParityGame::Strategy strategy = solver->solve();
+  BOOST_REQUIRE(!strategy.empty());
+
+  verti error_vertex;
+  BOOST_CHECK(game.verify(strategy, &error_vertex));
+
+  std::vector<ParityGame::Player> result;
+  for (verti v = 0; v < game.graph().V(); ++v)
+  {
+    result.push_back(game.winner(strategy, v));
+  }
+  return result;
+}
+
+static void test_solver(ParityGameSolverFactory* factory)
+{
+  factory->ref(); // The factory is shared by the component solver factories below.
+  for (unsigned int seed = 1; seed <= 10; ++seed)
+  {
+    // A clustered random game consists of many strongly connected components, many of which are independent.
+    std::srand(seed);
+    ParityGame game;
+    game.make_random(1000, 50, 3, StaticGraph::EDGE_BIDIRECTIONAL, 4);
+
+    const std::vector<ParityGame::Player> expected = solve(game, *factory, 1);
+    BOOST_CHECK(solve(game, *factory, 4) == expected);
+  }
+  factory->deref();
+}
+
+BOOST_AUTO_TEST_CASE(test_small_progress_measures)
+{
+  test_solver(new SmallProgressMeasuresSolverFactory(std::make_shared<PredecessorLiftingStrategyFactory>(), 2, false));
+}
+
+BOOST_AUTO_TEST_CASE(test_recursive)
+{
+  test_solver(new RecursiveSolverFactory);
+}
+
+BOOST_AUTO_TEST_CASE(test_priority_promotion)
+{
+  test_solver(new PriorityPromotionSolverFactory);
+}
+
+// Creates solvers that fail with an exception.
+class ThrowingSolverFactory : public ParityGameSolverFactory
+{
+  class ThrowingSolver : public ParityGameSolver
+  {
+  public:
+    ThrowingSolver(const ParityGame& game)
+      : ParityGameSolver(game)
+    {}
+
+    ParityGame::Strategy solve() override
+    {
+      throw std::bad_alloc();
+    }
+  };
+
+public:
+  ParityGameSolver* create(const ParityGame& game, const verti*, verti) override
+  {
+    return new ThrowingSolver(game);
+  }
+};
+
+BOOST_AUTO_TEST_CASE(test_exception_in_thread)
+{
+  std::srand(1);
+  ParityGame game;
+  game.make_random(1000, 50, 3, StaticGraph::EDGE_BIDIRECTIONAL, 4);
+
+  ThrowingSolverFactory factory;
+  factory.ref(); // The factory is not deleted by the component solver factory.
+  ComponentSolverFactory component_factory(factory, 10, 4);
+  std::unique_ptr<ParityGameSolver> solver(component_factory.create(game, nullptr, 0));
+  BOOST_CHECK_THROW(solver->solve(), std::bad_alloc);
+}
@@ -30,6 +30,7 @@ struct symbolic_reachability_options
   data::rewrite_strategy rewrite_strategy = data::jitty;
   std::size_t max_workers = 0;
   std::size_t max_iterations = 0;
+  std::size_t learning_threads = 1;
   bool cached = false;
   bool chaining = false;
   bool detect_deadlocks = false;
@@ -52,6 +53,7 @@ inline
 std::ostream& operator<<(std::ostream& out, const symbolic_reachability_options& options)
 {
   out << "rewrite-strategy = " << options.rewrite_strategy << std::endl;
+  out << "learning-threads = " << options.learning_threads << std::endl;
   out << "cached = " << std::boolalpha << options.cached << std::endl;
   out << "chaining = " << std::boolalpha << options.chaining << std::endl;
   out << "detect_deadlocks = " << std::boolalpha << options.detect_deadlocks << std::endl;
@@ -175,10 +177,9 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
                            },
                            data::is_false
       );
-
-      ++i;
     }
     data::remove_assignments(sigma, smd.variables);
+    ++i;
   }
   data::remove_assignments(sigma, group.read_parameters);
   group.learn_calls += 1;
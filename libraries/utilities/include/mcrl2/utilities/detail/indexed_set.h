@@ -35,6 +35,8 @@ static constexpr float max_load_factor = 0.6f; ///< The load factor before the h
 
 static constexpr std::size_t PRIME_NUMBER = 999953;
 
+static constexpr std::size_t RESIZE_CHUNK_SIZE = 4096; ///< The number of keys that a thread reinserts at once when resizing.
+
 #ifndef NDEBUG  // Numbers are small in debug mode for more intensive checks. 
 static constexpr std::size_t minimal_hashtable_size = 16; 
 static constexpr std::size_t RESERVATION_SIZE = 8;
@@ -79,10 +81,15 @@ inline void INDEXED_SET::lock_shared(const std::size_t thread_index) const
     assert(!m_thread_control[thread_index].busy_flag);
     m_thread_control[thread_index].busy_flag.store(true);
     
-    // Wait for the forbidden flag to become false.
+    // Wait for the forbidden flag to become false. If the hash table is being resized, first help
+    // to reinsert its keys. Helping only modifies the hash table, which is therefore logically const.
     while (m_thread_control[thread_index].forbidden_flag.load())
     { 
       m_thread_control[thread_index].busy_flag = false;
+      if (m_resize.in_progress.load())
+      {
+        const_cast<indexed_set*>(this)->help_resize_hashtable();
+      }
       std::unique_lock lock(*m_mutex);
       m_thread_control[thread_index].busy_flag = true;
     }
@@ -198,10 +205,63 @@ inline typename INDEXED_SET::size_type INDEXED_SET::put_in_hashtable(
   return detail::EMPTY;
 }
 
+INDEXED_SET_TEMPLATE
+inline bool INDEXED_SET::reinsert_chunk()
+{
+  const std::size_t first = m_resize.next_key.fetch_add(detail::RESIZE_CHUNK_SIZE);
+  if (first >= m_resize.number_of_keys)
+  {
+    return false;
+  }
+
+  const std::size_t last = std::min(first + detail::RESIZE_CHUNK_SIZE, m_resize.number_of_keys);
+  for (std::size_t index = first; index < last; ++index)
+  {
+    std::size_t new_position;  // The resulting new_position is not used here. 
+    put_in_hashtable(m_keys[index], index, new_position);
+  }
+  m_resize.reinserted_keys.fetch_add(last - first);
+  return true;
+}
+
+INDEXED_SET_TEMPLATE
+inline void INDEXED_SET::help_resize_hashtable()
+{
+  // A thread that registered as helper can rely on the hash table and the keys to remain
+  // unchanged until it leaves, as the resizing thread waits for all helpers to leave.
+  m_resize.helpers.fetch_add(1);
+  if (m_resize.in_progress.load())
+  {
+    while (reinsert_chunk()) {}
+  }
+  m_resize.helpers.fetch_sub(1);
+}
+
 INDEXED_SET_TEMPLATE
 inline void INDEXED_SET::resize_hashtable()
 {
   m_hashtable.assign(m_hashtable.size() * 2, detail::EMPTY);
+
+  if constexpr (ThreadSafe)
+  {
+    if (m_thread_control.size() > 1)
+    {
+      // Reinsert the keys together with the threads waiting in lock_shared. Keys are 
+      // inserted concurrently using compare and swap, as in put_in_hashtable.
+      m_resize.number_of_keys = m_next_index.load();
+      m_resize.next_key.store(0);
+      m_resize.reinserted_keys.store(0);
+      m_resize.in_progress.store(true);
+
+      while (reinsert_chunk()) {}
+      while (m_resize.reinserted_keys.load() < m_resize.number_of_keys) {}
+
+      m_resize.in_progress.store(false);
+      while (m_resize.helpers.load() > 0) {}
+      return;
+    }
+  }
+
   size_t index = 0;
   for (const Key& k: m_keys)
   {
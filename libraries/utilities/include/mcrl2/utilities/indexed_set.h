@@ -73,6 +73,31 @@ struct atomic_size_t_wrapper: public std::atomic<std::size_t>
   }
 };
 
+/// \brief The state of a resize of the hash table of an indexed set. The keys are reinserted
+///        in chunks, which are claimed by the thread that resizes and by all threads that wait
+///        for the resize to finish.
+struct alignas (64) resize_control
+{
+  std::atomic<bool> in_progress{false};
+  std::atomic<std::size_t> next_key{0};       // The first key that has not been claimed yet.
+  std::atomic<std::size_t> reinserted_keys{0};
+  std::atomic<std::size_t> helpers{0};        // The number of threads that are helping.
+  std::size_t number_of_keys = 0;
+
+  resize_control() = default;
+
+  resize_control(const resize_control& )
+  {
+    // Do not copy the state of a resize. 
+  }
+
+  resize_control& operator=(const resize_control& )
+  {
+    // Do not copy the state of a resize. 
+    return *this;
+  }
+};
+
 } // namespace detail
 
 /// \brief A set that assigns each element an unique index.
@@ -91,6 +116,7 @@ private:
   /// \brief Mutex for the m_hashtable and m_keys data structures.
   mutable std::shared_ptr<std::mutex> m_mutex;
   mutable std::vector<detail::thread_control> m_thread_control;
+  detail::resize_control m_resize;
   /// m_next_index indicates the next index that 
   //  has not yet been used. This allows to increase m_keys in 
   //  large steps, avoiding exclusive access too often.  
@@ -113,8 +139,17 @@ private:
   std::size_t put_in_hashtable(const Key& key, std::size_t value, std::size_t& new_position);
 
   /// \brief Resizes the hash table to twice its current size.
+  /// \details With multiple threads, the threads that wait for the exclusive lock help
+  ///          to reinsert the keys, instead of waiting until a single thread has done so.
   inline void resize_hashtable();
 
+  /// \brief Reinserts a chunk of keys of the current resize in the hash table.
+  /// \return False if all chunks have already been claimed.
+  bool reinsert_chunk();
+
+  /// \brief Reinserts chunks of keys if a resize is in progress.
+  void help_resize_hashtable();
+
   void indexed_set_assertion(std::size_t thread_index) const
   {
     assert(m_thread_control.size()==1 || thread_index>0);
@@ -150,19 +185,15 @@ public:
   indexed_set();
 
   /// \brief Constructor of an empty indexed set. 
-  /// \detail With a single thread it delivers contiguous values for states.
-  ///         With multiple threads some indices may be skipped. Each thread
-  ///         reserves numbers, which it hands out. If a thread does not have
-  ///         the opportunity to hand out all numbers, holes in the contiguous
-  ///         numbering can occur. The holes are always of limited size. 
+  /// \detail The indices are contiguous. With multiple threads the order in
+  ///         which the elements are numbered depends on the order of insertion.
   /// \param number_of_threads The number of threads that use this index set. If the number is 1, it is treated
   ///        as a sequential set. If this number is larger than 1, the threads must be numbered
   ///        from 1 up and including number_of_threads. The number 0 cannot be used in that case. 
   indexed_set(std::size_t number_of_threads);
 
   /// \brief Constructor of an empty index set. Starts with a hashtable of the indicated size. 
-  /// \details With one thread the numbering is contiguous. With multiple threads limited size holes
-  ///          can occur in the numbering. 
+  /// \details The numbering is contiguous, also with multiple threads.
   /// \param number_of_threads The number of threads that use this index set. This number is either 1, and then the implementation 
   ///        assumes that the thread has number 0, or it is larger than 1, and it is assumed that threads are numbered from 1 upwards. 
   /// \param initial_hashtable_size The initial size of the hashtable.
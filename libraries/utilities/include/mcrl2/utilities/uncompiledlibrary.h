@@ -115,6 +115,21 @@ class uncompiled_library : public dynamic_library
       m_filename = m_tempfiles.back();
     }
 
+    /// \brief Uses a library that has already been compiled from the given source file, instead
+    ///        of compiling it. Both files are treated like the files produced by the compile script.
+    void use_compiled(const std::string& source_filename, const std::string& library_filename)
+    {
+      m_tempfiles.push_back(source_filename);
+      m_tempfiles.push_back(library_filename);
+      m_filename = library_filename;
+    }
+
+    /// \brief Returns the file that contains the compiled library.
+    const std::string& library_filename() const
+    {
+      return m_filename;
+    }
+
     void leave_files()
     {
       m_tempfiles.clear();
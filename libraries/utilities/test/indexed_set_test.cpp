@@ -9,6 +9,9 @@
 
 #include "mcrl2/utilities/indexed_set.h"
 
+#include <atomic>
+#include <thread>
+
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/included/unit_test.hpp>
 
@@ -49,3 +52,43 @@ BOOST_AUTO_TEST_CASE(basic_test_indexed_set)
   x[2] = t;
 }
 
+
+BOOST_AUTO_TEST_CASE(concurrent_resize_indexed_set)
+{
+  // Start with a small hash table, such that it is resized often while the threads insert keys.
+  const std::size_t number_of_threads = 4;
+  const std::size_t number_of_keys = 100003; // A prime, such that every thread inserts all keys.
+  indexed_set<std::size_t, true> t(number_of_threads, 16);
+
+  // Boost.Test assertions cannot be used in other threads, so inconsistencies are recorded and checked afterwards.
+  std::atomic<bool> consistent(true);
+  std::vector<std::thread> threads;
+  for (std::size_t thread_index = 1; thread_index <= number_of_threads; ++thread_index)
+  {
+    threads.emplace_back([&t, &consistent, thread_index]()
+      {
+        // Every thread inserts all keys, in a different order.
+        for (std::size_t i = 0; i < number_of_keys; ++i)
+        {
+          std::size_t key = (i * (2 * thread_index + 1)) % number_of_keys;
+          std::pair<std::size_t, bool> p = t.insert(key, thread_index);
+          if (t.index(key, thread_index) != p.first)
+          {
+            consistent = false;
+          }
+        }
+      });
+  }
+  for (std::thread& thread: threads)
+  {
+    thread.join();
+  }
+  BOOST_CHECK(consistent);
+
+  BOOST_CHECK_EQUAL(t.size(1), number_of_keys);
+  for (std::size_t key = 0; key < number_of_keys; ++key)
+  {
+    std::size_t index = t.index(key, 1);
+    BOOST_CHECK(index < t.size(1) && t.at(index) == key);
+  }
+}
@@ -55,6 +55,17 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       desc.add_option("no-probability-checking", "do not check if probabilities in stochastic specifications have sensible values");
       desc.add_hidden_option("dfs-recursive", "use recursive depth first search for divergence detection");
       desc.add_option("cached", "use enumeration caching techniques to speed up state space generation. ");
+      desc.add_option("cache-size", utilities::make_mandatory_argument("NUM"),
+                 "keep at most NUM entries in each enumeration cache, evicting the oldest entries first; "
+                 "this option is only relevant in combination with --cached. ");
+      desc.add_option("external", utilities::make_mandatory_argument("DIR"),
+                 "generate the state space breadth first in external memory, where the visited states and the levels "
+                 "are stored in sorted files in a fresh subdirectory of DIR. This allows state spaces that do not fit in memory, "
+                 "but cannot be combined with multiple threads, traces or the detection of deadlocks, actions, nondeterminism and divergences. ");
+      desc.add_option("external-buffer", utilities::make_mandatory_argument("NUM"),
+                 "with --external, sort at most NUM successor states in memory before writing them to disk (default 1000000). ");
+      desc.add_option("compress-states", "store the discovered states as trees of integers instead of terms. "
+                 "This reduces the memory needed for large state spaces at the cost of some extra time per state. ");
       desc.add_option("todo-max", utilities::make_mandatory_argument("NUM"),
                  "keep at most NUM states in the todo list; this option is only relevant for "
                  "highway search, where NUM is the maximum number of states per level. ");
@@ -203,6 +214,7 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       options.save_at_end                           = parser.has_option("save-at-end");
       options.cached                                = parser.has_option("cached");
       options.global_cache                          = parser.has_option("global-cache");
+      options.compress_states                       = parser.has_option("compress-states");
       options.confluence                            = parser.has_option("confluence");
       options.one_point_rule_rewrite                = !parser.has_option("no-one-point-rule-rewrite");
       options.remove_unused_rewrite_rules           = !parser.has_option("no-remove-unused-rewrite-rules");
@@ -217,11 +229,21 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       options.discard_lts_state_labels              = parser.has_option("no-info");
       options.search_strategy = parser.option_argument_as<lps::exploration_strategy>("strategy");
       options.number_of_threads = number_of_threads();
+      // The threads that are halted during garbage collection are used to mark the terms in parallel.
+      atermpp::detail::g_term_pool().set_garbage_collection_threads(number_of_threads());
       // highway search
       if (parser.has_option("todo-max"))
       {
         options.highway_todo_max = parser.option_argument_as<std::size_t>("todo-max");
       }
+      if (parser.has_option("cache-size"))
+      {
+        if (!options.cached)
+        {
+          parser.error("Option 'cache-size' can only be used in combination with --cached.");
+        }
+        options.cache_size = parser.option_argument_as<std::size_t>("cache-size");
+      }
       if (options.search_strategy == lps::es_highway && !parser.has_option("todo-max"))
       {
         parser.error("Search strategy 'highway' requires that the option todo-max is set.");
@@ -306,6 +328,28 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
         parser.error("Option '--save-at-end' requires that the output is in .aut or .lts format.");
       }
 
+      if (parser.has_option("external"))
+      {
+        options.external_directory = parser.option_argument("external");
+        if (options.number_of_threads > 1 || options.search_strategy != lps::es_breadth || options.max_states != std::numeric_limits<std::size_t>::max())
+        {
+          parser.error("Option '--external' can only be used with one thread, breadth first search and no maximum number of states.");
+        }
+        if (options.detect_deadlock || options.detect_nondeterminism || options.detect_divergence || options.detect_action ||
+            parser.has_option("multiaction") || options.generate_traces || options.save_error_trace)
+        {
+          parser.error("Option '--external' cannot be combined with traces or the detection of deadlocks, actions, nondeterminism and divergences.");
+        }
+      }
+      if (parser.has_option("external-buffer"))
+      {
+        if (!parser.has_option("external"))
+        {
+          parser.error("Option 'external-buffer' can only be used in combination with --external.");
+        }
+        options.external_buffer_size = parser.option_argument_as<std::size_t>("external-buffer");
+      }
+
       if (options.discard_lts_state_labels && (output_filename().empty() || output_format != lts::lts_lts))
       {
         parser.error("Option '--no-info' requires that the output is in .lts format.");
@@ -43,6 +43,7 @@ class lpsreach_tool: public rewriter_tool<input_output_tool>
       desc.add_option("lace-workers", utilities::make_optional_argument("NUM", "1"), "set number of Lace workers (threads for parallelization), (0=autodetect, default 1)");
       desc.add_option("lace-dqsize", utilities::make_optional_argument("NUM", "4194304"), "set length of Lace task queue (default 1024*1024*4)");
       desc.add_option("lace-stacksize", utilities::make_optional_argument("NUM", "0"), "set size of program stack in kilobytes (0=default stack size)");
+      desc.add_option("learning-threads", utilities::make_optional_argument("NUM", "1"), "set number of threads that rewrite the successors of different cubes and summand groups concurrently while learning transitions (default 1)");
       desc.add_option("memory-limit", utilities::make_optional_argument("NUM", "3"), "Sylvan memory limit in gigabytes (default 3)", 'm');
 
       desc.add_option("cached", "use transition group caching to speed up state space exploration");
@@ -97,6 +98,20 @@ class lpsreach_tool: public rewriter_tool<input_output_tool>
       {
         lace_n_workers = parser.option_argument_as<int>("lace-workers");
       }
+      if (parser.has_option("learning-threads"))
+      {
+        options.learning_threads = parser.option_argument_as<std::size_t>("learning-threads");
+        if (options.learning_threads < 1)
+        {
+          throw mcrl2::runtime_error("The number of learning threads should at least be 1.");
+        }
+        if (!atermpp::detail::GlobalThreadSafe && options.learning_threads != 1)
+        {
+          throw mcrl2::runtime_error("This tool is compiled for sequential use. The number of learning threads (now: " +
+                                     std::to_string(options.learning_threads) +
+                                     ") can only be 1.");
+        }
+      }
       if (parser.has_option("lace-dqsize"))
       {
         lace_dqsize = parser.option_argument_as<int>("lace-dqsize");
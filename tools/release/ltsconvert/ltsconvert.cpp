@@ -12,6 +12,7 @@
 #define AUTHOR "Muck van Weerdenburg, Jan Friso Groote"
 
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/lts_algorithm.h"
 
@@ -134,14 +135,16 @@ class t_tool_options
 
 };
 
-class ltsconvert_tool : public input_output_tool
+class ltsconvert_tool : public parallel_tool<input_output_tool>
 {
+  typedef parallel_tool<input_output_tool> super;
+
   private:
     t_tool_options tool_options;
 
   public:
     ltsconvert_tool() :
-      input_output_tool(NAME,AUTHOR,
+      super(NAME,AUTHOR,
                       "convert and optionally minimise an LTS",
                       "Convert the labelled transition system (LTS) from INFILE to OUTFILE in the\n"
                       "requested format after applying the selected minimisation method (default is\n"
@@ -165,7 +168,14 @@ class ltsconvert_tool : public input_output_tool
       using namespace mcrl2::lts::detail;
 
       LTS_TYPE l;
-      l.load(tool_options.infilename);
+      if constexpr (std::is_same<LTS_TYPE, lts_aut_t>::value || std::is_same<LTS_TYPE, probabilistic_lts_aut_t>::value)
+      {
+        l.load(tool_options.infilename, number_of_threads());
+      }
+      else
+      {
+        l.load(tool_options.infilename);
+      }
       l.apply_hidden_actions(tool_options.tau_actions);
 
       if (tool_options.check_reach)
@@ -191,7 +201,7 @@ class ltsconvert_tool : public input_output_tool
           mCRL2log(verbose) << "Reducing LTS (modulo " <<  description(tool_options.equivalence) << ")..." << std::endl;
           mCRL2log(verbose) << "Before reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
           timer().start("reduction");
-          reduce(l,tool_options.equivalence);
+          reduce(l,tool_options.equivalence,number_of_threads());
           timer().finish("reduction");
           mCRL2log(verbose) << "After reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
         }
@@ -321,7 +331,7 @@ class ltsconvert_tool : public input_output_tool
   protected:
     void add_options(interface_description& desc)
     {
-      input_output_tool::add_options(desc);
+      super::add_options(desc);
 
       desc.add_option("no-reach",
                       "do not perform a reachability check on the input LTS.");
@@ -378,7 +388,7 @@ class ltsconvert_tool : public input_output_tool
 
     void parse_options(const command_line_parser& parser)
     {
-      input_output_tool::parse_options(parser);
+      super::parse_options(parser);
 
       if (parser.options.count("lps"))
       {
@@ -0,0 +1,107 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/**
+
+  @file springlayout_benchmark.cpp
+
+  Measures the number of layout iterations per second of the spring layout on
+  a generated graph, without showing a window.
+
+  Usage: benchmark_target_ltsgraph_springlayout [NODES [EDGES [ITERATIONS
+  [THREADS [3D]]]]]
+
+*/
+
+#include "springlayout.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <QApplication>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+/// \brief Writes a random graph in the .aut format, in which every state is
+///        reachable from the initial state.
+static void generate_graph(const std::string& filename, std::size_t nodes,
+                           std::size_t edges)
+{
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<std::size_t> node(0, nodes - 1);
+
+  std::ofstream output(filename);
+  output << "des (0," << std::max(edges, nodes - 1) << "," << nodes << ")\n";
+  for (std::size_t i = 1; i < nodes; ++i)
+  {
+    output << "(" << node(generator) % i << ",\"a\"," << i << ")\n";
+  }
+  for (std::size_t i = nodes - 1; i < edges; ++i)
+  {
+    output << "(" << node(generator) << ",\"b\"," << node(generator) << ")\n";
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t nodes = argc > 1 ? std::stoul(argv[1]) : 10000;
+  std::size_t edges = argc > 2 ? std::stoul(argv[2]) : 3 * nodes;
+  std::size_t iterations = argc > 3 ? std::stoul(argv[3]) : 20;
+  std::size_t threads =
+      argc > 4 ? std::stoul(argv[4]) : std::thread::hardware_concurrency();
+  bool is_3D = argc > 5 && std::string(argv[5]) == "3D";
+
+  // The widget is never shown, so no display is needed.
+  qputenv("QT_QPA_PLATFORM", "offscreen");
+  QApplication application(argc, argv);
+
+  std::string filename =
+      (std::filesystem::temp_directory_path() / "springlayout_benchmark.aut")
+          .string();
+  generate_graph(filename, std::max<std::size_t>(nodes, 2), edges);
+
+  QVector3D limit(2500.0f, 2500.0f, is_3D ? 2500.0f : 0.0f);
+  Graph::Graph graph;
+  graph.load(QString::fromStdString(filename), -limit, limit);
+  graph.clip(-limit, limit);
+  std::remove(filename.c_str());
+
+  GLWidget widget(graph);
+  Graph::SpringLayout layout(graph, widget);
+  layout.setTreeEnabled(true);
+
+  for (std::size_t number_of_threads : {std::size_t(1), threads})
+  {
+    layout.setNumberOfThreads(number_of_threads);
+    layout.resetPositions();
+
+    stopwatch timer;
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+      graph.setStable(false);
+      layout.apply();
+    }
+    double seconds = timer.seconds();
+
+    std::cerr << "threads: " << layout.numberOfThreads() << ", nodes: "
+              << graph.nodeCount() << ", edges: " << graph.edgeCount()
+              << ", time: " << seconds
+              << ", iterations per second: " << iterations / seconds
+              << std::endl;
+
+    if (threads <= 1)
+    {
+      break;
+    }
+  }
+
+  return 0;
+}
@@ -7,6 +7,8 @@
 // Defines abstract attraction function
 // Operator (a, b, ideal) should return the amount of attraction
 //   a experiences towards b, where ideal is a parameter
+// Operator is called concurrently when forces are computed in parallel,
+//   so it should not modify the function object
 struct AttractionFunction
 {
     virtual QVector3D operator()(const QVector3D& a, const QVector3D& b,
@@ -18,6 +20,8 @@ struct AttractionFunction
 // Defines abstract repulsion function
 // Operator (a, b, ideal) should return the amount of repulsion
 //  a experiences as a result of b, where ideal is a parameter
+// Operator is called concurrently when forces are computed in parallel,
+//  so it should not modify the function object
 struct RepulsionFunction
 {
     virtual QVector3D operator()(const QVector3D& a, const QVector3D& b,
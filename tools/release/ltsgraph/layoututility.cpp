@@ -68,4 +68,76 @@ float slicedAverageSqrMagnitude(std::vector<QVector3D>& forces)
   std::function<float(std::size_t)> func = [&forces](std::size_t i)
   { return forces[i].lengthSquared(); };
   return _slicedAverage(0, forces.size(), func, 0.0f);
-}
\ No newline at end of file
+}
+
+WorkerPool::WorkerPool(std::size_t number_of_threads)
+{
+  for (std::size_t i = 1; i < number_of_threads; ++i)
+  {
+    m_threads.emplace_back(&WorkerPool::work, this, i);
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_start.notify_all();
+  for (std::thread& thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+void WorkerPool::run(std::size_t count,
+                     const std::function<void(std::size_t, std::size_t)>& f)
+{
+  if (m_threads.empty() || count < size())
+  {
+    f(0, count);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = &f;
+    m_count = count;
+    m_busy = m_threads.size();
+    ++m_generation;
+  }
+  m_start.notify_all();
+
+  f(0, count / size());
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [this]() { return m_busy == 0; });
+  m_task = nullptr;
+}
+
+void WorkerPool::work(std::size_t index)
+{
+  std::size_t generation = 0;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_start.wait(lock, [&]() { return m_stop || m_generation != generation; });
+    if (m_stop)
+    {
+      return;
+    }
+    generation = m_generation;
+    const std::function<void(std::size_t, std::size_t)>& task = *m_task;
+    std::size_t count = m_count;
+    lock.unlock();
+
+    task(count * index / size(), count * (index + 1) / size());
+
+    lock.lock();
+    if (--m_busy == 0)
+    {
+      m_done.notify_one();
+    }
+  }
+}
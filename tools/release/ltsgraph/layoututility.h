@@ -25,6 +25,10 @@
 #include <QVector2D>
 #include <QVector3D>
 #include <assert.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <mcrl2/utilities/logger.h>
 #include <graph.h>
@@ -120,6 +124,52 @@ ReturnType _slicedAverage(std::size_t i, std::size_t j,
 QVector3D slicedAverage(Graph::Graph& graph);
 float slicedAverageSqrMagnitude(std::vector<QVector3D>& forces);
 
+///
+/// Parallel loops
+///
+
+/// @brief A fixed set of worker threads that jointly execute loops over a
+/// range of indices. The threads are created once and wait between loops, so
+/// that the forces of every layout iteration can be computed in parallel
+/// without the cost of starting threads.
+class WorkerPool
+{
+  public:
+  /// @brief Creates a pool in which @p number_of_threads threads, including
+  /// the calling thread, execute the loops.
+  explicit WorkerPool(std::size_t number_of_threads);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /// @brief Returns the number of threads that execute a loop.
+  std::size_t size() const
+  {
+    return m_threads.size() + 1;
+  }
+
+  /// @brief Splits [0, count) into consecutive chunks, one per thread, and
+  /// calls f(begin, end) on every chunk. The calling thread handles the first
+  /// chunk and the function returns when all chunks are done.
+  /// @pre f can be called concurrently on disjoint chunks.
+  void run(std::size_t count,
+           const std::function<void(std::size_t, std::size_t)>& f);
+
+  private:
+  void work(std::size_t index);
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_start; ///< Signals a new loop or termination.
+  std::condition_variable m_done;  ///< Signals that all chunks are done.
+  const std::function<void(std::size_t, std::size_t)>* m_task = nullptr;
+  std::size_t m_count = 0;      ///< Length of the range of the current loop.
+  std::size_t m_generation = 0; ///< Number of loops started so far.
+  std::size_t m_busy = 0;       ///< Number of workers still in the loop.
+  bool m_stop = false;
+};
+
 ///
 /// Tree specifications below
 ///
@@ -194,12 +244,29 @@ class GeometricTree
    */
   /// TODO: Complete asserts i.e. bounds checking
   std::vector<TreeNode<T>*>& getSuperNodes(const T& node_pos)
+  {
+    getSuperNodes(node_pos, m_super_nodes);
+    return m_super_nodes;
+  }
+
+  /**
+   * @brief Fills \p super_nodes with nodes relevant to \p node_pos . Only
+   * reads the tree, so it can be called by multiple threads at once, as long
+   * as every thread provides its own \p super_nodes .
+   *
+   * @param node_pos Position of node to which super nodes are relative.
+   * @param super_nodes Vector that is cleared and filled with the super nodes.
+   *
+   * @pre Super node weighted averages have been computed throughout the entire
+   * tree.
+   */
+  void getSuperNodes(const T& node_pos,
+                     std::vector<TreeNode<T>*>& super_nodes)
   {
     assert(this->m_sub_positions_calculated);
-    m_super_nodes.resize(0);
+    super_nodes.resize(0);
     T extents = m_maxbounds - m_minbounds;
-    sub_supnodes(node_pos, 0, extents);
-    return m_super_nodes;
+    sub_supnodes(node_pos, 0, extents, super_nodes);
   }
 
   /**
@@ -343,9 +410,11 @@ class GeometricTree
    * @param i Current index in tree structure.
    * @param node_extents Extents of the current bounding area/volume. Used for
    * opening \property criterion.
+   * @param super_nodes Vector to which the super nodes are added.
    */
   /// TODO: Iterative instead of recursive.
-  void sub_supnodes(const T& node_pos, std::size_t i, T& node_extents)
+  void sub_supnodes(const T& node_pos, std::size_t i, T& node_extents,
+                    std::vector<TreeNode<T>*>& super_nodes)
   {
     // we should never recurse on an empty subtree
     assert(this->m_data[i].children != TreeNodeTypes::EMPTY_NODE);
@@ -353,7 +422,7 @@ class GeometricTree
     if (m_data[i].children == 1)
     {
       // has to be a supernode
-      m_super_nodes.push_back(&m_data[i]);
+      super_nodes.push_back(&m_data[i]);
     }
     else
     {
@@ -361,7 +430,7 @@ class GeometricTree
       // if satisfied we stop recursing and add to super_nodes
       if (criterion(m_data[i], node_extents, node_pos, m_theta))
       {
-        m_super_nodes.push_back(&m_data[i]);
+        super_nodes.push_back(&m_data[i]);
       }
       else
       {
@@ -372,7 +441,7 @@ class GeometricTree
           std::size_t child_index = i + m_data[i].offset + j;
           if (m_data[child_index].children > 0)
           {
-            sub_supnodes(node_pos, child_index, node_extents);
+            sub_supnodes(node_pos, child_index, node_extents, super_nodes);
           }
         }
         node_extents *= 2;
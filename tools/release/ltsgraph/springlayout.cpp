@@ -13,6 +13,7 @@
 
 #include <QWidget>
 #include <QThread>
+#include <algorithm>
 #include <cstdlib>
 #include <cmath>
 
@@ -120,7 +121,8 @@ bool SimpleAdaptiveSimulatedAnnealing::calculateTemperature(float new_energy)
 //
 
 SpringLayout::SpringLayout(Graph& graph, GLWidget& glwidget)
-    : m_node_tree(0, {0, 0, 0}, {0, 0, 0}),
+    : m_pool(new WorkerPool(1)),
+      m_node_tree(0, {0, 0, 0}, {0, 0, 0}),
       m_handle_tree(0, {0, 0, 0}, {0, 0, 0}), 
       m_trans_tree(0, {0, 0, 0}, {0, 0, 0}),
       m_node_tree2D(0, {0, 0}, {0, 0}),
@@ -239,6 +241,7 @@ SpringLayoutUi* SpringLayout::ui(QAction* advancedDialogAction, CustomQWidget* a
 
     settings->registerVar(advanced_ui.txt_stab_thres, QString::number(m_stabilityThreshold), true);
     settings->registerVar(advanced_ui.txt_stab_iters, QString::number(m_stabilityMaxCount), true);
+    settings->registerVar(advanced_ui.txt_threads, QString::number(1), true);
 
     m_ui->m_ui.dispHandleWeight->setText(
         QString::number(m_controlPointWeight, 'g', 3));
@@ -338,32 +341,28 @@ ApplicationFunctionID SpringLayout::forceApplication()
 }
 
 template <>
-QVector3D SpringLayout::approxRepulsionForce<Octree>(const QVector3D& a,
-                                                     Octree& tree)
+QVector3D SpringLayout::approxRepulsionForce<Octree>(
+    const QVector3D& a, Octree& tree,
+    std::vector<TreeNode<QVector3D>*>& super_nodes)
 {
   QVector3D force(0, 0, 0);
-  std::size_t num_nodes = 0;
-  auto& super_nodes = tree.getSuperNodes(a);
+  tree.getSuperNodes(a, super_nodes);
   for (auto super_node : super_nodes)
   {
     force +=
         super_node->children * (*m_repFunc)(a, super_node->pos, m_natLength);
   }
   force *= m_repulsion;
-  num_nodes = super_nodes.size();
-
-  m_max_num_nodes = std::max(m_max_num_nodes, num_nodes);
-  m_total_num_nodes += num_nodes;
   return force;
 }
 
 template <>
-QVector3D SpringLayout::approxRepulsionForce<Quadtree>(const QVector3D& a,
-                                                       Quadtree& tree)
+QVector3D SpringLayout::approxRepulsionForce<Quadtree>(
+    const QVector3D& a, Quadtree& tree,
+    std::vector<TreeNode<QVector2D>*>& super_nodes)
 {
   QVector3D force(0, 0, 0);
-  std::size_t num_nodes = 0;
-  auto& super_nodes = tree.getSuperNodes({a.x(), a.y()});
+  tree.getSuperNodes({a.x(), a.y()}, super_nodes);
   for (auto super_node : super_nodes)
   {
     force += super_node->children *
@@ -371,13 +370,51 @@ QVector3D SpringLayout::approxRepulsionForce<Quadtree>(const QVector3D& a,
                           m_natLength);
   }
   force *= m_repulsion;
-  num_nodes = super_nodes.size();
-
-  m_max_num_nodes = std::max(m_max_num_nodes, num_nodes);
-  m_total_num_nodes += num_nodes;
   return force;
 }
 
+void SpringLayout::forEachChunk(
+    ThreadingMode threadingMode, std::size_t count,
+    const std::function<void(std::size_t, std::size_t)>& f)
+{
+  switch (threadingMode)
+  {
+  case ThreadingMode::normal:
+    f(0, count);
+    break;
+  case ThreadingMode::parallel:
+    m_pool->run(count, f);
+    break;
+  }
+}
+
+template <typename TreeType, typename Position>
+void SpringLayout::approxRepulsionAccumulation(ThreadingMode threadingMode,
+                                               std::size_t count,
+                                               TreeType& tree,
+                                               Position position,
+                                               std::vector<QVector3D>& forces)
+{
+  // The tree is only read, so every thread traverses it with its own buffer
+  // for the super nodes and writes to its own chunk of the forces.
+  forEachChunk(threadingMode, count, [&](std::size_t begin, std::size_t end) {
+    std::vector<TreeNode<typename TreeType::data_t>*> super_nodes;
+    std::size_t max_num_nodes = 0;
+    std::size_t total_num_nodes = 0;
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      forces[i] +=
+          approxRepulsionForce<TreeType>(position(i), tree, super_nodes);
+      max_num_nodes = std::max(max_num_nodes, super_nodes.size());
+      total_num_nodes += super_nodes.size();
+    }
+
+    std::lock_guard<std::mutex> lock(m_statistics_mutex);
+    m_max_num_nodes = std::max(m_max_num_nodes, max_num_nodes);
+    m_total_num_nodes += total_num_nodes;
+  });
+}
+
 
 int iterations = 0;
 
@@ -436,8 +473,73 @@ void SpringLayout::attractionAccumulation<SpringLayout::ThreadingMode::normal>(
 }
 
 template <>
-void SpringLayout::repulsionAccumulation<SpringLayout::TreeMode::quadtree>(
+void SpringLayout::attractionAccumulation<SpringLayout::ThreadingMode::parallel>(
     bool sel, std::size_t nodeCount, std::size_t edgeCount)
+{
+  std::vector<std::size_t> nodeLocations(m_graph.nodeCount());
+  m_pool->run(nodeCount, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      std::size_t n = sel ? m_graph.explorationNode(i) : i;
+      nodeLocations[n] = i;
+      m_nforces[i] = {0, 0, 0};
+      m_sforces[i] = (*m_attrFunc)(m_graph.node(n).pos(),
+                                   m_graph.stateLabel(n).pos(), 0.0) *
+                     m_attraction;
+    }
+  });
+
+  // The spring force of an edge acts on both of its nodes, which can be in the
+  // chunk of another thread. So every thread only stores the spring forces of
+  // its own edges, which are added to the node forces afterwards.
+  m_eforces.resize(edgeCount);
+  m_pool->run(edgeCount, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      std::size_t n = sel ? m_graph.explorationEdge(i) : i;
+
+      const Edge& e = m_graph.edge(n);
+      std::size_t from = e.from();
+      std::size_t to = e.to();
+
+      m_hforces[i] = QVector3D(0, 0, 0);
+      m_lforces[i] = QVector3D(0, 0, 0);
+
+      if (e.is_selfloop())
+      {
+        m_hforces[i] += (*m_repFunc)(m_graph.handle(n).pos(),
+                                     m_graph.node(from).pos(), m_natLength) *
+                        m_repulsion;
+      }
+
+      m_eforces[i] = (*m_attrFunc)(m_graph.node(to).pos(),
+                                   m_graph.node(from).pos(), m_natLength) *
+                     m_attraction;
+
+      m_hforces[i] += (*m_attrFunc)((m_graph.node(to).pos() +
+                                     m_graph.node(from).pos()) /
+                                        2.0,
+                                    m_graph.handle(n).pos(), 0.0) *
+                      m_attraction;
+
+      m_lforces[i] += (*m_attrFunc)(m_graph.handle(n).pos(),
+                                    m_graph.transitionLabel(n).pos(), 0.0) *
+                      m_attraction;
+    }
+  });
+
+  for (std::size_t i = 0; i < edgeCount; ++i)
+  {
+    const Edge& e = m_graph.edge(sel ? m_graph.explorationEdge(i) : i);
+    m_nforces[nodeLocations[e.from()]] += m_eforces[i];
+    m_nforces[nodeLocations[e.to()]] -= m_eforces[i];
+  }
+}
+
+template <>
+void SpringLayout::repulsionAccumulation<SpringLayout::TreeMode::quadtree>(
+    bool sel, std::size_t nodeCount, std::size_t edgeCount,
+    ThreadingMode threadingMode)
 {
   /// TODO: Fix blatant code duplication
   QVector2D node_min = {INFINITY, INFINITY}, node_max = {-INFINITY, -INFINITY},
@@ -538,12 +640,12 @@ void SpringLayout::repulsionAccumulation<SpringLayout::TreeMode::quadtree>(
   m_node_tree2D.calculatePositions();
 
   // approx repulsive forces for nodes
-  for (std::size_t i = 0; i < nodeCount; ++i)
-  {
-    std::size_t n = sel ? m_graph.explorationNode(i) : i;
-    m_nforces[i] +=
-        approxRepulsionForce<Quadtree>(m_graph.node(n).pos(), m_node_tree2D);
-  }
+  approxRepulsionAccumulation(
+      threadingMode, nodeCount, m_node_tree2D,
+      [&](std::size_t i) {
+        return m_graph.node(sel ? m_graph.explorationNode(i) : i).pos();
+      },
+      m_nforces);
 
   for (std::size_t i = 0; i < edgeCount; ++i)
   {
@@ -559,20 +661,26 @@ void SpringLayout::repulsionAccumulation<SpringLayout::TreeMode::quadtree>(
   // approximate repulsive forces
   float temp = m_repulsion;
   m_repulsion *= m_controlPointWeight;
-  for (std::size_t i = 0; i < edgeCount; ++i)
-  {
-    std::size_t n = sel ? m_graph.explorationEdge(i) : i;
-    m_hforces[i] += approxRepulsionForce<Quadtree>(m_graph.handle(n).pos(),
-                                                   m_handle_tree2D);
-    m_lforces[i] += approxRepulsionForce<Quadtree>(
-        m_graph.transitionLabel(n).pos(), m_trans_tree2D);
-  }
+  approxRepulsionAccumulation(
+      threadingMode, edgeCount, m_handle_tree2D,
+      [&](std::size_t i) {
+        return m_graph.handle(sel ? m_graph.explorationEdge(i) : i).pos();
+      },
+      m_hforces);
+  approxRepulsionAccumulation(
+      threadingMode, edgeCount, m_trans_tree2D,
+      [&](std::size_t i) {
+        return m_graph.transitionLabel(sel ? m_graph.explorationEdge(i) : i)
+            .pos();
+      },
+      m_lforces);
   m_repulsion = temp;
 }
 
 template <>
 void SpringLayout::repulsionAccumulation<SpringLayout::TreeMode::octree>(
-    bool sel, std::size_t nodeCount, std::size_t edgeCount)
+    bool sel, std::size_t nodeCount, std::size_t edgeCount,
+    ThreadingMode threadingMode)
 {
   /// TODO: Fix blatant code duplication
   QVector3D node_min = {INFINITY, INFINITY, INFINITY},
@@ -680,12 +788,12 @@ void SpringLayout::repulsionAccumulation<SpringLayout::TreeMode::octree>(
   m_node_tree.calculatePositions();
 
   // approx repulsive forces for nodes
-  for (std::size_t i = 0; i < nodeCount; ++i)
-  {
-    std::size_t n = sel ? m_graph.explorationNode(i) : i;
-    m_nforces[i] +=
-        approxRepulsionForce<Octree>(m_graph.node(n).pos(), m_node_tree);
-  }
+  approxRepulsionAccumulation(
+      threadingMode, nodeCount, m_node_tree,
+      [&](std::size_t i) {
+        return m_graph.node(sel ? m_graph.explorationNode(i) : i).pos();
+      },
+      m_nforces);
 
   for (std::size_t i = 0; i < edgeCount; ++i)
   {
@@ -700,21 +808,75 @@ void SpringLayout::repulsionAccumulation<SpringLayout::TreeMode::octree>(
   // approximate repulsive forces
   const float temp = m_repulsion;
   m_repulsion *= m_controlPointWeight;
-  for (std::size_t i = 0; i < edgeCount; ++i)
-  {
-    std::size_t n = sel ? m_graph.explorationEdge(i) : i;
-    m_hforces[i] +=
-        approxRepulsionForce<Octree>(m_graph.handle(n).pos(), m_handle_tree);
-    m_lforces[i] += approxRepulsionForce<Octree>(
-        m_graph.transitionLabel(n).pos(), m_trans_tree);
-  }
+  approxRepulsionAccumulation(
+      threadingMode, edgeCount, m_handle_tree,
+      [&](std::size_t i) {
+        return m_graph.handle(sel ? m_graph.explorationEdge(i) : i).pos();
+      },
+      m_hforces);
+  approxRepulsionAccumulation(
+      threadingMode, edgeCount, m_trans_tree,
+      [&](std::size_t i) {
+        return m_graph.transitionLabel(sel ? m_graph.explorationEdge(i) : i)
+            .pos();
+      },
+      m_lforces);
   m_repulsion = temp;
 }
 
 template <>
 void SpringLayout::repulsionAccumulation<SpringLayout::TreeMode::none>(
-    bool sel, std::size_t nodeCount, std::size_t edgeCount)
+    bool sel, std::size_t nodeCount, std::size_t edgeCount,
+    ThreadingMode threadingMode)
 {
+  if (threadingMode == ThreadingMode::parallel)
+  {
+    // Every thread computes the total force on its own chunk of nodes, so
+    // the force between two nodes is computed twice instead of being
+    // written to both of them.
+    m_pool->run(nodeCount, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        std::size_t n = sel ? m_graph.explorationNode(i) : i;
+        for (std::size_t j = 0; j < nodeCount; ++j)
+        {
+          std::size_t m = sel ? m_graph.explorationNode(j) : j;
+          if (i != j)
+          {
+            m_nforces[i] += (*m_repFunc)(m_graph.node(n).pos(),
+                                         m_graph.node(m).pos(), m_natLength) *
+                            m_repulsion;
+          }
+        }
+      }
+    });
+
+    const float repulsion_force_control_point =
+        m_repulsion * m_controlPointWeight;
+    m_pool->run(edgeCount, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        std::size_t n = sel ? m_graph.explorationEdge(i) : i;
+        for (std::size_t j = 0; j < edgeCount; ++j)
+        {
+          std::size_t m = sel ? m_graph.explorationEdge(j) : j;
+          if (i != j)
+          {
+            m_hforces[i] += (*m_repFunc)(m_graph.handle(n).pos(),
+                                         m_graph.handle(m).pos(),
+                                         m_natLength) *
+                            repulsion_force_control_point;
+            m_lforces[i] += (*m_repFunc)(m_graph.transitionLabel(n).pos(),
+                                         m_graph.transitionLabel(m).pos(),
+                                         m_natLength) *
+                            repulsion_force_control_point;
+          }
+        }
+      }
+    });
+    return;
+  }
+
   // used for storing intermediate results
   QVector3D f;
   // repulsive forces for nodes
@@ -765,19 +927,25 @@ void SpringLayout::forceAccumulation(bool sel, std::size_t nodeCount,
   case ThreadingMode::normal:
     attractionAccumulation<ThreadingMode::normal>(sel, nodeCount, edgeCount);
     break;
+  case ThreadingMode::parallel:
+    attractionAccumulation<ThreadingMode::parallel>(sel, nodeCount, edgeCount);
+    break;
   }
   if (m_option_repulsionCalculation != RepulsionFunctionID::none_rep)
   {
     switch (treeMode)
     {
     case TreeMode::none:
-      repulsionAccumulation<TreeMode::none>(sel, nodeCount, edgeCount);
+      repulsionAccumulation<TreeMode::none>(sel, nodeCount, edgeCount,
+                                            threadingMode);
       break;
     case TreeMode::quadtree:
-      repulsionAccumulation<TreeMode::quadtree>(sel, nodeCount, edgeCount);
+      repulsionAccumulation<TreeMode::quadtree>(sel, nodeCount, edgeCount,
+                                                threadingMode);
       break;
     case TreeMode::octree:
-      repulsionAccumulation<TreeMode::octree>(sel, nodeCount, edgeCount);
+      repulsionAccumulation<TreeMode::octree>(sel, nodeCount, edgeCount,
+                                              threadingMode);
       break;
     }
   }
@@ -830,10 +998,20 @@ void SpringLayout::apply()
     m_sforces.resize(nodeCount);
     m_hforces.resize(edgeCount);
     m_lforces.resize(edgeCount);
+    if (m_pool->size() != m_number_of_threads)
+    {
+      m_pool.reset(new WorkerPool(m_number_of_threads));
+    }
     std::fill(m_nforces.begin(), m_nforces.end(), QVector3D(0, 0, 0));
     std::fill(m_sforces.begin(), m_sforces.end(), QVector3D(0, 0, 0));
     std::fill(m_hforces.begin(), m_hforces.end(), QVector3D(0, 0, 0));
     std::fill(m_lforces.begin(), m_lforces.end(), QVector3D(0, 0, 0));
+
+    // Distributing the work over the threads only pays off for larger graphs.
+    ThreadingMode threadingMode =
+        (m_pool->size() > 1 && nodeCount + edgeCount >= m_parallel_threshold)
+            ? ThreadingMode::parallel
+            : ThreadingMode::normal;
     if (m_tree_enabled)
     {
       bool is_2D =
@@ -841,18 +1019,18 @@ void SpringLayout::apply()
       if (is_2D)
       {
         forceAccumulation(sel, nodeCount, edgeCount, TreeMode::quadtree,
-                          ThreadingMode::normal);
+                          threadingMode);
       }
       else
       {
         forceAccumulation(sel, nodeCount, edgeCount, TreeMode::octree,
-                          ThreadingMode::normal);
+                          threadingMode);
       }
     }
     else
     {
       forceAccumulation(sel, nodeCount, edgeCount, TreeMode::none,
-                        ThreadingMode::normal);
+                        threadingMode);
     }
 
     QVector3D clipmin = m_graph.getClipMin();
@@ -980,13 +1158,19 @@ void SpringLayout::apply()
       {
           m_graph.setStable(true);
           mCRL2log(mcrl2::log::debug) << "The graph is now stable." << std::endl;
-          m_ui->m_ui.lblStable->setText("Stable");
+          if (m_ui)
+          {
+            m_ui->m_ui.lblStable->setText("Stable");
+          }
       }
     }
     else
     {
       m_stabilityCounter = 0;
-      m_ui->m_ui.lblStable->setText("");
+      if (m_ui)
+      {
+        m_ui->m_ui.lblStable->setText("");
+      }
     }
     m_previous_energy = energy;
 
@@ -1044,6 +1228,16 @@ void SpringLayout::setTreeEnabled(bool b)
       << (b ? "Enabled" : "Disabled") << " tree acceleration." << std::endl;
 }
 
+void SpringLayout::setNumberOfThreads(std::size_t number_of_threads)
+{
+  // The pool itself is replaced by apply(), as it can be in use by the layout
+  // thread at this moment.
+  m_number_of_threads = std::max<std::size_t>(1, number_of_threads);
+  mCRL2log(mcrl2::log::verbose) << "Computing forces using "
+                                << m_number_of_threads << " thread(s)."
+                                << std::endl;
+}
+
 void SpringLayout::setAnnealingEnabled(bool b)
 {
   m_useAnnealing = b;
@@ -1304,6 +1498,8 @@ SpringLayoutUi::SpringLayoutUi(SpringLayout& layout,
           &SpringLayoutUi::onStabilityThresholdChanged);
   connect(m_ui_advanced.txt_stab_iters, &QLineEdit::textChanged, this,
           &SpringLayoutUi::onStabilityIterationsChanged);
+  connect(m_ui_advanced.txt_threads, &QLineEdit::textChanged, this,
+          &SpringLayoutUi::onThreadsChanged);
  
   connect(m_ui_advanced.cmd_reset_positions, &QPushButton::pressed, this,
           &SpringLayoutUi::onResetPositionsPressed);
@@ -1407,6 +1603,16 @@ void SpringLayoutUi::onStabilityIterationsChanged(const QString& text)
   }
 }
 
+void SpringLayoutUi::onThreadsChanged(const QString& text)
+{
+  bool success;
+  int num = text.toInt(&success);
+  if (success && num > 0)
+  {
+    m_layout.setNumberOfThreads(num);
+  }
+}
+
 void SpringLayoutUi::onResetPositionsPressed()
 {
   m_layout.resetPositions();
@@ -30,7 +30,10 @@
 #include "attractionfunctions.h"
 #include "repulsionfunctions.h"
 #include "applicationfunctions.h"
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <QElapsedTimer>
 
 namespace Graph
@@ -118,6 +121,7 @@ class SpringLayout
   enum ThreadingMode
   {
     normal,
+    parallel
   };
 
   private:
@@ -125,6 +129,16 @@ class SpringLayout
 
   std::size_t m_max_num_nodes = 0;
   std::size_t m_total_num_nodes = 0;
+  std::mutex m_statistics_mutex; ///< Guards the two statistics above when
+                                 ///< forces are computed in parallel
+
+  std::unique_ptr<WorkerPool> m_pool; ///< Threads that compute the forces
+  std::atomic<std::size_t> m_number_of_threads{1}; ///< The size of m_pool,
+                                                   ///< applied by apply()
+  const std::size_t m_parallel_threshold = 1000; ///< Minimal number of nodes
+                                                 ///< and edges for which the
+                                                 ///< forces are computed in
+                                                 ///< parallel
 
   Octree m_node_tree;
   Octree m_handle_tree;
@@ -170,6 +184,8 @@ class SpringLayout
   float m_previous_energy = 1e25;
   std::vector<QVector3D> m_nforces, m_hforces, m_lforces,
       m_sforces; ///< Vector of the calculated forces..
+  std::vector<QVector3D> m_eforces; ///< Spring force of every edge, used to
+                                    ///< accumulate the node forces in parallel
 
   QVector3D center_of_mass_offset; ///< When un-anchoring offset should be kept
                                    ///< in mind
@@ -205,19 +221,36 @@ class SpringLayout
    *
    * @param a Particle
    * @param tree Octree containing all particles
-   * @param repulsion Scaling constant
-   * @param natlength Other scaling constant
+   * @param super_nodes Buffer for the super nodes of the tree relevant to @e a
    * @return QVector3D Force exerted by all particles on particle @e a
    */
   template <typename TreeType>
-  QVector3D approxRepulsionForce(const QVector3D& a, TreeType& tree);
+  QVector3D approxRepulsionForce(
+      const QVector3D& a, TreeType& tree,
+      std::vector<TreeNode<typename TreeType::data_t>*>& super_nodes);
+
+  /**
+   * @brief Adds the approximate repulsive force on position(i) to forces[i]
+   * for all i < count, using the threads of m_pool in parallel mode.
+   */
+  template <typename TreeType, typename Position>
+  void approxRepulsionAccumulation(ThreadingMode threadingMode,
+                                   std::size_t count, TreeType& tree,
+                                   Position position,
+                                   std::vector<QVector3D>& forces);
+
+  /// @brief Calls f(begin, end) on [0, count) directly, or on chunks of it
+  /// using the threads of m_pool in parallel mode.
+  void forEachChunk(ThreadingMode threadingMode, std::size_t count,
+                    const std::function<void(std::size_t, std::size_t)>& f);
 
   void forceAccumulation(bool sel, std::size_t nodeCount, std::size_t edgeCount,
                          TreeMode treeMode, ThreadingMode threadingMode);
 
   template <TreeMode mode>
   void repulsionAccumulation(bool sel, std::size_t nodeCount,
-                             std::size_t edgeCount);
+                             std::size_t edgeCount,
+                             ThreadingMode threadingMode);
 
   template <ThreadingMode mode>
   void attractionAccumulation(bool sel, std::size_t nodeCount,
@@ -300,8 +333,16 @@ class SpringLayout
     return m_tree_enabled;
   }
 
+  /// @brief Returns the number of threads that compute the forces of large
+  /// graphs.
+  std::size_t numberOfThreads() const
+  {
+    return m_number_of_threads;
+  }
+
   void notifyNewFrame();
   void setTreeEnabled(bool b);
+  void setNumberOfThreads(std::size_t number_of_threads);
   void setAnnealingEnabled(bool b);
   void setSpeed(int v);
   void setAccuracy(int v);
@@ -415,6 +456,7 @@ class SpringLayoutUi : public QDockWidget
   void onCoolingFactorChanged(const QString&);
   void onStabilityThresholdChanged(const QString&);
   void onStabilityIterationsChanged(const QString&);
+  void onThreadsChanged(const QString&);
   void onResetPositionsPressed();
 
   void onAttractionChanged(int value);
@@ -31,6 +31,7 @@ class ltsinfo_tool : public ltsinfo_base
     bool                        print_action_labels;
     bool                        print_state_labels;
     bool                        print_branching_factor;
+    bool                        only_counts;
 
   public:
 
@@ -46,7 +47,8 @@ class ltsinfo_tool : public ltsinfo_base
                    +mcrl2::lts::detail::supported_lts_formats_text()
                   ),
       intype(mcrl2::lts::lts_none),
-      print_state_labels(false)
+      print_state_labels(false),
+      only_counts(false)
     {
     }
 
@@ -66,7 +68,11 @@ class ltsinfo_tool : public ltsinfo_base
       add_option("state-label",
                  "print the labels of states",'l').
       add_option("branching-factor",
-                 "print the average, minimal and maximal branching factor",'b');
+                 "print the average, minimal and maximal branching factor",'b').
+      add_option("counts",
+                 "only print the number of states, action labels, transitions and state labels. "
+                 "For the .lts format these are counted while reading INFILE, without storing the LTS in memory, "
+                 "which makes this suitable for very large transition systems",'c');
     }
 
     void parse_options(const command_line_parser& parser)
@@ -102,6 +108,12 @@ class ltsinfo_tool : public ltsinfo_base
       print_action_labels = parser.options.count("action-label") > 0;
       print_state_labels = parser.options.count("state-label") > 0;
       print_branching_factor = parser.options.count("branching-factor") > 0;
+      only_counts = parser.options.count("counts") > 0;
+
+      if (only_counts && (print_action_labels || print_state_labels || print_branching_factor))
+      {
+        parser.error("Option -c/--counts cannot be combined with the options -a, -l or -b.");
+      }
     }
 
     template <class SL, class AL, class BASE>
@@ -257,6 +269,33 @@ class ltsinfo_tool : public ltsinfo_base
       }
     }
 
+    // Prints the counts of an .lts file in a single pass over the file.
+    bool provide_streamed_counts() const
+    {
+      mcrl2::lts::lts_stream_counter counter;
+      mcrl2::lts::read_lts_stream(infilename, counter);
+
+      // State labels, if present, are given for all states, including those without transitions.
+      mCRL2log(info)
+          << "Number of states: " << std::max(counter.number_of_states, counter.number_of_state_labels) << ".\n"
+          << "Number of action labels: " << counter.action_labels.size() << " (including a tau label).\n"
+          << "Number of transitions: " << counter.number_of_transitions << ".\n";
+      if (counter.number_of_probabilistic_transitions > 0)
+      {
+        mCRL2log(info) << "Number of transitions with a probabilistic target state: " << counter.number_of_probabilistic_transitions << ".\n";
+      }
+
+      if (counter.number_of_state_labels > 0)
+      {
+        mCRL2log(info) << "Number of state labels: " << counter.number_of_state_labels << ".\n";
+      }
+      else
+      {
+        mCRL2log(info) << "There are no state labels." << std::endl;
+      }
+      return true;
+    }
+
     template < class LTS_TYPE >
     bool provide_information() const
     {
@@ -268,6 +307,15 @@ class ltsinfo_tool : public ltsinfo_base
           << "Number of action labels: " << l.num_action_labels() << " (including a tau label).\n"
           << "Number of transitions: " << l.num_transitions() << ".\n";
 
+      if (only_counts)
+      {
+        if (l.has_state_info())
+        {
+          mCRL2log(info) << "Number of state labels: " << l.num_state_labels() << ".\n";
+        }
+        return true;
+      }
+
       if (l.has_state_info())
       {
         mCRL2log(info) << "Number of state labels: " << l.num_state_labels() << ".\n";
@@ -320,6 +368,10 @@ class ltsinfo_tool : public ltsinfo_base
         case lts_lts:
         case lts_lts_probabilistic:
         {
+          if (only_counts)
+          {
+            return provide_streamed_counts();
+          }
           return provide_information<probabilistic_lts_lts_t>();
         }
         case lts_none:
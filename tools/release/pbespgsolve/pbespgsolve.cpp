@@ -18,6 +18,7 @@
 #include "mcrl2/pbes/detail/bes_equation_limit.h"
 #include "mcrl2/pg/pbespgsolve.h"
 #include "mcrl2/utilities/input_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 
 #include <queue>
 
@@ -29,6 +30,7 @@ using namespace mcrl2::log;
 using bes::tools::pbes_input_tool;
 using data::tools::rewriter_tool;
 using utilities::tools::input_tool;
+using utilities::tools::parallel_tool;
 
 // class pg_solver_tool: public pbes_rewriter_tool<rewriter_tool<input_tool> >
 // TODO: extend the tool with rewriter options
@@ -36,10 +38,10 @@ using utilities::tools::input_tool;
 // scc decomposition can be compiled in using directive
 // PBESPGSOLVE_ENABLE_SCC_DECOMPOSITION
 
-class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
+class pg_solver_tool : public parallel_tool<rewriter_tool<pbes_input_tool<input_tool> > >
 {
   protected:
-    typedef rewriter_tool<pbes_input_tool<input_tool> > super;
+    typedef parallel_tool<rewriter_tool<pbes_input_tool<input_tool> > > super;
 
     pbespgsolve_options m_options;
 
@@ -73,6 +75,11 @@ class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
       m_options.use_decycle_solver = (parser.options.count("cycle") > 0);
       m_options.verify_solution = (parser.options.count("verify") > 0);
       m_options.only_generate = (parser.options.count("onlygenerate") > 0);
+      m_options.number_of_threads = number_of_threads();
+      if (m_options.number_of_threads > 1 && !m_options.use_scc_decomposition)
+      {
+        mCRL2log(warning) << "The option --threads only has effect in combination with --scc." << std::endl;
+      }
       if (parser.options.count("equation_limit") > 0)
       {
         int limit = parser.option_argument_as<int>("equation_limit");
@@ -106,6 +113,7 @@ class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
       mCRL2log(verbose) << "  eliminate self-loops: " << (m_options.use_deloop_solver?"yes":"no") << std::endl;
       mCRL2log(verbose) << "  eliminate cycles:  " << (m_options.use_decycle_solver?"yes":"no") << std::endl;
       mCRL2log(verbose) << "  scc decomposition: " << std::boolalpha << m_options.use_scc_decomposition << std::endl;
+      mCRL2log(verbose) << "  number of threads: " << m_options.number_of_threads << std::endl;
       mCRL2log(verbose) << "  verify solution:   " << std::boolalpha << m_options.verify_solution << std::endl;
       mCRL2log(verbose) << "  only generate:   " << std::boolalpha << m_options.only_generate << std::endl;
 